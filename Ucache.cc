@@ -51,6 +51,11 @@
 #include "decoder.h"
 #include "parameter.h"
 #include "Ucache.h"
+#include "journal.h"
+#include "pareto.h"
+#include "search.h"
+#include "banksim.h"
+#include "dump.h"
 #include "subarray.h"
 #include "uca.h"
 
@@ -58,10 +63,16 @@
 #include <iostream>
 #include <algorithm>
 #include <list>
+#include <map>
+#include <vector>
 
 using namespace std;
 
-const uint32_t nthreads = NTHREADS;
+uint32_t nthreads = NTHREADS;  // may be overridden from the command line (-nthreads)
+uint64_t solve_partitions_evaluated = 0;  // running total of calculate_time() calls made by solve()
+uint64_t solve_partitions_aborted[Eval_abort_types];  // of those, cut short per Eval_abort reason
+min_values_t solve_selection_min;  // minima the last find_optimal_uca() ranked against
+const partition_window * solve_window = NULL;
 
 
 void min_values_t::update_min_values(const min_values_t * val)
@@ -93,7 +104,7 @@ void min_values_t::update_min_values(const nuca_org_t * res)
   min_cyc     = (min_cyc > res->nuca_pda.cycle_time) ? res->nuca_pda.cycle_time : min_cyc;
 }
 
-void min_values_t::update_min_values(const mem_array * res)
+void min_values_t::update_min_values(const mem_array_metrics * res)
 {
   min_delay   = (min_delay > res->access_time) ? res->access_time : min_delay;
   min_dyn     = (min_dyn > res->power.readOp.dynamic) ? res->power.readOp.dynamic : min_dyn;
@@ -104,33 +115,117 @@ void min_values_t::update_min_values(const mem_array * res)
 
 
 
-void * calc_time_mt_wrapper(void * void_obj)
+// reduces v to the single value x, or to nothing when x is not in v
+template <class T>
+static void keep_only(vector<T> & v, T x)
 {
-  calc_time_mt_wrapper_struct * calc_obj = (calc_time_mt_wrapper_struct *) void_obj;
-  uint32_t tid                   = calc_obj->tid;
-  list<mem_array *> & data_arr   = calc_obj->data_arr;
-  list<mem_array *> & tag_arr    = calc_obj->tag_arr;
-  bool is_tag                    = calc_obj->is_tag;
-  bool pure_ram                  = calc_obj->pure_ram;
-  bool is_main_mem               = calc_obj->is_main_mem;
-  double Nspd_min                = calc_obj->Nspd_min;
-  min_values_t * data_res        = calc_obj->data_res;
-  min_values_t * tag_res         = calc_obj->tag_res;
-
-  data_arr.clear();
-  data_arr.push_back(new mem_array);
-  tag_arr.clear();
-  tag_arr.push_back(new mem_array);
-
-  uint32_t Ndwl_niter = _log2(MAXDATAN) + 1;
-  uint32_t Ndbl_niter = _log2(MAXDATAN) + 1;
-  uint32_t Ndcm_niter = _log2(MAX_COL_MUX) + 1;
-  uint32_t niter      = Ndwl_niter * Ndbl_niter * Ndcm_niter;
-
-
-  bool is_valid_partition;
-  int wt_min, wt_max;
+  v.assign((find(v.begin(), v.end(), x) != v.end()) ? 1 : 0, x);
+}
+
 
+
+// keeps the values of v within radius octaves of center
+template <class T>
+static void keep_near(vector<T> & v, T center, uint32_t radius)
+{
+  vector<T> kept;
+  double span = (double)(1u << radius);
+  for (uint32_t i = 0; i < v.size(); i++)
+  {
+    if (v[i] <= center * span && v[i] * span >= center) kept.push_back(v[i]);
+  }
+  v.swap(kept);
+}
+
+
+
+void enumerate_partitions(
+    bool is_tag,
+    bool pure_ram,
+    bool is_main_mem,
+    double Nspd_min,
+    vector<partition_t> & parts)
+{
+  vector<double> Nspd_v;
+  vector<unsigned int> Ndwl_v, Ndbl_v, Ndcm_v, Ndsam_lev_1_v, Ndsam_lev_2_v;
+
+  for (double Nspd = Nspd_min; Nspd <= MAXDATASPD; Nspd *= 2) Nspd_v.push_back(Nspd);
+  for (unsigned int n = 1; n <= MAXDATAN; n *= 2)    { Ndwl_v.push_back(n); Ndbl_v.push_back(n); }
+  for (unsigned int n = 1; n <= MAX_COL_MUX; n *= 2) { Ndcm_v.push_back(n); Ndsam_lev_1_v.push_back(n); Ndsam_lev_2_v.push_back(n); }
+
+  // the forced organization (data array only) keeps the sweep of Nspd and
+  // of the sense-amp muxes unless those are forced as well
+  if (g_ip->force_cache_config && is_tag == false)
+  {
+    Ndwl_v.assign(1, g_ip->ndwl);
+    Ndbl_v.assign(1, g_ip->ndbl);
+    Ndcm_v.assign(1, g_ip->ndcm);
+    if (g_ip->nspd != 0) Nspd_v.assign(1, g_ip->nspd);
+    if (g_ip->ndsam1 != 0)
+    {
+      Ndsam_lev_1_v.assign(1, g_ip->ndsam1);
+      Ndsam_lev_2_v.assign(1, g_ip->ndsam2);
+    }
+  }
+
+  // a fully-associative (CAM) array only varies Ndbl: DynamicParameter takes
+  // Ndbl >= 2 with every other dimension at one
+  if (g_ip->fully_assoc)
+  {
+    keep_only(Nspd_v, 1.0);
+    keep_only(Ndwl_v, 1u);
+    keep_only(Ndcm_v, 1u);
+    keep_only(Ndsam_lev_1_v, 1u);
+    keep_only(Ndsam_lev_2_v, 1u);
+    Ndbl_v.erase(remove(Ndbl_v.begin(), Ndbl_v.end(), 1u), Ndbl_v.end());
+  }
+
+  if (solve_window != NULL)
+  {
+    const partition_t & w = is_tag ? solve_window->tag : solve_window->data;
+    keep_near(Nspd_v, w.Nspd, solve_window->radius);
+    keep_near(Ndwl_v, w.Ndwl, solve_window->radius);
+    keep_near(Ndbl_v, w.Ndbl, solve_window->radius);
+    keep_near(Ndcm_v, w.Ndcm, solve_window->radius);
+    keep_near(Ndsam_lev_1_v, w.Ndsam_lev_1, solve_window->radius);
+    keep_near(Ndsam_lev_2_v, w.Ndsam_lev_2, solve_window->radius);
+  }
+
+  parts.clear();
+  partition_t p;
+  for (uint32_t i0 = 0; i0 < Nspd_v.size(); i0++)
+  for (uint32_t i1 = 0; i1 < Ndwl_v.size(); i1++)
+  for (uint32_t i2 = 0; i2 < Ndbl_v.size(); i2++)
+  for (uint32_t i3 = 0; i3 < Ndcm_v.size(); i3++)
+  for (uint32_t i4 = 0; i4 < Ndsam_lev_1_v.size(); i4++)
+  for (uint32_t i5 = 0; i5 < Ndsam_lev_2_v.size(); i5++)
+  {
+    p.Nspd        = Nspd_v[i0];
+    p.Ndwl        = Ndwl_v[i1];
+    p.Ndbl        = Ndbl_v[i2];
+    p.Ndcm        = Ndcm_v[i3];
+    p.Ndsam_lev_1 = Ndsam_lev_1_v[i4];
+    p.Ndsam_lev_2 = Ndsam_lev_2_v[i5];
+
+    DynamicParameter dyn_p(is_tag, pure_ram, p.Nspd, p.Ndwl, p.Ndbl, p.Ndcm,
+                           p.Ndsam_lev_1, p.Ndsam_lev_2, is_main_mem);
+    bool is_valid = dyn_p.is_valid;
+    // a fully-associative tag pass also computes the data array
+    if (is_valid && is_tag && g_ip->fully_assoc)
+    {
+      DynamicParameter dyn_d(false, pure_ram, p.Nspd, p.Ndwl, p.Ndbl, p.Ndcm,
+                             p.Ndsam_lev_1, p.Ndsam_lev_2, is_main_mem);
+      is_valid = dyn_d.is_valid;
+    }
+    if (is_valid) parts.push_back(p);
+  }
+}
+
+
+
+// wire types each valid partition is entered for
+static void wire_type_range(bool is_tag, int & wt_min, int & wt_max)
+{
   if (g_ip->force_wiretype) {
     if (g_ip->wt == 0) {
       wt_min = Low_swing;
@@ -145,98 +240,141 @@ void * calc_time_mt_wrapper(void * void_obj)
     wt_min = Global;
     wt_max = Low_swing;
   }
+  if (g_ip->force_cache_config && is_tag == false)
+  {
+    wt_min = wt_max = g_ip->wt;
+  }
+}
+
 
-  for (double Nspd = Nspd_min; Nspd <= MAXDATASPD; Nspd *= 2)
+
+bool evaluate_partition(
+    calc_time_mt_wrapper_struct * calc_obj,
+    const partition_t & p,
+    mem_array & tag_res_arr,
+    mem_array & data_res_arr,
+    bool record)
+{
+  bool is_tag      = calc_obj->is_tag;
+  bool pure_ram    = calc_obj->pure_ram;
+  bool is_main_mem = calc_obj->is_main_mem;
+  bool is_valid_partition = true;
+  int  abort_reason = Eval_complete;
+
+  // a cacti_error can not cross the thread; the first one is kept and
+  // sweep_partitions() rethrows it after the join
+  if (!calc_obj->error.empty()) return false;
+
+  // The wire type of the sweep is only recorded in mem_array_metrics::wt, the
+  // arrays themselves are built with g_ip->wt, so every partition is
+  // computed once and then entered for each wire type.
+  try
+  {
+  if (is_tag == true)
   {
-    for (int wr = wt_min; wr <= wt_max; wr++) 
+    calc_obj->n_evaluated++;
+    is_valid_partition = calculate_time(is_tag, pure_ram, p.Nspd, p.Ndwl,
+        p.Ndbl, p.Ndcm, p.Ndsam_lev_1, p.Ndsam_lev_2,
+        &tag_res_arr, 0, NULL, NULL,
+        is_main_mem, &abort_reason);
+    if (abort_reason != Eval_complete) calc_obj->n_aborted[abort_reason]++;
+    is_valid_partition = is_valid_partition && array_within_constraints(&tag_res_arr, true);
+  }
+  // If it's a fully-associative cache, the data array partition parameters are identical to that of
+  // the tag array, so compute data array partition properties also here.
+  if (is_tag == false || g_ip->fully_assoc)
+  {
+    calc_obj->n_evaluated++;
+    is_valid_partition = calculate_time(is_tag/*false*/, pure_ram, p.Nspd, p.Ndwl,
+        p.Ndbl, p.Ndcm, p.Ndsam_lev_1, p.Ndsam_lev_2,
+        &data_res_arr, 0, NULL, NULL,
+        is_main_mem, &abort_reason) && is_valid_partition;
+    if (abort_reason != Eval_complete) calc_obj->n_aborted[abort_reason]++;
+    is_valid_partition = is_valid_partition && array_within_constraints(&data_res_arr, false);
+  }
+  }
+  catch (const cacti_error & e)
+  {
+    calc_obj->error = e.msg;
+    return false;
+  }
+
+  if (is_valid_partition && record)
+  {
+    int wt_min, wt_max;
+    wire_type_range(is_tag, wt_min, wt_max);
+    if (is_tag == true)
+    {
+      calc_obj->tag_res->update_min_values(&tag_res_arr);
+      for (int wr = wt_min; wr <= wt_max; wr++)
+      {
+        calc_obj->tag_arr.push_back(new mem_array_metrics(tag_res_arr));
+        calc_obj->tag_arr.back()->wt = (enum Wire_type) wr;
+        if (calc_obj->dump[Dump_tag] != NULL) calc_obj->dump[Dump_tag]->add_array(calc_obj->tag_arr.back());
+      }
+    }
+    if (is_tag == false || g_ip->fully_assoc)
     {
-      for (uint32_t iter = tid; iter < niter; iter += nthreads)
+      calc_obj->data_res->update_min_values(&data_res_arr);
+      for (int wr = wt_min; wr <= wt_max; wr++)
       {
-        // reconstruct Ndwl, Ndbl, Ndcm
-        unsigned int Ndwl = 1 << (iter / (Ndbl_niter * Ndcm_niter));
-        unsigned int Ndbl = 1 << ((iter / (Ndcm_niter))%Ndbl_niter);
-        unsigned int Ndcm = 1 << (iter % Ndcm_niter); 
-        for(unsigned int Ndsam_lev_1 = 1; Ndsam_lev_1 <= MAX_COL_MUX; Ndsam_lev_1 *= 2)
-        {
-          for(unsigned int Ndsam_lev_2 = 1; Ndsam_lev_2 <= MAX_COL_MUX; Ndsam_lev_2 *= 2)
-          {
-            //for debuging
-            if (g_ip->force_cache_config && is_tag == false)
-            {
-              wr   = g_ip->wt;
-              Ndwl = g_ip->ndwl;
-              Ndbl = g_ip->ndbl;
-              Ndcm = g_ip->ndcm;
-              if(g_ip->nspd != 0) {
-                Nspd = g_ip->nspd;
-              }
-              if(g_ip->ndsam1 != 0) {
-                Ndsam_lev_1 = g_ip->ndsam1;
-                Ndsam_lev_2 = g_ip->ndsam2;
-              }
-            }
-
-            if (is_tag == true)
-            {
-              is_valid_partition = calculate_time(is_tag, pure_ram, Nspd, Ndwl, 
-                  Ndbl, Ndcm, Ndsam_lev_1, Ndsam_lev_2,
-                  tag_arr.back(), 0, NULL, NULL,
-                  is_main_mem);
-            }
-            // If it's a fully-associative cache, the data array partition parameters are identical to that of
-            // the tag array, so compute data array partition properties also here.
-            if (is_tag == false || g_ip->fully_assoc)
-            {
-              is_valid_partition = calculate_time(is_tag/*false*/, pure_ram, Nspd, Ndwl, 
-                  Ndbl, Ndcm, Ndsam_lev_1, Ndsam_lev_2,
-                  data_arr.back(), 0, NULL, NULL,
-                  is_main_mem);
-            }
-
-            if (is_valid_partition)
-            {
-              if (is_tag == true)
-              {
-                tag_arr.back()->wt = (enum Wire_type) wr;
-                tag_res->update_min_values(tag_arr.back());
-                tag_arr.push_back(new mem_array);
-              }
-              if (is_tag == false || g_ip->fully_assoc)
-              {
-                data_arr.back()->wt = (enum Wire_type) wr;
-                data_res->update_min_values(data_arr.back());
-                data_arr.push_back(new mem_array);
-              }
-            }
-
-            if (g_ip->force_cache_config && is_tag == false)
-            {
-              wr   = wt_max;
-              iter = niter;
-              if(g_ip->nspd != 0) {
-                Nspd = MAXDATASPD;
-              }
-              if (g_ip->ndsam1 != 0) {
-                Ndsam_lev_1 = MAX_COL_MUX+1;
-                Ndsam_lev_2 = MAX_COL_MUX+1;
-              }
-            }
-          }
-        }
+        calc_obj->data_arr.push_back(new mem_array_metrics(data_res_arr));
+        calc_obj->data_arr.back()->wt = (enum Wire_type) wr;
+        if (calc_obj->dump[Dump_data] != NULL) calc_obj->dump[Dump_data]->add_array(calc_obj->data_arr.back());
       }
     }
   }
+  return is_valid_partition;
+}
+
+
+
+void * calc_time_mt_wrapper(void * void_obj)
+{
+  calc_time_mt_wrapper_struct * calc_obj = (calc_time_mt_wrapper_struct *) void_obj;
+  const vector<partition_t> & parts = *(calc_obj->parts);
+
+  calc_obj->data_arr.clear();
+  calc_obj->tag_arr.clear();
+  calc_obj->n_evaluated = 0;
+  for (int r = 0; r < Eval_abort_types; r++) calc_obj->n_aborted[r] = 0;
+
+  mem_array tag_res_arr, data_res_arr;
+
+  // partitions are handed out in small chunks from the shared work list
+  const uint32_t chunk = 4;
+  for (;;)
+  {
+    uint32_t first = __sync_fetch_and_add(calc_obj->next_part, chunk);
+    if (first >= parts.size()) break;
+    uint32_t last = MIN(first + chunk, (uint32_t) parts.size());
 
-  delete data_arr.back();
-  delete tag_arr.back();
-  data_arr.pop_back();
-  tag_arr.pop_back();
+    for (uint32_t i = first; i < last; i++)
+    {
+      evaluate_partition(calc_obj, parts[i], tag_res_arr, data_res_arr, true);
+    }
+  }
 
+  // the dump rows are compressed while the other threads still run
+  for (int s = 0; s < 2; s++)
+  {
+    if (calc_obj->dump[s] != NULL) calc_obj->dump[s]->finish();
+  }
   pthread_exit(NULL);
 }
 
 
 
+// smaller of two <constraints> bounds, 0 if neither is given
+static double tightest_limit(double a, double b)
+{
+  if (a <= 0) return b;
+  if (b <= 0) return a;
+  return MIN(a, b);
+}
+
+
+
 bool calculate_time(
     bool is_tag,
     int pure_ram,
@@ -250,45 +388,64 @@ bool calculate_time(
     int flag_results_populate,
     results_mem_array *ptr_results,
     uca_org_t *ptr_fin_res,
-    bool is_main_mem)
+    bool is_main_mem,
+    int *abort_reason)
 {
   DynamicParameter dyn_p(is_tag, pure_ram, Nspd, Ndwl, Ndbl, Ndcm, Ndsam_lev_1, Ndsam_lev_2, is_main_mem);
 
+  if (abort_reason != NULL) *abort_reason = Eval_complete;
   if (dyn_p.is_valid == false)
   {
     return false;
   }
 
+  if (abort_reason != NULL)
+  {
+    // the bounds array_within_constraints() would reject the array with
+    dyn_p.max_access_time = tightest_limit(g_ip->array_limit.access_time, g_ip->cache_limit.access_time);
+    dyn_p.max_read_energy = tightest_limit(g_ip->array_limit.read_energy, g_ip->cache_limit.read_energy);
+  }
+
   UCA * uca = new UCA(dyn_p);
 
-  if (flag_results_populate)
-  { //For the final solution, populate the ptr_results data structure  -- TODO: copy only necessary variables
-  }
-  else
+  if (abort_reason != NULL)
   {
-    ptr_array->Ndwl = Ndwl;
-    ptr_array->Ndbl = Ndbl;
-    ptr_array->Nspd = Nspd;
-    ptr_array->deg_bl_muxing = dyn_p.deg_bl_muxing;
-    ptr_array->Ndsam_lev_1 = Ndsam_lev_1;
-    ptr_array->Ndsam_lev_2 = Ndsam_lev_2;
-    ptr_array->access_time = uca->access_time;
-    ptr_array->cycle_time = uca->cycle_time;
+    *abort_reason = uca->eval_abort;
+    if (uca->eval_abort != Eval_complete)
+    {
+      delete uca;
+      return false;
+    }
+  }
+
+  // the mem_array_metrics part, which is all the search looks at
+  ptr_array->Ndwl = Ndwl;
+  ptr_array->Ndbl = Ndbl;
+  ptr_array->Nspd = Nspd;
+  ptr_array->deg_bl_muxing = dyn_p.deg_bl_muxing;
+  ptr_array->Ndsam_lev_1 = Ndsam_lev_1;
+  ptr_array->Ndsam_lev_2 = Ndsam_lev_2;
+  ptr_array->access_time = uca->access_time;
+  ptr_array->cycle_time = uca->cycle_time;
+  ptr_array->area   = uca->area.get_area();
+  ptr_array->height = uca->area.h;
+  ptr_array->width  = uca->area.w;
+  ptr_array->power  = uca->power;
+  ptr_array->delay_senseamp_mux_decoder =
+    MAX(uca->delay_array_to_sa_mux_lev_1_decoder,
+        uca->delay_array_to_sa_mux_lev_2_decoder);
+  ptr_array->delay_before_subarray_output_driver         = uca->delay_before_subarray_output_driver;
+  ptr_array->delay_from_subarray_output_driver_to_output = uca->delay_from_subarray_out_drv_to_out;
+
+  if (flag_results_populate)
+  { //For the final solution, also copy the breakdown that is reported
     ptr_array->multisubbank_interleave_cycle_time = uca->multisubbank_interleave_cycle_time;
+    ptr_array->number_subbanks = 1 << dyn_p.number_subbanks_decode;
     ptr_array->area_ram_cells = uca->area_all_dataramcells;
-    ptr_array->area   = uca->area.get_area();
-    ptr_array->height = uca->area.h;
-    ptr_array->width  = uca->area.w;
     ptr_array->mat_height = uca->bank.mat.area.h;
     ptr_array->mat_length = uca->bank.mat.area.w;
     ptr_array->subarray_height = uca->bank.mat.subarray.area.h;
     ptr_array->subarray_length = uca->bank.mat.subarray.area.w;
-    ptr_array->power  = uca->power;
-    ptr_array->delay_senseamp_mux_decoder =
-      MAX(uca->delay_array_to_sa_mux_lev_1_decoder,
-          uca->delay_array_to_sa_mux_lev_2_decoder);
-    ptr_array->delay_before_subarray_output_driver         = uca->delay_before_subarray_output_driver;
-    ptr_array->delay_from_subarray_output_driver_to_output = uca->delay_from_subarray_out_drv_to_out;
 
     ptr_array->delay_route_to_bank          = uca->htree_in_add->delay;
     ptr_array->delay_input_htree            = uca->bank.htree_in_add->delay;
@@ -332,12 +489,6 @@ bool calculate_time(
     ptr_array->power_wordline.readOp.dynamic = uca->bank.mat.power_wordline.readOp.dynamic * dyn_p.num_act_mats_hor_dir;   //Francesco
     ptr_array->power_wordline.writeOp.dynamic = uca->bank.mat.power_wordline.writeOp.dynamic * dyn_p.num_act_mats_hor_dir; //francesco
 
-	// Fabio start
-	
-	cout<<"  uca->bank.mat.power_sa.readOp.dynamic: "<<uca->bank.mat.power_sa.readOp.dynamic<<endl;
-	cout<<"  dyn_p.num_act_mats_hor_dir: "<<dyn_p.num_act_mats_hor_dir<<endl;
-	
-	//Fabio ends
     ptr_array->power_prechg_eq_drivers.readOp.dynamic = uca->bank.mat.power_bl_precharge_eq_drv.readOp.dynamic * dyn_p.num_act_mats_hor_dir;
     ptr_array->power_output_drivers_at_subarray.readOp.dynamic = uca->bank.mat.power_subarray_out_drv.readOp.dynamic * dyn_p.num_act_mats_hor_dir;
     ptr_array->power_comparators.readOp.dynamic = uca->bank.mat.power_comparator.readOp.dynamic * dyn_p.num_act_mats_hor_dir;
@@ -371,7 +522,72 @@ bool calculate_time(
 
 
 
-bool check_uca_org(uca_org_t & u, min_values_t *minval) 
+// written so that a NaN metric also fails a given bound
+static inline bool over_limit(double limit, double v)
+{
+  return (limit > 0 && !(v <= limit));
+}
+
+bool array_within_constraints(const mem_array_metrics * m, bool is_tag)
+{
+  const hard_constraints & al = g_ip->array_limit;
+  const hard_constraints & cl = g_ip->cache_limit;
+
+  if (over_limit(al.access_time, m->access_time) ||
+      over_limit(al.cycle_time,  m->cycle_time) ||
+      over_limit(al.area,        m->area) ||
+      over_limit(al.read_energy, m->power.readOp.dynamic) ||
+      over_limit(al.leakage,     m->power.readOp.leakage))
+  {
+    return false;
+  }
+
+  // What one array contributes is a lower bound of the cache value (see the
+  // uca_org_t::find_*() functions), so the cache budgets apply to it as well.
+  // Only the normal access mode overlaps part of the data array access
+  // with the tag lookup.
+  double access = m->access_time;
+  if (g_ip->is_cache && !is_tag && !g_ip->fast_access && !g_ip->is_seq_acc)
+  {
+    access = m->delay_before_subarray_output_driver + m->delay_from_subarray_output_driver_to_output;
+  }
+  return !(over_limit(cl.access_time, access) ||
+           over_limit(cl.cycle_time,  m->cycle_time) ||
+           over_limit(cl.area,        m->area) ||
+           over_limit(cl.read_energy, m->power.readOp.dynamic) ||
+           over_limit(cl.leakage,     m->power.readOp.leakage));
+}
+
+static bool constraints_given()
+{
+  const hard_constraints * l[2] = { &g_ip->array_limit, &g_ip->cache_limit };
+  for (int i = 0; i < 2; i++)
+  {
+    if (l[i]->access_time > 0 || l[i]->cycle_time > 0 || l[i]->area > 0 ||
+        l[i]->read_energy > 0 || l[i]->leakage > 0)
+      return true;
+  }
+  return false;
+}
+
+static const char * constraints_hint()
+{
+  return constraints_given() ? " within the <constraints> limits" : "";
+}
+
+bool org_within_constraints(const uca_org_t & u)
+{
+  const hard_constraints & cl = g_ip->cache_limit;
+  return !(over_limit(cl.access_time, u.access_time) ||
+           over_limit(cl.cycle_time,  u.cycle_time) ||
+           over_limit(cl.area,        u.area) ||
+           over_limit(cl.read_energy, u.power.readOp.dynamic) ||
+           over_limit(cl.leakage,     u.power.readOp.leakage));
+}
+
+
+
+bool check_uca_org(const uca_org_t & u, const min_values_t *minval) 
 {
   if (((u.access_time - minval->min_delay)*100/minval->min_delay) > g_ip->delay_dev) {
     return false;
@@ -395,7 +611,7 @@ bool check_uca_org(uca_org_t & u, min_values_t *minval)
   return true;
 }
 
-bool check_mem_org(mem_array & u, const min_values_t *minval) 
+bool check_mem_org(mem_array_metrics & u, const min_values_t *minval) 
 {
   if (((u.access_time - minval->min_delay)*100/minval->min_delay) > g_ip->delay_dev) {
     return false;
@@ -422,99 +638,320 @@ bool check_mem_org(mem_array & u, const min_values_t *minval)
 
 
 
-void find_optimal_uca(uca_org_t *res, min_values_t * minval, list<uca_org_t> & ulist)
+// pair k of the tag x data combination: tags are taken from the back of
+// the tag list, data arrays in list order
+static void pair_arrays(
+    const combine_mt_wrapper_struct * obj,
+    uint64_t k,
+    const mem_array_metrics * & tag,
+    const mem_array_metrics * & data)
 {
-  double cost = 0;
-  double min_cost = BIGNUM;
-  float d, a, dp, lp, c;
+  uint64_t n_data = obj->datas->size();
+  tag  = (*obj->tags)[obj->tags->size() - 1 - k / n_data];
+  data = (*obj->datas)[k % n_data];
+}
+
+static void combine_pair(const combine_mt_wrapper_struct * obj, uint64_t k, uca_org_t & org)
+{
+  const mem_array_metrics * tag, * data;
+  pair_arrays(obj, k, tag, data);
+  org.find_delay(tag, data);
+  org.find_energy(tag, data);
+  org.find_area(tag, data);
+  org.find_cyc(tag, data);
+}
+
 
-  dp = g_ip->dynamic_power_wt;
-  lp = g_ip->leakage_power_wt;
-  a  = g_ip->area_wt;
-  d  = g_ip->delay_wt;
-  c  = g_ip->cycle_time_wt;
 
-  if (ulist.empty() == true)
+double org_cost(const uca_org_t & u, const min_values_t * minval)
+{
+  if (g_ip->ed == 1)
   {
-    cout << "ERROR: no valid cache organizations found" << endl;
-    exit(0);
+    return (u.access_time/minval->min_delay) * (u.power.readOp.dynamic/minval->min_dyn);
   }
+  else if (g_ip->ed == 2)
+  {
+    return (u.access_time/minval->min_delay) *
+           (u.access_time/minval->min_delay) *
+           (u.power.readOp.dynamic/minval->min_dyn);
+  }
+  else if (check_uca_org(u, minval))
+  {
+    return (g_ip->delay_wt          * (u.access_time/minval->min_delay) +
+            g_ip->cycle_time_wt     * (u.cycle_time/minval->min_cyc) +
+            g_ip->dynamic_power_wt  * (u.power.readOp.dynamic/minval->min_dyn) +
+            g_ip->leakage_power_wt  * (u.power.readOp.leakage/minval->min_leakage) +
+            g_ip->area_wt           * (u.area/minval->min_area));
+  }
+  return BIGNUM;
+}
+
 
-  for (list<uca_org_t>::iterator niter = ulist.begin(); niter != ulist.end(); niter++)
-  { 
-    if (g_ip->ed == 1)
+
+void *combine_mt_wrapper(void * void_obj)
+{
+  combine_mt_wrapper_struct * obj = (combine_mt_wrapper_struct *) void_obj;
+  uca_org_t org;
+
+  for (uint64_t k = obj->first; k < obj->last; k++)
+  {
+    combine_pair(obj, k, org);
+    if (!org_within_constraints(org)) continue;
+
+    if (obj->cache_min == NULL)
+    {
+      obj->min.update_min_values(org);
+      obj->n_valid++;
+    }
+    else
     {
-      cost = ((niter)->access_time/minval->min_delay) * ((niter)->power.readOp.dynamic/minval->min_dyn);
-      if (min_cost > cost)
+      double cost = org_cost(org, obj->cache_min);
+      if (obj->dump != NULL)
+      {
+        const mem_array_metrics * tag, * data;
+        pair_arrays(obj, k, tag, data);
+        obj->dump->add_pair(tag, data, org, cost);
+      }
+      if (obj->best_cost > cost)
+      {
+        obj->best_cost = cost;
+        obj->best_pair = k;
+      }
+      if (obj->keep > 0 && cost < BIGNUM &&
+          (obj->top.size() < obj->keep || cost < obj->top.back().first))
       {
-        min_cost = cost;
-        *res = (*(niter));
+        // pairs come in increasing k, so a tie stays behind the earlier pair
+        pair<double, uint64_t> e(cost, k);
+        obj->top.insert(upper_bound(obj->top.begin(), obj->top.end(), e), e);
+        if (obj->top.size() > obj->keep) obj->top.pop_back();
       }
     }
-    else if (g_ip->ed == 2)
+  }
+  if (obj->dump != NULL) obj->dump->finish();
+
+  pthread_exit(NULL);
+}
+
+
+
+// Evaluates candidate m once more with the full breakdown, under the
+// technology parameters of the sweep it came from.
+static void evaluate_full(const mem_array_metrics * m, bool is_tag, mem_array * full)
+{
+  int  pure_ram  = (!g_ip->is_cache || g_ip->is_main_mem);
+  bool tag_sweep = is_tag || g_ip->fully_assoc;  // both FA arrays come from the tag sweep
+
+  init_tech_params(g_ip->F_sz_um, tag_sweep);
+  calculate_time(tag_sweep, pure_ram, m->Nspd, m->Ndwl, m->Ndbl,
+      m->deg_bl_muxing, m->Ndsam_lev_1, m->Ndsam_lev_2,
+      full, 1, NULL, NULL, tag_sweep ? false : g_ip->is_main_mem, NULL);
+  full->arr_min = m->arr_min;
+  full->wt      = m->wt;
+}
+
+
+
+static bool bank_sim_ranks()
+{
+  return g_ip->bsim_stream != Bsim_none && g_ip->bsim_wt > 0 && g_ip->nuca == 0;
+}
+
+
+
+// <bank_sim><weight>: the shortlist of the cheapest pairs is run through the
+// bank scheduler, and each pair is charged weight x its mean loaded latency
+// over the shortlist's minimum on top of its cost. Returns the new winner.
+static uint64_t rerank_by_bank_sim(const combine_mt_wrapper_struct * comb, uint32_t n_thr)
+{
+  vector<pair<double, uint64_t> > top;
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    top.insert(top.end(), comb[t].top.begin(), comb[t].top.end());
+  }
+  sort(top.begin(), top.end());
+  if (top.size() > g_ip->bsim_shortlist) top.resize(g_ip->bsim_shortlist);
+
+  bank_sim_stream s;
+  s.load();
+
+  // arrays shared by several pairs are evaluated once
+  map<const mem_array_metrics *, mem_array *> full;
+  vector<double> latency(top.size());
+  double min_latency = BIGNUM;
+  for (uint32_t i = 0; i < top.size(); i++)
+  {
+    const mem_array_metrics * arr[2];
+    uca_org_t org;
+    pair_arrays(&comb[0], top[i].second, arr[0], arr[1]);
+    combine_pair(&comb[0], top[i].second, org);
+
+    bank_sim_org b;
+    b.nbanks          = g_ip->nbanks;
+    b.access_time     = org.access_time;
+    b.cycle_time      = org.cycle_time;
+    b.interleave_time = 0;
+    for (int a = 0; a < 2; a++)
     {
-      cost = ((niter)->access_time/minval->min_delay)*
-             ((niter)->access_time/minval->min_delay)*
-             ((niter)->power.readOp.dynamic/minval->min_dyn);
-      if (min_cost > cost)
+      if (arr[a] == NULL) continue;  // pure RAM
+      if (full.find(arr[a]) == full.end())
       {
-        min_cost = cost;
-        *res = (*(niter));
+        full[arr[a]] = new mem_array();
+        evaluate_full(arr[a], a == 0, full[arr[a]]);
       }
+      b.interleave_time = MAX(b.interleave_time, full[arr[a]]->multisubbank_interleave_cycle_time);
     }
-    else
+    b.nsubbanks = full[arr[1]]->number_subbanks;
+
+    bank_sim_result r;
+    simulate_banks(b, s, r);
+    latency[i]  = r.mean_latency;
+    min_latency = MIN(min_latency, latency[i]);
+  }
+  for (map<const mem_array_metrics *, mem_array *>::iterator it = full.begin(); it != full.end(); ++it)
+  {
+    delete it->second;
+  }
+
+  uint64_t best = top[0].second;
+  double best_cost = BIGNUM;
+  for (uint32_t i = 0; i < top.size(); i++)
+  {
+    double cost = top[i].first + g_ip->bsim_wt * latency[i] / min_latency;
+    if (best_cost > cost)
     {
-      /* 
-       * check whether the current organization
-       * meets the input deviation constraints
-       */
-      bool v = check_uca_org(*niter, minval);
-      if (minval->min_leakage == 0) minval->min_leakage = 0.1; //FIXME remove this after leakage modeling
+      best_cost = cost;
+      best      = top[i].second;
+    }
+  }
+  return best;
+}
 
-      if (v)
-      {
-        cost = (d  * ((niter)->access_time/minval->min_delay) +
-                c  * ((niter)->cycle_time/minval->min_cyc) +
-                dp * ((niter)->power.readOp.dynamic/minval->min_dyn) +
-                lp * ((niter)->power.readOp.leakage/minval->min_leakage) +
-                a  * ((niter)->area/minval->min_area));
-        //fprintf(stderr, "cost = %g\n", cost);
-
-        if (min_cost > cost) {
-          min_cost = cost;
-          *res = (*(niter));
-          niter = ulist.erase(niter);
-          niter--;
-        }
-      }
-      else {
-        niter = ulist.erase(niter);
-        if(niter != ulist.begin())
-          niter--;
-      }
+
+
+/*
+ * Picks the cheapest tag x data combination without storing the
+ * combinations: a first pass over all pairs takes the minima that the
+ * costs are normalized with, a second pass scores each pair against them.
+ * Both passes split the pairs into one contiguous range per thread, so
+ * cost ties still go to the first pair in the order above. res gets the
+ * metrics of the winner, best_tag/best_data the candidates it is made of.
+ */
+void find_optimal_uca(
+    uca_org_t *res,
+    const mem_array_metrics * & best_tag,
+    const mem_array_metrics * & best_data,
+    const list<mem_array_metrics *> & tag_arr,
+    const list<mem_array_metrics *> & data_arr,
+    bool pure_ram)
+{
+  vector<mem_array_metrics *> tags;
+  vector<mem_array_metrics *> datas(data_arr.begin(), data_arr.end());
+  if (pure_ram)
+    tags.push_back(NULL);
+  else
+    tags.assign(tag_arr.begin(), tag_arr.end());
+
+  uint64_t n_pairs = (uint64_t) tags.size() * datas.size();
+  uint32_t n_thr   = (uint32_t) MAX(1, MIN((uint64_t) nthreads, n_pairs));
+  combine_mt_wrapper_struct * comb = new combine_mt_wrapper_struct[n_thr];
+  pthread_t * threads = new pthread_t[n_thr];
+  min_values_t cache_min;
+  uint64_t n_valid = 0;
+
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    comb[t].tags      = &tags;
+    comb[t].datas     = &datas;
+    comb[t].first     = n_pairs * t / n_thr;
+    comb[t].last      = n_pairs * (t + 1) / n_thr;
+    comb[t].cache_min = NULL;
+    comb[t].n_valid   = 0;
+    comb[t].best_cost = BIGNUM;
+    comb[t].best_pair = 0;
+    comb[t].keep      = bank_sim_ranks() ? g_ip->bsim_shortlist : 0;
+    comb[t].dump      = NULL;
+  }
+
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (uint32_t t = 0; t < n_thr; t++)
+    {
+      pthread_create(&threads[t], NULL, combine_mt_wrapper, (void *)(&(comb[t])));
+    }
+    for (uint32_t t = 0; t < n_thr; t++)
+    {
+      pthread_join(threads[t], NULL);
+    }
+    if (pass > 0) break;
+
+    for (uint32_t t = 0; t < n_thr; t++)
+    {
+      cache_min.update_min_values(&comb[t].min);
+      n_valid += comb[t].n_valid;
+      comb[t].cache_min = &cache_min;
+    }
+
+    if (n_valid == 0)
+    {
+      throw cacti_error(string("no valid cache organizations found") + constraints_hint());
+    }
+    if (cache_min.min_leakage == 0) cache_min.min_leakage = 0.1; //FIXME remove this after leakage modeling
+    solve_selection_min = cache_min;
+
+    for (uint32_t t = 0; t < n_thr && g_ip->dump_enabled; t++)
+    {
+      comb[t].dump = new dump_block(Dump_combined);
+    }
+  }
+
+  // the threads compressed their rows, they go out in pair order
+  for (uint32_t t = 0; t < n_thr && comb[t].dump != NULL; t++)
+  {
+    if (comb[t].dump->rows > 0) write_dump_block(*comb[t].dump, t);
+    delete comb[t].dump;
+  }
+
+  double min_cost = BIGNUM;
+  uint64_t best_pair = 0;
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    if (min_cost > comb[t].best_cost)
+    {
+      min_cost  = comb[t].best_cost;
+      best_pair = comb[t].best_pair;
     }
   }
 
   if (min_cost == BIGNUM)
   {
-    cout << "ERROR: no cache organizations met optimization criteria" << endl;
-    exit(0);
+    throw cacti_error("no cache organizations met optimization criteria");
   }
+  if (comb[0].keep > 0)
+  {
+    best_pair = rerank_by_bank_sim(comb, n_thr);
+  }
+
+  uca_org_t best = uca_org_t();  // value-initialized, as the fields find_*() leave alone are reported
+  combine_pair(&comb[0], best_pair, best);
+  pair_arrays(&comb[0], best_pair, best_tag, best_data);
+  *res = best;
+
+  delete [] comb;
+  delete [] threads;
 }
 
 
 
-void filter_tag_arr(const min_values_t * min, list<mem_array *> & list)
+void filter_tag_arr(const min_values_t * min, list<mem_array_metrics *> & list)
 {
   double cost = BIGNUM;
   double cur_cost;
   double wt_delay = g_ip->delay_wt, wt_dyn = g_ip->dynamic_power_wt, wt_leakage = g_ip->leakage_power_wt, wt_cyc = g_ip->cycle_time_wt, wt_area = g_ip->area_wt;
-  mem_array * res = NULL; 
+  mem_array_metrics * res = NULL; 
 
   if (list.empty() == true)
   {
-    cout << "ERROR: no valid tag organizations found" << endl;
-    exit(1);
+    throw cacti_error(string("no valid tag organizations found") + constraints_hint(), 1);
   }
 
 
@@ -550,8 +987,7 @@ void filter_tag_arr(const min_values_t * min, list<mem_array *> & list)
   }
   if(!res) 
   {
-    cout << "ERROR: no valid tag organizations found" << endl; 
-    exit(0);
+    throw cacti_error(string("no valid tag organizations found") + constraints_hint());
   }
 
   list.push_back(res);
@@ -559,21 +995,20 @@ void filter_tag_arr(const min_values_t * min, list<mem_array *> & list)
 
 
 
-void filter_data_arr(list<mem_array *> & curr_list)
+void filter_data_arr(list<mem_array_metrics *> & curr_list)
 {
   if (curr_list.empty() == true)
   {
-    cout << "ERROR: no valid data array organizations found" << endl;
-    exit(1);
+    throw cacti_error(string("no valid data array organizations found") + constraints_hint(), 1);
   }
 
-  list<mem_array *>::iterator iter;
+  list<mem_array_metrics *>::iterator iter;
 
   for (iter = curr_list.begin(); iter != curr_list.end(); ++iter)
   {
-    mem_array * m = *iter;
+    mem_array_metrics * m = *iter;
 
-    if (m == NULL) exit(1);
+    if (m == NULL) throw cacti_error("NULL data array candidate", 1);
   
     if(((m->access_time - m->arr_min->min_delay)/m->arr_min->min_delay > 0.5) &&
        ((m->power.readOp.dynamic - m->arr_min->min_dyn)/m->arr_min->min_dyn > 0.5))
@@ -587,211 +1022,376 @@ void filter_data_arr(list<mem_array *> & curr_list)
 
 
 
-/* 
- * Performs exhaustive search across different sub-array sizes, 
- * wire types and aspect ratios to find an optimal UCA organization
- * 1. First different valid tag array organizations are calculated
- *    and stored in tag_arr array
- * 2. The exhaustive search is repeated to find valid data array
- *    organizations and stored in data_arr array
- * 3. Cache area, delay, power, and cycle time for different
- *    cache organizations are calculated based on the 
- *    above results 
- * 4. Cache model with least cost is picked from sol_list
- */
-void solve(uca_org_t *fin_res)
+// Evaluates the partitions of one array on all threads: every grid point,
+// or the chains of the <search> engine where there is a space to search.
+// Under a sweep journal the pass is restored from, or else appended to it.
+static void sweep_partitions(
+    calc_time_mt_wrapper_struct * calc_array,
+    pthread_t * threads,
+    bool is_tag,
+    bool is_main_mem,
+    double Nspd_min)
 {
-  bool   is_dram  = false;
-  int    pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  vector<partition_t> parts;
+  volatile uint32_t next_part = 0;
+  search_state * search = NULL;
+  void * (*worker)(void *) = calc_time_mt_wrapper;
+
+  if (solve_journal != NULL && solve_journal->restore_pass(is_tag, calc_array))
+  {
+    if (g_ip->dump_enabled)
+    {
+      dump_array_candidates(Dump_tag, 0, calc_array[0].tag_arr);
+      dump_array_candidates(Dump_data, 0, calc_array[0].data_arr);
+    }
+    return;
+  }
 
+  if (g_ip->search_engine != Search_exhaustive && !g_ip->fully_assoc && solve_window == NULL &&
+      !(g_ip->force_cache_config && is_tag == false))
+  {
+    search = new search_state(Nspd_min);
+    worker = search_mt_wrapper;
+  }
+  else
+  {
+    enumerate_partitions(is_tag, calc_array[0].pure_ram, is_main_mem, Nspd_min, parts);
+  }
 
-  init_tech_params(g_ip->F_sz_um, false);
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    calc_array[t].parts       = &parts;
+    calc_array[t].next_part   = &next_part;
+    calc_array[t].search      = search;
+    calc_array[t].is_tag      = is_tag;
+    calc_array[t].is_main_mem = is_main_mem;
+    calc_array[t].error.clear();
+    for (int s = 0; s < 2; s++)
+    {
+      calc_array[t].dump[s] = g_ip->dump_enabled ? new dump_block(s) : NULL;  // Dump_tag, Dump_data
+    }
+    pthread_create(&threads[t], NULL, worker, (void *)(&(calc_array[t])));
+  }
 
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    pthread_join(threads[t], NULL);
+    solve_partitions_evaluated += calc_array[t].n_evaluated;
+    for (int r = 0; r < Eval_abort_types; r++) solve_partitions_aborted[r] += calc_array[t].n_aborted[r];
+  }
+  delete search;
 
-  list<mem_array *> tag_arr (0);
-  list<mem_array *> data_arr(0);
-  list<mem_array *>::iterator miter;
-  list<uca_org_t> sol_list(1, uca_org_t());
+  bool failed = false;
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    failed = failed || !calc_array[t].error.empty();
+  }
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    for (int s = 0; s < 2; s++)
+    {
+      if (calc_array[t].dump[s] == NULL) continue;
+      if (!failed && calc_array[t].dump[s]->rows > 0) write_dump_block(*calc_array[t].dump[s], t);
+      delete calc_array[t].dump[s];
+      calc_array[t].dump[s] = NULL;
+    }
+  }
 
-  fin_res->tag_array.access_time = 0;
-  fin_res->tag_array.Ndwl = 0;
-  fin_res->tag_array.Ndbl = 0;
-  fin_res->tag_array.Nspd = 0;
-  fin_res->tag_array.deg_bl_muxing = 0;
-  fin_res->tag_array.Ndsam_lev_1 = 0;
-  fin_res->tag_array.Ndsam_lev_2 = 0;
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    if (calc_array[t].error.empty()) continue;
 
+    // the pass is incomplete: drop what the threads found and fail it
+    string error = calc_array[t].error;
+    for (uint32_t u = 0; u < nthreads; u++)
+    {
+      list<mem_array_metrics *>::iterator miter;
+      for (miter = calc_array[u].tag_arr.begin(); miter != calc_array[u].tag_arr.end(); ++miter) delete *miter;
+      for (miter = calc_array[u].data_arr.begin(); miter != calc_array[u].data_arr.end(); ++miter) delete *miter;
+      calc_array[u].tag_arr.clear();
+      calc_array[u].data_arr.clear();
+    }
+    throw cacti_error(error);
+  }
 
-  // distribute calculate_time() execution to multiple threads
-  calc_time_mt_wrapper_struct * calc_array = new calc_time_mt_wrapper_struct[nthreads];
-  pthread_t threads[nthreads];
+  if (solve_journal != NULL)
+  {
+    solve_journal->record_pass(is_tag, calc_array, nthreads);
+  }
+}
 
-  for (uint32_t t = 0; t < nthreads; t++)
+
+
+array_candidates::~array_candidates()
+{
+  list<mem_array_metrics *>::iterator miter;
+
+  for (miter = tag_arr.begin(); miter != tag_arr.end(); ++miter)
   {
-    calc_array[t].tid         = t;
-    calc_array[t].pure_ram    = pure_ram;
-    calc_array[t].data_res    = new min_values_t();
-    calc_array[t].tag_res     = new min_values_t();
+    delete *miter;
   }
+  for (miter = data_arr.begin(); miter != data_arr.end(); ++miter)
+  {
+    delete *miter;
+  }
+}
 
-  bool     is_tag;
-  uint32_t ram_cell_tech_type;
 
-  // If it's a cache, first calculate the area, delay and power for all tag array partitions.
-  if (!pure_ram)
-  { //cache
-    is_tag              = true;
-    ram_cell_tech_type  = g_ip->tag_arr_ram_cell_tech_type;
-    is_dram             = ((ram_cell_tech_type == lp_dram) || (ram_cell_tech_type == comm_dram));
-    init_tech_params(g_ip->F_sz_um, is_tag);
 
-    for (uint32_t t = 0; t < nthreads; t++)
-    {
-      calc_array[t].is_tag      = is_tag;
-      calc_array[t].is_main_mem = false;
-      calc_array[t].Nspd_min    = 0.125;
-      pthread_create(&threads[t], NULL, calc_time_mt_wrapper, (void *)(&(calc_array[t])));
-    }
+void array_candidates::copy_from(const array_candidates & c, bool tag, bool data)
+{
+  list<mem_array_metrics *>::const_iterator miter;
 
-    for (uint32_t t = 0; t < nthreads; t++)
+  if (tag)
+  {
+    for (miter = c.tag_arr.begin(); miter != c.tag_arr.end(); ++miter)
     {
-      pthread_join(threads[t], NULL);
+      tag_arr.push_back(new mem_array_metrics(**miter));
     }
-
-    for (uint32_t t = 0; t < nthreads; t++)
+    tag_min = c.tag_min;
+  }
+  if (data)
+  {
+    for (miter = c.data_arr.begin(); miter != c.data_arr.end(); ++miter)
     {
-      calc_array[t].data_arr.sort(mem_array::lt);
-      data_arr.merge(calc_array[t].data_arr, mem_array::lt);
-      calc_array[t].tag_arr.sort(mem_array::lt);
-      tag_arr.merge(calc_array[t].tag_arr, mem_array::lt);
+      data_arr.push_back(new mem_array_metrics(**miter));
     }
+    data_min = c.data_min;
   }
+}
+
+
+
+void sweep_arrays(bool tag_pass, bool data_pass, array_candidates & c)
+{
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+
+  // distribute calculate_time() execution to multiple threads
+  calc_time_mt_wrapper_struct * calc_array = new calc_time_mt_wrapper_struct[nthreads];
+  pthread_t * threads = new pthread_t[nthreads];
 
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    calc_array[t].pure_ram    = pure_ram;
+    calc_array[t].data_res    = new min_values_t();
+    calc_array[t].tag_res     = new min_values_t();
+    calc_array[t].dump[0]     = calc_array[t].dump[1] = NULL;
+  }
 
-  // calculate the area, delay and power for all data array partitions (for cache or plain RAM).
-  if (!g_ip->fully_assoc)
+  try
   {
-    is_tag              = false;
-    ram_cell_tech_type  = g_ip->data_arr_ram_cell_tech_type;
-    is_dram             = ((ram_cell_tech_type == lp_dram) || (ram_cell_tech_type == comm_dram));
-    init_tech_params(g_ip->F_sz_um, is_tag);
+  if (tag_pass)
+  {
+    init_tech_params(g_ip->F_sz_um, true);
+    sweep_partitions(calc_array, threads, true, false, 0.125);
 
     for (uint32_t t = 0; t < nthreads; t++)
     {
-      calc_array[t].is_tag      = is_tag;
-      calc_array[t].is_main_mem = g_ip->is_main_mem;
-      calc_array[t].Nspd_min    = (double)(g_ip->out_w)/(double)(g_ip->block_sz*8);
-      pthread_create(&threads[t], NULL, calc_time_mt_wrapper, (void *)(&(calc_array[t])));
+      calc_array[t].data_arr.sort(mem_array_metrics::lt);
+      c.data_arr.merge(calc_array[t].data_arr, mem_array_metrics::lt);
+      calc_array[t].tag_arr.sort(mem_array_metrics::lt);
+      c.tag_arr.merge(calc_array[t].tag_arr, mem_array_metrics::lt);
     }
+  }
+
+  if (data_pass)
+  {
+    init_tech_params(g_ip->F_sz_um, false);
+    sweep_partitions(calc_array, threads, false, g_ip->is_main_mem,
+                     (double)(g_ip->out_w)/(double)(g_ip->block_sz*8));
 
     for (uint32_t t = 0; t < nthreads; t++)
     {
-      pthread_join(threads[t], NULL);
+      calc_array[t].data_arr.sort(mem_array_metrics::lt);
+      c.data_arr.merge(calc_array[t].data_arr, mem_array_metrics::lt);
     }
-
-    data_arr.clear();
+  }
+  }
+  catch (const cacti_error &)
+  {
+    // candidates merged into c so far stay with c
     for (uint32_t t = 0; t < nthreads; t++)
     {
-      calc_array[t].data_arr.sort(mem_array::lt);
-      data_arr.merge(calc_array[t].data_arr, mem_array::lt);
+      delete calc_array[t].data_res;
+      delete calc_array[t].tag_res;
     }
+    delete [] calc_array;
+    delete [] threads;
+    throw;
   }
 
-
-  min_values_t * d_min = new min_values_t();
-  min_values_t * t_min = new min_values_t();
-  min_values_t * cache_min = new min_values_t();
-
-  for (uint32_t t = 0; t < nthreads; t++) 
+  for (uint32_t t = 0; t < nthreads; t++)
   {
-    d_min->update_min_values(calc_array[t].data_res);
-    t_min->update_min_values(calc_array[t].tag_res);
+    c.data_min.update_min_values(calc_array[t].data_res);
+    c.tag_min.update_min_values(calc_array[t].tag_res);
+    delete calc_array[t].data_res;
+    delete calc_array[t].tag_res;
   }
 
+  delete [] calc_array;
+  delete [] threads;
+}
+
+
+
+void select_org(uca_org_t *fin_res, array_candidates & c)
+{
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  list<mem_array_metrics *> & tag_arr  = c.tag_arr;
+  list<mem_array_metrics *> & data_arr = c.data_arr;
+  list<mem_array_metrics *>::iterator miter;
+
+  fin_res->tag_array.access_time = 0;
+  fin_res->tag_array.Ndwl = 0;
+  fin_res->tag_array.Ndbl = 0;
+  fin_res->tag_array.Nspd = 0;
+  fin_res->tag_array.deg_bl_muxing = 0;
+  fin_res->tag_array.Ndsam_lev_1 = 0;
+  fin_res->tag_array.Ndsam_lev_2 = 0;
+
   for (miter = data_arr.begin(); miter != data_arr.end(); miter++)
   {
-    (*miter)->arr_min = d_min;
+    (*miter)->arr_min = &c.data_min;
   }
 
   //cout << data_arr.size() << "\t" << tag_arr.size() <<" before\n";
+  if (g_ip->pareto_frontier && g_ip->nuca == 0)
+  {
+    find_pareto_frontier(tag_arr, data_arr, pure_ram);
+  }
+
   filter_data_arr(data_arr);
   if(!pure_ram)
   {
-    filter_tag_arr(t_min, tag_arr);
+    filter_tag_arr(&c.tag_min, tag_arr);
   }
   //cout << data_arr.size() << "\t" << tag_arr.size() <<" after\n";
 
+  const mem_array_metrics * best_tag  = NULL;
+  const mem_array_metrics * best_data = NULL;
+  find_optimal_uca(fin_res, best_tag, best_data, tag_arr, data_arr, pure_ram);
 
-  if (pure_ram == true)
+  // The candidates only carry their metrics; the picked tag and data
+  // organizations are evaluated once more with the full breakdown.
+  mem_array * tag_full  = NULL;
+  mem_array * data_full = new mem_array();
+  if (!pure_ram)
   {
-    for (miter = data_arr.begin(); miter != data_arr.end(); miter++)
-    {
-      uca_org_t & curr_org  = sol_list.back();
-      curr_org.tag_array2  = NULL;
-      curr_org.data_array2 = (*miter);
+    tag_full = new mem_array();
+    evaluate_full(best_tag, true, tag_full);
+  }
+  evaluate_full(best_data, false, data_full);
+
+  fin_res->tag_array2  = tag_full;
+  fin_res->data_array2 = data_full;
+  fin_res->find_delay();
+  fin_res->find_energy();
+  fin_res->find_area();
+  fin_res->find_cyc();
+}
 
-      curr_org.find_delay();
-      curr_org.find_energy();
-      curr_org.find_area();
-      curr_org.find_cyc();
 
-      //update min values for the entire cache
-      cache_min->update_min_values(curr_org);
 
-      sol_list.push_back(uca_org_t());
-    }
-  }
-  else
-  {
-    while (tag_arr.empty() != true) 
-    {
-      mem_array * arr_temp = (tag_arr.back());
-      //delete tag_arr.back();
-      tag_arr.pop_back();
+/* 
+ * Performs exhaustive search across different sub-array sizes, 
+ * wire types and aspect ratios to find an optimal UCA organization
+ * 1. First different valid tag array organizations are calculated
+ *    and stored in tag_arr array
+ * 2. The exhaustive search is repeated to find valid data array
+ *    organizations and stored in data_arr array
+ * 3. Cache area, delay, power, and cycle time for different
+ *    cache organizations are calculated based on the 
+ *    above results 
+ * 4. Cache model with least cost is picked by find_optimal_uca(),
+ *    which scores the combinations without storing them
+ * With a heuristic <search> engine, steps 1 and 2 only evaluate the
+ * partitions its chains visit (see search.h).
+ */
+void solve(uca_org_t *fin_res)
+{
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  array_candidates c;
 
-      for (miter = data_arr.begin(); miter != data_arr.end(); miter++)
-      {
-        uca_org_t & curr_org  = sol_list.back();
-        curr_org.tag_array2  = arr_temp;
-        curr_org.data_array2 = (*miter);
+  candidate_dump_begin_run();
+  init_tech_params(g_ip->F_sz_um, false);
+  sweep_arrays(!pure_ram, !g_ip->fully_assoc, c);
+  select_org(fin_res, c);
+}
 
-        curr_org.find_delay();
-        curr_org.find_energy();
-        curr_org.find_area();
-        curr_org.find_cyc();
 
-        //update min values for the entire cache
-        cache_min->update_min_values(curr_org);
 
-        sol_list.push_back(uca_org_t());
-      }
-    }
-  }
+// What the access mode changes in the arrays themselves (DynamicParameter,
+// the H-trees of UCA and Bank): a tag array only sees data_assoc, a data
+// array also fast_access where that widens its output (more than one way,
+// or fully associative). Under <constraints> the data array budget also
+// depends on the mode (see array_within_constraints()).
+static uint64_t data_array_class()
+{
+  bool fast = g_ip->fast_access && !g_ip->is_main_mem && (g_ip->data_assoc > 1 || g_ip->fully_assoc);
+  uint32_t mode = constraints_given() ? g_ip->access_mode : 0;
+  return ((uint64_t) g_ip->data_assoc << 8) | (fast << 4) | mode;
+}
 
-  sol_list.pop_back();
+static uint64_t tag_array_class()
+{
+  // a fully-associative tag pass also builds the data arrays
+  return g_ip->fully_assoc ? (data_array_class() | (1ULL << 63)) : g_ip->data_assoc;
+}
 
-  find_optimal_uca(fin_res, cache_min, sol_list);
 
-  sol_list.clear();
 
-  for (miter = data_arr.begin(); miter != data_arr.end(); ++miter)
+int solve_access_modes(uca_org_t fin_res[Access_modes])
+{
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  unsigned int mode0 = g_ip->access_mode;
+  bool pareto = g_ip->pareto_frontier;
+  array_candidates tags[Access_modes], datas[Access_modes];
+  int tag_src[Access_modes], data_src[Access_modes];
+  int passes = 0;
+
+  candidate_dump_begin_run();
+  init_tech_params(g_ip->F_sz_um, false);
+  for (int m = 0; m < Access_modes; m++)
   {
-    if (*miter != fin_res->data_array2)
+    g_ip->set_access_mode(m);
+    uint64_t tc = tag_array_class(), dc = data_array_class();
+    tag_src[m] = data_src[m] = m;
+    for (int k = 0; k < m; k++)
+    {
+      g_ip->set_access_mode(k);
+      if (tag_src[k] == k && tag_array_class() == tc)  tag_src[m]  = k;
+      if (data_src[k] == k && data_array_class() == dc) data_src[m] = k;
+    }
+    g_ip->set_access_mode(m);
+
+    if (!pure_ram && tag_src[m] == m)
+    {
+      sweep_arrays(true, false, tags[m]);
+      passes++;
+    }
+    if (!g_ip->fully_assoc && data_src[m] == m)
     {
-      delete *miter;
+      sweep_arrays(false, true, datas[m]);
+      passes++;
     }
   }
-  data_arr.clear();
 
-  for (uint32_t t = 0; t < nthreads; t++)
+  // each mode selects from its own copy; a fully-associative tag pass
+  // holds the data arrays as well
+  for (int m = 0; m < Access_modes; m++)
   {
-    delete calc_array[t].data_res;
-    delete calc_array[t].tag_res;
+    g_ip->set_access_mode(m);
+    g_ip->pareto_frontier = pareto && (unsigned int) m == mode0;
+
+    array_candidates c;
+    c.copy_from(tags[tag_src[m]], true, g_ip->fully_assoc);
+    c.copy_from(datas[data_src[m]], false, !g_ip->fully_assoc);
+    select_org(&fin_res[m], c);
   }
 
-  delete [] calc_array;
-  delete cache_min;
-  delete d_min;
-  delete t_min;
+  g_ip->set_access_mode(mode0);
+  g_ip->pareto_frontier = pareto;
+  init_tech_params(g_ip->F_sz_um, false);
+  return passes;
 }
 
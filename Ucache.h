@@ -43,6 +43,7 @@
 #define __UCACHE_H__
 
 #include <list>
+#include <vector>
 #include "area.h"
 #include "router.h"
 #include "nuca.h"
@@ -62,7 +63,7 @@ class min_values_t
     void update_min_values(const min_values_t * val);
     void update_min_values(const uca_org_t & res);
     void update_min_values(const nuca_org_t * res);
-    void update_min_values(const mem_array * res);
+    void update_min_values(const mem_array_metrics * res);
 };
 
 
@@ -82,6 +83,11 @@ struct solution
 
 
 
+// Evaluates one partition into ptr_array. Only the mem_array_metrics part
+// is filled unless flag_results_populate is set. With abort_reason given,
+// the evaluation stops as soon as the partition can not meet the
+// <constraints> access time or read energy; false is returned and the
+// stage is written to abort_reason (Eval_complete otherwise).
 bool calculate_time(
     bool is_tag,
     int pure_ram,
@@ -95,28 +101,183 @@ bool calculate_time(
     int flag_results_populate,
     results_mem_array *ptr_results,
     uca_org_t *ptr_fin_res,
-    bool is_main_mem);
+    bool is_main_mem,
+    int *abort_reason);
 
 
+// <constraints> checks: an array that fails can not be part of any cache
+// organization that meets the cache budgets
+bool array_within_constraints(const mem_array_metrics * m, bool is_tag);
+bool org_within_constraints(const uca_org_t & u);
+
 void solve(uca_org_t *fin_res);
+
+// merged candidates of the array passes of one solve, with their minima
+struct array_candidates
+{
+  list<mem_array_metrics *> tag_arr;
+  list<mem_array_metrics *> data_arr;
+  min_values_t tag_min;
+  min_values_t data_min;
+
+  ~array_candidates();
+  void copy_from(const array_candidates & c, bool tag, bool data);
+};
+
+// The two halves of solve(), for callers that keep the candidates of a pass
+// (see whatif.h). sweep_arrays() runs the tag array pass (a
+// fully-associative one also yields the data arrays) and/or the data array
+// pass under the current g_ip, and merges the candidates of all threads
+// into c. select_org() picks the organization from c, which is used up;
+// the arr_min of the result points into c.
+void sweep_arrays(bool tag_pass, bool data_pass, array_candidates & c);
+void select_org(uca_org_t *fin_res, array_candidates & c);
+
+// solve() for every access mode, fin_res indexed by Access_mode. Modes
+// whose tag or data arrays come out identical share that array pass.
+// Returns the number of array passes run.
+int  solve_access_modes(uca_org_t fin_res[Access_modes]);
 void init_tech_params(double tech, bool is_tag);
 
+// values of a device file that tech_perturb can scale
+enum Device_value
+{
+  Dv_vdd, Dv_v_th, Dv_I_on_n, Dv_I_on_p, Dv_I_off_n, Dv_I_off_p,
+  Dv_c_ox, Dv_c_fringe, Dv_c_junc, Dv_Lphy,
+  Device_values
+};
+
+enum Tech_target
+{
+  Tt_cell,              // cell device file of the array
+  Tt_peri,              // peripheral device file of the array
+  Tt_wire_inside_mat,
+  Tt_wire_outside_mat
+};
+
+// While tech_perturb is set, init_tech_params() scales one input of the
+// technology tables by factor: a device file value (param is a
+// Device_value) or the R (param 0) or C (param 1) per um of a wire type.
+// Everything derived from it follows. See sensitivity.h.
+struct tech_perturbation
+{
+  int    target;  // Tech_target
+  int    param;
+  double factor;
+};
+
+extern const tech_perturbation * tech_perturb;
+
+
+// one point of the Nspd x Ndwl x Ndbl x Ndcm x Ndsam_lev_1 x Ndsam_lev_2 grid
+struct partition_t
+{
+  double       Nspd;
+  unsigned int Ndwl;
+  unsigned int Ndbl;
+  unsigned int Ndcm;
+  unsigned int Ndsam_lev_1;
+  unsigned int Ndsam_lev_2;
+};
+
+// Fills parts with the grid points that DynamicParameter accepts for the
+// current g_ip/g_tp; with force_cache_config the data array grid is reduced
+// to the forced Ndwl/Ndbl/Ndcm (and Nspd/Ndsam when given).
+void enumerate_partitions(
+    bool is_tag,
+    bool pure_ram,
+    bool is_main_mem,
+    double Nspd_min,
+    vector<partition_t> & parts);
+
+// Neighborhood of an earlier solution: while solve_window is set, the tag
+// and data grids are cut to the points within radius octaves of its
+// partitions in every dimension, and the <search> engine is not used.
+struct partition_window
+{
+  partition_t tag;
+  partition_t data;
+  uint32_t    radius;
+};
+
+extern const partition_window * solve_window;
+
+
+class search_state;
+class dump_block;
 
 struct calc_time_mt_wrapper_struct
 {
-  uint32_t tid;
   bool     is_tag;
   bool     pure_ram;
   bool     is_main_mem;
-  double   Nspd_min;
+
+  const vector<partition_t> * parts;  // shared work list
+  volatile uint32_t * next_part;      // next unclaimed index into parts
+  search_state * search;              // heuristic search instead of parts, see search.h
 
   min_values_t * data_res;
   min_values_t * tag_res;
 
-  list<mem_array *> data_arr;
-  list<mem_array *> tag_arr;
+  uint64_t n_evaluated;  // calculate_time() calls made by this thread
+  uint64_t n_aborted[Eval_abort_types];  // of those, cut short per Eval_abort reason
+
+  list<mem_array_metrics *> data_arr;
+  list<mem_array_metrics *> tag_arr;
+  dump_block * dump[2];  // rows of tag_arr and data_arr while dumping (Dump_section), see dump.h
+
+  string error;  // first cacti_error of the thread's partitions
 };
 
 void *calc_time_mt_wrapper(void * void_obj);
 
+// Evaluates partition p for the thread's array pass; when record is set, a
+// valid partition is entered into its candidate lists and minima. The
+// metrics are left in tag_res_arr/data_res_arr.
+bool evaluate_partition(
+    calc_time_mt_wrapper_struct * calc_obj,
+    const partition_t & p,
+    mem_array & tag_res_arr,
+    mem_array & data_res_arr,
+    bool record);
+
+
+// one thread's share of the tag x data combinations in find_optimal_uca()
+struct combine_mt_wrapper_struct
+{
+  const vector<mem_array_metrics *> * tags;   // one NULL entry for a pure RAM
+  const vector<mem_array_metrics *> * datas;
+  uint64_t first;                     // pair range [first, last)
+  uint64_t last;
+
+  const min_values_t * cache_min;     // NULL in the first (minima) pass
+
+  min_values_t min;                   // first pass: minima of the range
+  uint64_t n_valid;                   // first pass: pairs within <constraints>
+  double   best_cost;                 // second pass: incumbent of the range
+  uint64_t best_pair;
+  uint32_t keep;                      // second pass: also collect the keep
+  vector<pair<double, uint64_t> > top;  // cheapest (cost, pair) of the range
+  dump_block * dump;                  // second pass: rows of the range, see dump.h
+};
+
+void *combine_mt_wrapper(void * void_obj);
+
+void find_optimal_uca(
+    uca_org_t *res,
+    const mem_array_metrics * & best_tag,
+    const mem_array_metrics * & best_data,
+    const list<mem_array_metrics *> & tag_arr,
+    const list<mem_array_metrics *> & data_arr,
+    bool pure_ram);
+
+// cost used to rank cache organizations; BIGNUM if the organization
+// misses the max deviation limits
+double org_cost(const uca_org_t & u, const min_values_t * minval);
+
+extern uint32_t nthreads;
+extern uint64_t solve_partitions_evaluated;
+extern uint64_t solve_partitions_aborted[Eval_abort_types];
+extern min_values_t solve_selection_min;
+
 #endif
@@ -0,0 +1,249 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <math.h>
+#include <sys/mman.h>
+
+#include "banksim.h"
+#include "basic_circuit.h"
+#include "parameter.h"
+
+using namespace std;
+
+
+#define BSIM_SUB_BUCKETS  64   // histogram resolution per octave
+
+
+static inline uint64_t splitmix64(uint64_t & s)
+{
+  uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+static inline double uniform01(uint64_t & s)
+{
+  return (splitmix64(s) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+
+
+bank_sim_stream::bank_sim_stream()
+ :rec(NULL), n(0), time_unit(1e-12), map(NULL), map_len(0)
+{
+}
+
+
+
+bank_sim_stream::~bank_sim_stream()
+{
+  if (map != NULL) munmap(map, map_len);
+}
+
+
+
+void bank_sim_stream::load()
+{
+  if (g_ip->bsim_stream == Bsim_trace)
+  {
+    rec = map_trace(g_ip->trace_file, n, map_len);
+    map = (void *) rec;
+    time_unit = g_ip->trace_time_unit;
+    return;
+  }
+
+  // Poisson arrivals in ps ticks over the blocks of the cache
+  uint64_t seed     = g_ip->bsim_seed;
+  uint64_t n_blocks = MAX(1, g_ip->cache_sz / g_ip->line_sz);
+  double   t = 0;
+  synth.resize(g_ip->bsim_requests);
+  for (uint64_t i = 0; i < synth.size(); i++)
+  {
+    t += -log(1.0 - uniform01(seed)) / g_ip->bsim_rate;
+    uint64_t blk = g_ip->bsim_sequential ? i % n_blocks : splitmix64(seed) % n_blocks;
+    synth[i].addr  = blk * g_ip->line_sz;
+    synth[i].stamp = (uint64_t) (t * 1e12);
+    if (uniform01(seed) < g_ip->bsim_write_fraction) synth[i].stamp |= TRACE_WRITE_BIT;
+  }
+  rec = synth.empty() ? NULL : &synth[0];
+  n   = synth.size();
+  time_unit = 1e-12;
+}
+
+
+
+static inline uint32_t bucket_of(uint64_t v)
+{
+  if (v < 2 * BSIM_SUB_BUCKETS) return v;
+  uint32_t e = (63 - __builtin_clzll(v)) - 6;  // 2^6 == BSIM_SUB_BUCKETS
+  return BSIM_SUB_BUCKETS * e + (v >> e);
+}
+
+static inline uint64_t bucket_floor(uint32_t b)
+{
+  if (b < 2 * BSIM_SUB_BUCKETS) return b;
+  uint32_t e = b / BSIM_SUB_BUCKETS - 1;
+  return (uint64_t) (b % BSIM_SUB_BUCKETS + BSIM_SUB_BUCKETS) << e;
+}
+
+static double hist_quantile(const vector<uint64_t> & hist, uint64_t n, double q)
+{
+  uint64_t rank = (uint64_t) ceil(q * n), seen = 0;
+  for (uint32_t b = 0; b < hist.size(); b++)
+  {
+    seen += hist[b];
+    if (seen >= rank && seen > 0) return bucket_floor(b) * 1e-12;
+  }
+  return 0;
+}
+
+
+
+void simulate_banks(const bank_sim_org & org, const bank_sim_stream & s, bank_sim_result & r)
+{
+  uint32_t rw = g_ip->num_rw_ports, rd = g_ip->num_rd_ports, wr = g_ip->num_wr_ports;
+  uint32_t n_ports   = MAX(1u, rw + rd + wr);
+  uint32_t bank_bits = _log2(org.nbanks);
+  uint64_t sub_mask  = org.nsubbanks - 1;
+  bool     pow2_block = is_pow2(g_ip->line_sz);
+  uint32_t block_shift = pow2_block ? _log2(g_ip->line_sz) : 0;
+
+  vector<double>   last_start(org.nbanks, 0);
+  vector<double>   port_free((uint64_t) org.nbanks * n_ports, 0);
+  vector<double>   sub_free((uint64_t) org.nbanks * org.nsubbanks, 0);
+  vector<uint64_t> hist(BSIM_SUB_BUCKETS * 66, 0);
+
+  double first = 0, last_arrival = 0, end = 0, q_sum = 0, q_max = 0;
+  for (uint64_t i = 0; i < s.n; i++)
+  {
+    const trace_record & a = s.rec[i];
+    bool     is_write = (a.stamp & TRACE_WRITE_BIT) != 0;
+    double   arrival  = (a.stamp & ~TRACE_WRITE_BIT) * s.time_unit;
+    uint64_t blk  = pow2_block ? a.addr >> block_shift : a.addr / g_ip->line_sz;
+    uint32_t bank = blk & (org.nbanks - 1);
+    uint64_t sub  = (uint64_t) bank * org.nsubbanks + ((blk >> bank_bits) & sub_mask);
+
+    // ports [0, rw) serve both, then rd exclusive read and wr exclusive write ports
+    double * ports = &port_free[(uint64_t) bank * n_ports];
+    int32_t p_best = -1;
+    for (uint32_t p = 0; p < n_ports; p++)
+    {
+      bool usable = (p < rw) || (is_write ? p >= rw + rd : p < rw + rd);
+      if (usable && (p_best < 0 || ports[p] < ports[p_best])) p_best = p;
+    }
+    if (p_best < 0) p_best = 0;
+
+    double start = MAX(MAX(arrival, last_start[bank]), MAX(ports[p_best], sub_free[sub]));
+    ports[p_best]    = start + org.interleave_time;
+    sub_free[sub]    = start + org.cycle_time;
+    last_start[bank] = start;
+
+    double q = start - arrival;
+    q_sum += q;
+    q_max  = MAX(q_max, q);
+    hist[bucket_of((uint64_t) (q * 1e12 + 0.5))]++;
+    if (i == 0) first = arrival;
+    last_arrival = MAX(last_arrival, arrival);
+    end = MAX(end, start + org.access_time);
+  }
+
+  r.requests      = s.n;
+  r.offered_rate  = (last_arrival > first) ? (s.n - 1) / (last_arrival - first) : 0;
+  r.achieved_rate = (end > first) ? s.n / (end - first) : 0;
+  r.mean_queue    = s.n ? q_sum / s.n : 0;
+  r.p50_queue     = hist_quantile(hist, s.n, 0.5);
+  r.p90_queue     = hist_quantile(hist, s.n, 0.9);
+  r.p99_queue     = hist_quantile(hist, s.n, 0.99);
+  r.max_queue     = q_max;
+  r.mean_latency  = org.access_time + r.mean_queue;
+}
+
+
+
+void bank_sim_report(const uca_org_t * fin_res)
+{
+  if (g_ip->nuca == 1)
+  {
+    cout << "\nBank-conflict simulation: only supported for UCA organizations, skipped\n";
+    return;
+  }
+
+  bank_sim_org org;
+  org.nbanks          = g_ip->nbanks;
+  org.nsubbanks       = fin_res->data_array2->number_subbanks;
+  org.access_time     = fin_res->access_time;
+  org.cycle_time      = fin_res->cycle_time;
+  org.interleave_time = fin_res->data_array2->multisubbank_interleave_cycle_time;
+  if (fin_res->tag_array2 != NULL)
+  {
+    org.interleave_time = MAX(org.interleave_time, fin_res->tag_array2->multisubbank_interleave_cycle_time);
+  }
+
+  bank_sim_stream s;
+  s.load();
+  bank_sim_result r;
+  simulate_banks(org, s, r);
+
+  cout << "\nBank-conflict simulation (";
+  if (g_ip->bsim_stream == Bsim_trace)
+    cout << g_ip->trace_file;
+  else
+    cout << (g_ip->bsim_sequential ? "sequential" : "random") << " blocks, Poisson arrivals at "
+         << g_ip->bsim_rate * 1e-9 << " per ns";
+  cout << "; " << r.requests << " requests, " << org.nbanks << " bank(s) x " << org.nsubbanks
+       << " subbank(s), " << g_ip->num_rw_ports << "/" << g_ip->num_rd_ports << "/" << g_ip->num_wr_ports
+       << " rw/rd/wr ports):\n";
+  cout << "    Interleave cycle (ns): " << org.interleave_time * 1e9
+       << "  random cycle (ns): " << org.cycle_time * 1e9 << endl;
+  cout << "    Offered rate (per ns): " << r.offered_rate * 1e-9
+       << "  achieved (per ns): " << r.achieved_rate * 1e-9
+       << "  bandwidth (GB/s): " << r.achieved_rate * g_ip->line_sz * 1e-9 << endl;
+  cout << "    Queueing delay (ns): mean " << r.mean_queue * 1e9
+       << "  p50 " << r.p50_queue * 1e9
+       << "  p90 " << r.p90_queue * 1e9
+       << "  p99 " << r.p99_queue * 1e9
+       << "  max " << r.max_queue * 1e9 << endl;
+  cout << "    Mean loaded latency (ns): " << r.mean_latency * 1e9 << endl;
+}
@@ -0,0 +1,117 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __BANKSIM_H__
+#define __BANKSIM_H__
+
+#include <vector>
+#include "cacti_interface.h"
+#include "trace.h"
+
+using namespace std;
+
+
+enum Bank_sim_stream
+{
+  Bsim_none,
+  Bsim_synthetic,  // Poisson arrivals, random or sequential blocks
+  Bsim_trace       // the <trace> file
+};
+
+
+// timing of one UCA organization as the scheduler sees it
+struct bank_sim_org
+{
+  uint32_t nbanks;
+  uint32_t nsubbanks;         // per bank
+  double   access_time;       // s
+  double   cycle_time;        // s, a subbank is busy this long per access
+  double   interleave_time;   // s, a port issues at most one access per interleave
+};
+
+struct bank_sim_result
+{
+  uint64_t requests;
+  double   offered_rate;      // requests/s
+  double   achieved_rate;     // requests/s, first arrival to last completion
+  double   mean_queue;        // s
+  double   p50_queue, p90_queue, p99_queue, max_queue;  // s
+  double   mean_latency;      // s, access time plus queueing
+};
+
+
+// The request stream of g_ip's <bank_sim>, kept in memory or mapped from
+// the trace file.
+class bank_sim_stream
+{
+  public:
+    bank_sim_stream();
+    ~bank_sim_stream();
+
+    void load();
+
+    const trace_record * rec;
+    uint64_t n;
+    double   time_unit;       // s per timestamp tick
+
+  private:
+    vector<trace_record> synth;
+    void * map;
+    size_t map_len;
+};
+
+
+/*
+ * Cycle-approximate FCFS scheduler for the UCA banks. Accesses are taken in
+ * stream order; each goes to the bank and subbank of its block (block-
+ * interleaved, banks first) and starts once it has arrived, the earlier
+ * accesses of its bank have started, one of its ports (read/write,
+ * exclusive read or exclusive write) is past its interleave cycle and its
+ * subbank is past its random cycle. The queueing delay is the start minus
+ * the arrival; percentiles come from a log-bucketed histogram (1/64
+ * octave).
+ */
+void simulate_banks(const bank_sim_org & org, const bank_sim_stream & s, bank_sim_result & r);
+
+// simulates the stream on the organization chosen by solve() and prints it
+void bank_sim_report(const uca_org_t * fin_res);
+
+#endif
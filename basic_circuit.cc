@@ -51,8 +51,7 @@ uint32_t _log2(uint64_t num)
 
   if (num == 0)
   {
-    std::cerr << "log0?" << std::endl;
-    exit(1);
+    throw cacti_error("log0?", 1);
   }
 
   while (num > 1)
@@ -252,7 +251,7 @@ double drain_C_(
     double W_min = 2 * dt->H_fin;
     N_fin = (int) (ceil(width / W_min));
     int N_fin_max = (int) (floor(w_folded_tr / dt->P_fin)); // + 1;
-	 if ( N_fin_max == 0 ) { cout << "ERROR: divide by zero in drain_C_ function!\n"; exit(0); }
+	 if ( N_fin_max == 0 ) throw cacti_error("divide by zero in drain_C_ function!");
 	 num_folded_tr = (int) (ceil((double)N_fin / N_fin_max));
 	 N_fin_in_each_fold = (int) (ceil((double)N_fin / num_folded_tr));
   } else {
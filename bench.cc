@@ -0,0 +1,404 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "bench.h"
+#include "io.h"
+#include "nuca.h"
+#include "parameter.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+// every point runs the full partition sweep; finfet 8T is left out because
+// the skewed-inverter sense amp has no finfet sizing in init_tech_params()
+static const bench_point bench_matrix[] =
+{
+  // cfg_file                        sram_cell_file                           size    assoc banks nuca  cache mode  forced
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_6T.xml",     262144,   4,  1, false,  1, -1, false},
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_8T.xml",     262144,   4,  1, false,  1, -1, false},
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_10T.xml",    262144,   4,  1, false,  1, -1, false},
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_6T.xml",    2097152,   1,  1, false, -1, -1, false},
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_8T.xml",    2097152,   1,  1, false, -1, -1, false},
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_10T.xml",   2097152,   1,  1, false, -1, -1, false},
+  {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_10T.xml",   8388608,   8,  4, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T1.xml",  262144,   4,  1, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T1.xml", 4194304,   8,  4, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T2.xml", 4194304,   8,  4, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T3.xml", 4194304,   8,  4, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T4.xml", 4194304,   8,  4, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T1.xml", 16777216, 16,  8, false,  1, -1, false},
+  {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T1.xml", 8388608,   8,  1, true ,  1, -1, false},
+};
+
+
+
+static double wall_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+
+// sim_nuca() prints its statistics to stdout; keep them out of the measurement
+int silence_stdout()
+{
+  cout.flush();
+  fflush(stdout);
+  int saved_fd = dup(STDOUT_FILENO);
+  int null_fd  = open("/dev/null", O_WRONLY);
+  dup2(null_fd, STDOUT_FILENO);
+  close(null_fd);
+  return saved_fd;
+}
+
+
+
+void restore_stdout(int saved_fd)
+{
+  cout.flush();
+  fflush(stdout);
+  dup2(saved_fd, STDOUT_FILENO);
+  close(saved_fd);
+}
+
+
+
+// the parsers and error_checking() give the reason for a rejection on cerr;
+// returns it on one line
+static string rejection_reason(const ostringstream & err)
+{
+  string why = err.str();
+  for (uint32_t i = 0; i < why.size(); i++) if (why[i] == '\n') why[i] = ' ';
+  while (!why.empty() && why[why.size() - 1] == ' ') why.erase(why.size() - 1);
+  return why;
+}
+
+
+
+void load_bench_point(const bench_point & bp)
+{
+  // held back until the point is accepted, and made part of the error otherwise
+  ostringstream err;
+  streambuf * saved_cerr = cerr.rdbuf(err.rdbuf());
+  bool ok = false;
+
+  try
+  {
+    g_ip = new InputParameter();
+    g_ip->parse_cfg(bp.cfg_file);
+    if (bp.sram_cell_file != NULL)
+    {
+      g_ip->parse_sram_cell(bp.sram_cell_file);
+    }
+    if (bp.cache_sz != 0)
+    {
+      g_ip->cache_sz        = bp.cache_sz;
+      g_ip->assoc           = bp.assoc;
+      g_ip->nbanks          = bp.nbanks;
+      g_ip->nuca            = bp.nuca;
+      g_ip->nuca_bank_count = bp.nuca ? bp.nbanks * 4 : 0;
+      g_ip->force_nuca_bank = bp.nuca;
+    }
+    if (bp.is_cache >= 0)
+    {
+      g_ip->is_cache    = bp.is_cache;
+      g_ip->is_main_mem = false;
+    }
+    if (bp.access_mode >= 0)
+    {
+      g_ip->access_mode = bp.access_mode;
+    }
+    g_ip->force_cache_config = bp.force_cache_config;
+    g_ip->print_input_args   = false;
+
+    ok = g_ip->error_checking();
+  }
+  catch (const cacti_error & e)
+  {
+    cerr.rdbuf(saved_cerr);
+    string why = rejection_reason(err);
+    throw cacti_error(why == "" ? e.msg : e.msg + ": " + why, e.status);
+  }
+  cerr.rdbuf(saved_cerr);
+
+  if (!ok)
+  {
+    string why = rejection_reason(err);
+    throw cacti_error(string("invalid benchmark point (") + bp.cfg_file + ", " +
+                      (bp.sram_cell_file ? bp.sram_cell_file : "default cell") + ")" +
+                      (why == "" ? "" : ": " + why), 1);
+  }
+  cerr << err.str();
+
+  init_tech_params(g_ip->F_sz_um, false);
+  Wire winit; // initializes the (static) wire tables for this technology
+}
+
+
+
+void solve_bench_point(const bench_point & bp, uca_org_t * fin_res)
+{
+  if (bp.cache_sz != 0)
+  {
+    g_ip->cache_sz = bp.cache_sz;  // sim_nuca() leaves the per-bank size behind
+  }
+  if (g_ip->nuca == 1)
+  {
+    Nuca n(&g_tp.peri_global);
+    n.sim_nuca();
+  }
+  solve(fin_res);
+}
+
+
+
+// what the child of a point sends back through its pipe
+struct bench_result
+{
+  int32_t  failed;      // the point threw a cacti_error
+  int32_t  status;      // its status
+  uint64_t partitions;  // of the last timed run
+  uint64_t pruned;
+  uint32_t length;      // bytes that follow: the samples, or the error message
+};
+
+
+
+static void write_all(int fd, const void * buf, size_t len)
+{
+  const char * p = (const char *) buf;
+  while (len > 0)
+  {
+    ssize_t n = write(fd, p, len);
+    if (n <= 0) _exit(2);
+    p   += n;
+    len -= n;
+  }
+}
+
+
+
+static bool read_all(int fd, void * buf, size_t len)
+{
+  char * p = (char *) buf;
+  while (len > 0)
+  {
+    ssize_t n = read(fd, p, len);
+    if (n <= 0) return false;
+    p   += n;
+    len -= n;
+  }
+  return true;
+}
+
+
+
+// child side: times the runs of one point and sends them to fd; never returns
+static void bench_child(const bench_point & bp, uint32_t warmup, uint32_t reps, int fd)
+{
+  bench_result res = {0, 0, 0, 0, 0};
+  vector<double> samples;
+  string error;
+
+  silence_stdout();
+  try
+  {
+    load_bench_point(bp);
+    for (uint32_t r = 0; r < warmup + reps; r++)
+    {
+      uint64_t evals_before = solve_partitions_evaluated;
+      uint64_t pruned_before = 0;
+      for (int a = 1; a < Eval_abort_types; a++) pruned_before += solve_partitions_aborted[a];
+      double t0 = wall_time();
+      uca_org_t fin_res;
+      solve_bench_point(bp, &fin_res);
+      double t1 = wall_time();
+      delete fin_res.data_array2;
+      delete fin_res.tag_array2;
+      if (r >= warmup)
+      {
+        samples.push_back(t1 - t0);
+        res.partitions = solve_partitions_evaluated - evals_before;
+        res.pruned = 0;
+        for (int a = 1; a < Eval_abort_types; a++) res.pruned += solve_partitions_aborted[a];
+        res.pruned -= pruned_before;
+      }
+    }
+  }
+  catch (const cacti_error & e)
+  {
+    res.failed = 1;
+    res.status = e.status;
+    error      = e.msg;
+  }
+
+  res.length = res.failed ? error.size() : samples.size() * sizeof(double);
+  write_all(fd, &res, sizeof(res));
+  write_all(fd, res.failed ? (const void *) error.data() : (const void *) &samples[0], res.length);
+  close(fd);
+  _exit(0);
+}
+
+
+
+// runs one point in a child process, so that its peak RSS is its own;
+// returns the child's ru_maxrss in kB
+static long run_bench_point(const bench_point & bp, uint32_t warmup, uint32_t reps,
+                            vector<double> & samples, uint64_t & partitions, uint64_t & pruned)
+{
+  int fds[2];
+
+  cout.flush();
+  fflush(stdout);
+  if (pipe(fds) != 0)
+  {
+    throw cacti_error("pipe failed", 1);
+  }
+  pid_t pid = fork();
+  if (pid < 0)
+  {
+    throw cacti_error("fork failed", 1);
+  }
+  if (pid == 0)
+  {
+    close(fds[0]);
+    bench_child(bp, warmup, reps, fds[1]);
+  }
+  close(fds[1]);
+
+  bench_result res;
+  string payload;
+  bool ok = read_all(fds[0], &res, sizeof(res));
+  if (ok)
+  {
+    payload.resize(res.length);
+    ok = (res.length == 0 || read_all(fds[0], &payload[0], res.length));
+  }
+  close(fds[0]);
+
+  int status;
+  struct rusage ru;
+  wait4(pid, &status, 0, &ru);
+  if (!ok)
+  {
+    ostringstream msg;
+    msg << "benchmark point (" << bp.cfg_file << ", "
+        << (bp.sram_cell_file ? bp.sram_cell_file : "default cell") << ") died with "
+        << (WIFEXITED(status) ? "status " : "signal ")
+        << (WIFEXITED(status) ? WEXITSTATUS(status) : WTERMSIG(status));
+    throw cacti_error(msg.str(), 1);
+  }
+  if (res.failed)
+  {
+    throw cacti_error(payload, res.status);
+  }
+
+  samples.assign((const double *) payload.data(), (const double *) (payload.data() + payload.size()));
+  partitions = res.partitions;
+  pruned     = res.pruned;
+  return ru.ru_maxrss;
+}
+
+
+
+void run_bench(const string & out_file, uint32_t warmup, uint32_t reps)
+{
+  ofstream csv(out_file.c_str());
+  uint32_t npoints = sizeof(bench_matrix)/sizeof(bench_matrix[0]);
+
+  if (!csv)
+  {
+    cout << "ERROR: cannot open " << out_file << " for writing" << endl;
+    exit(1);
+  }
+  if (reps == 0) reps = 1;
+
+  csv << "cfg_file,sram_cell_file,cache_sz,assoc,nbanks,model,nthreads,warmup,reps,"
+      << "median_s,p95_s,min_s,partitions,partitions_per_s,peak_rss_kb,partitions_pruned" << endl;
+
+  cout << "Benchmark: " << npoints << " points, " << nthreads << " threads, "
+       << warmup << " warmup + " << reps << " timed runs each" << endl;
+
+  for (uint32_t p = 0; p < npoints; p++)
+  {
+    const bench_point & bp = bench_matrix[p];
+
+    vector<double> samples;
+    uint64_t partitions = 0;
+    uint64_t pruned = 0;
+    long     rss = run_bench_point(bp, warmup, reps, samples, partitions, pruned);
+
+    sort(samples.begin(), samples.end());
+    double median = (samples.size() % 2) ? samples[samples.size()/2] :
+                    (samples[samples.size()/2 - 1] + samples[samples.size()/2]) / 2;
+    double p95    = samples[(uint32_t) ceil(0.95 * samples.size()) - 1];
+    double pps    = (median > 0) ? partitions / median : 0;
+
+    csv << bp.cfg_file << "," << bp.sram_cell_file << "," << bp.cache_sz << ","
+        << bp.assoc << "," << bp.nbanks << "," << (bp.nuca ? "NUCA" : "UCA") << ","
+        << nthreads << "," << warmup << "," << reps << ","
+        << median << "," << p95 << "," << samples[0] << ","
+        << partitions << "," << pps << "," << rss << "," << pruned << endl;
+
+    printf("%2u %-38s %9u B %3u-way %2u bank(s) %-4s  median %8.4f s  p95 %8.4f s  %10.0f part/s  rss %ld kB\n",
+           p, bp.sram_cell_file, bp.cache_sz, bp.assoc, bp.nbanks, (bp.nuca ? "NUCA" : "UCA"),
+           median, p95, pps, rss);
+    fflush(stdout);
+  }
+
+  cout << "Baseline written to " << out_file << endl;
+}
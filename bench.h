@@ -0,0 +1,87 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <string>
+#include "cacti_interface.h"
+
+using namespace std;
+
+
+// one solver run derived from a shipped cache_config
+struct bench_point
+{
+  const char * cfg_file;
+  const char * sram_cell_file;   // NULL keeps the cell of cfg_file
+  unsigned int cache_sz;         // 0 keeps size, associativity and banks of cfg_file
+  unsigned int assoc;
+  unsigned int nbanks;
+  bool         nuca;
+  int          is_cache;         // -1 keeps the memory type of cfg_file
+  int          access_mode;      // -1 keeps the access mode of cfg_file
+  bool         force_cache_config;
+};
+
+// creates g_ip for the point and initializes the technology and wire tables
+void load_bench_point(const bench_point & bp);
+// evaluates g_ip the way cacti_interface() does; the caller owns
+// fin_res->tag_array2 and fin_res->data_array2 afterwards
+void solve_bench_point(const bench_point & bp, uca_org_t * fin_res);
+
+// sends stdout (e.g. the sim_nuca() statistics) to /dev/null until restore_stdout()
+int  silence_stdout();
+void restore_stdout(int saved_fd);
+
+
+/*
+ * Benchmark harness for the solver. Runs solve() (and sim_nuca() for the
+ * NUCA points) over a fixed matrix built from the shipped xmls/ configs,
+ * the sram_cells variants and a few capacity/associativity/bank points,
+ * and writes one CSV row per point to out_file: median/p95/min wall time,
+ * partitions handed to calculate_time() per timed run, partitions per second
+ * (at the median) and the peak RSS of the point. Each point runs in its own
+ * child process, so the RSS is not carried over from an earlier point.
+ */
+void run_bench(const string & out_file, uint32_t warmup, uint32_t reps);
+
+#endif
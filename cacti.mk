@@ -26,7 +26,7 @@ CC  = gcc -m32
 
 SRCS  = xmlParser.cc area.cc bank.cc mat.cc main.cc Ucache.cc io.cc technology.cc basic_circuit.cc parameter.cc \
 		decoder.cc component.cc uca.cc subarray.cc wire.cc htree2.cc \
-		cacti_interface.cc router.cc nuca.cc crossbar.cc arbiter.cc 
+		cacti_interface.cc router.cc nuca.cc crossbar.cc arbiter.cc bench.cc golden.cc montecarlo.cc tempsweep.cc voltsweep.cc techsweep.cc pareto.cc search.cc journal.cc sweep.cc trace.cc banksim.cc hier.cc whatif.cc sensitivity.cc dump.cc 
 
 OBJS = $(patsubst %.cc,obj_$(TAG)/%.o,$(SRCS))
 PYTHONLIB_SRCS = $(patsubst main.cc, ,$(SRCS)) obj_$(TAG)/cacti_wrap.cc
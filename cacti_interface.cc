@@ -97,12 +97,10 @@ double SRAMCellParameters::calc_height(double lambda_um) {
              + MAX(MAX(acc.Lphy, rac.Lphy), MAX(pup.Lphy, pdn.Lphy))
              + ((4*W_G2C)+(2*W_C))*lambda_um;
     } else {
-      cout << "ERROR: Invalid SRAM cell type in 'calc_height' function!\n";
-      exit(0);
+      throw cacti_error("Invalid SRAM cell type in 'calc_height' function!");
     }
   } else {
-    cout << "ERROR: Planar CMOS devices are not supported by 'calc_height' function!\n";
-    exit(0);
+    throw cacti_error("Planar CMOS devices are not supported by 'calc_height' function!");
   }
   return height;
 }
@@ -137,12 +135,10 @@ double SRAMCellParameters::calc_width(double lambda_um, double p_fin, double t_s
         }
       }
     } else {
-      cout << "ERROR: Invalid SRAM cell type in 'calc_width' function!\n";
-      exit(0);
+      throw cacti_error("Invalid SRAM cell type in 'calc_width' function!");
     }
   } else {
-    cout << "ERROR: Planar CMOS devices are not supported by 'calc_width' function!\n";
-    exit(0);
+    throw cacti_error("Planar CMOS devices are not supported by 'calc_width' function!");
   }
   return width;
 }
@@ -187,7 +183,7 @@ void SRAMCellParameters::print_transistor_params() {
 
 
 
-bool mem_array::lt(const mem_array * m1, const mem_array * m2)
+bool mem_array_metrics::lt(const mem_array_metrics * m1, const mem_array_metrics * m2)
 {
   if (m1->Nspd < m2->Nspd) return true;
   else if (m1->Nspd > m2->Nspd) return false;
@@ -200,6 +196,10 @@ bool mem_array::lt(const mem_array * m1, const mem_array * m2)
   else if (m1->Ndsam_lev_1 < m2->Ndsam_lev_1) return true;
   else if (m1->Ndsam_lev_1 > m2->Ndsam_lev_1) return false;
   else if (m1->Ndsam_lev_2 < m2->Ndsam_lev_2) return true;
+  else if (m1->Ndsam_lev_2 > m2->Ndsam_lev_2) return false;
+  // wire type last, so that the merged candidate order (and the winner on
+  // cost ties) does not depend on how partitions were spread over threads
+  else if (m1->wt < m2->wt) return true;
   else return false;
 }
 
@@ -207,9 +207,28 @@ bool mem_array::lt(const mem_array * m1, const mem_array * m2)
 
 void uca_org_t::find_delay()
 {
-  mem_array * data_arr = data_array2;
-  mem_array * tag_arr  = tag_array2;
+  find_delay(tag_array2, data_array2);
+}
+
+void uca_org_t::find_energy()
+{
+  find_energy(tag_array2, data_array2);
+}
 
+void uca_org_t::find_area()
+{
+  find_area(tag_array2, data_array2);
+}
+
+void uca_org_t::find_cyc()
+{
+  find_cyc(tag_array2, data_array2);
+}
+
+
+
+void uca_org_t::find_delay(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr)
+{
   // check whether it is a regular cache or scratch ram
   if (g_ip->is_cache == false)
   {
@@ -243,43 +262,43 @@ void uca_org_t::find_delay()
 
 
 
-void uca_org_t::find_energy()
+void uca_org_t::find_energy(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr)
 {
   if (g_ip->is_cache) 
-    power = data_array2->power + tag_array2->power;
+    power = data_arr->power + tag_arr->power;
   else 
-    power = data_array2->power;
+    power = data_arr->power;
 }
 
 
 
-void uca_org_t::find_area()
+void uca_org_t::find_area(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr)
 {
   if (g_ip->is_cache == false)
   {
-    cache_ht  = data_array2->height;
-    cache_len = data_array2->width;
+    cache_ht  = data_arr->height;
+    cache_len = data_arr->width;
   }
   else
   {
-    cache_ht  = MAX(tag_array2->height, data_array2->height);
-    cache_len = tag_array2->width + data_array2->width;
+    cache_ht  = MAX(tag_arr->height, data_arr->height);
+    cache_len = tag_arr->width + data_arr->width;
   }
   area = cache_ht * cache_len;
 }
 
 
 
-void uca_org_t::find_cyc()
+void uca_org_t::find_cyc(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr)
 {
   if (g_ip->is_cache == false)
   {
-    cycle_time = data_array2->cycle_time;
+    cycle_time = data_arr->cycle_time;
   }
   else
   {
-    cycle_time = MAX(tag_array2->cycle_time, 
-                    data_array2->cycle_time);
+    cycle_time = MAX(tag_arr->cycle_time, 
+                    data_arr->cycle_time);
   }
 }
 
@@ -52,10 +52,24 @@ using namespace std;
 
 
 class min_values_t;
+class mem_array_metrics;
 class mem_array;
 class uca_org_t;
 
 
+// Failure of one configuration. The input parsers and the model throw it
+// where they used to exit(); drivers that run many configurations catch it
+// per configuration, and main() reports it and exits with status.
+class cacti_error
+{
+  public:
+    string msg;
+    int    status;  // exit status of a single run
+
+    cacti_error(const string & m, int s = 0) : msg(m), status(s) { }
+};
+
+
 class powerComponents
 {
   public:
@@ -107,6 +121,17 @@ enum Wire_type
 
 
 
+// absolute budgets from <constraints>, 0 = no bound
+typedef struct{
+  double access_time;  // s
+  double cycle_time;   // s
+  double area;         // um^2
+  double read_energy;  // J, dynamic read energy per access
+  double leakage;      // W
+} hard_constraints;
+
+
+
 enum SRAMcell_type // Alireza
 {
     std_6T, // standard 6T SRAM cell
@@ -156,11 +181,23 @@ class SRAMCellParameters // Alireza2
 
 
 
+enum Access_mode
+{
+  Access_normal,
+  Access_sequential,
+  Access_fast,
+  Access_modes
+};
+
+
+
 class InputParameter
 {
   public:
     void parse_cfg(const string & infile);
+    void parse_sram_cell(const string & sram_cell_file);
     bool error_checking();  // return false if the input parameters are problematic
+    void set_access_mode(unsigned int mode);  // fast_access, is_seq_acc and data_assoc of mode
     void display_ip();
 
     bool is_finfet;  // Alireza: False -> CMOS transistors, True -> FinFET transistors.
@@ -176,6 +213,7 @@ class InputParameter
     bool     specific_tag;
     unsigned int tag_w;
     unsigned int access_mode;
+    bool     all_access_modes;  // <access_mode>all: solve_access_modes(), reported as normal
     unsigned int obj_func_dyn_energy;
     unsigned int obj_func_dyn_power;
     unsigned int obj_func_leak_power;
@@ -248,8 +286,74 @@ class InputParameter
     char tag_array_cell_tech_file[1000];
     char tag_array_peri_tech_file[1000];
     // ------------ MAJID END -------------------
+    char sram_cell_conf_file[1000];  // last file given to parse_sram_cell()
 
     bool     add_ecc_b_;
+
+    // process-variation (Monte Carlo) analysis, see montecarlo.cc
+    unsigned int mc_samples;     // 0 disables it
+    double   mc_sigma_vth;       // V
+    double   mc_fin_loss_prob;   // per fin, FinFET only
+    double   mc_alpha;           // alpha-power law exponent
+    unsigned int mc_seed;
+
+    // temperature sweep of the chosen organization, see tempsweep.cc
+    unsigned int tsweep_start, tsweep_stop, tsweep_step;  // step 0 disables it
+    bool     tsweep_reoptimize;  // also re-run solve() at every point
+
+    // supply voltage sweep of the chosen organization, see voltsweep.cc
+    double   vdd_override;       // V, 0 keeps the Vdd of the device files
+    double   vsweep_start, vsweep_stop;
+    unsigned int vsweep_points;  // 0 disables it
+    char     vsweep_out_file[1000];  // optional CSV copy of the curves
+
+    // technology node sweep with a full solve per node, see techsweep.cc
+    double   nsweep_start, nsweep_stop;  // nm
+    unsigned int nsweep_points;  // 0 disables it
+    bool     nsweep_warm_start;  // search near the partitions of the previous node
+    unsigned int nsweep_radius;  // octaves around them
+    char     nsweep_out_file[1000];  // optional CSV copy of the table
+
+    // device and wire sensitivities of the chosen organization, see sensitivity.cc
+    bool     sens_enabled;
+    double   sens_step;          // relative perturbation
+    char     sens_out_file[1000];  // optional CSV copy of the table
+
+    // columnar dump of every candidate of the array passes and of the
+    // combinations, see dump.h
+    bool     dump_enabled;
+    char     dump_out_file[1000];
+
+    // absolute budgets for the whole cache and for every tag/data array
+    hard_constraints cache_limit;
+    hard_constraints array_limit;
+
+    // report all non-dominated organizations, see pareto.cc
+    bool     pareto_frontier;
+    char     pareto_out_file[1000];  // optional CSV copy of the frontier
+
+    // partition search engine, see search.h
+    int      search_engine;      // Search_engine
+    bool     search_extended;    // non-power-of-two Ndwl/Ndbl, finer Nspd
+    unsigned int search_chains;
+    unsigned int search_max_evals;  // per array, 0 = no limit
+    double   search_time_limit;  // s per array, 0 = no limit
+    unsigned int search_seed;
+    bool     search_compare;     // also compare with the exhaustive sweep
+
+    // workload energy over a binary access trace, see trace.h
+    char     trace_file[1000];   // empty disables it
+    double   trace_time_unit;    // s per trace timestamp tick
+
+    // bank-conflict simulation, see banksim.h
+    int      bsim_stream;        // Bank_sim_stream
+    unsigned int bsim_requests;  // synthetic stream length
+    double   bsim_rate;          // synthetic requests per s
+    bool     bsim_sequential;    // sequential instead of random blocks
+    double   bsim_write_fraction;
+    unsigned int bsim_seed;
+    double   bsim_wt;            // selection weight of the mean loaded latency, 0 = report only
+    unsigned int bsim_shortlist; // organizations re-ranked with it
 };
 
 
@@ -371,6 +475,12 @@ class uca_org_t
     void find_energy();
     void find_area();
     void find_cyc();
+
+    // the same, for a tag/data pair that is not (yet) tag_array2/data_array2
+    void find_delay(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr);
+    void find_energy(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr);
+    void find_area(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr);
+    void find_cyc(const mem_array_metrics * tag_arr, const mem_array_metrics * data_arr);
 };
 
 
@@ -434,7 +544,11 @@ uca_org_t cacti_interface(
     int p_input); 
 
 
-class mem_array
+// The part of an array organization that solve() ranks candidates on:
+// what the uca_org_t::find_*() functions and the filters read. The
+// candidate lists hold only this; the full mem_array breakdown is computed
+// once more for the organization that is picked.
+class mem_array_metrics
 {
   public:
   int    Ndwl;
@@ -445,8 +559,6 @@ class mem_array
   int    Ndsam_lev_2;
   double access_time;
   double cycle_time;
-  double multisubbank_interleave_cycle_time;
-  double area_ram_cells;
   double area;
   powerDef power;
   double delay_senseamp_mux_decoder;
@@ -455,6 +567,20 @@ class mem_array
   double height;
   double width;
 
+  min_values_t *arr_min;
+  enum Wire_type wt;
+
+  static bool lt(const mem_array_metrics * m1, const mem_array_metrics * m2);
+};
+
+
+class mem_array : public mem_array_metrics
+{
+  public:
+  double multisubbank_interleave_cycle_time;
+  int    number_subbanks;
+  double area_ram_cells;
+
   double mat_height;
   double mat_length;
   double subarray_length;
@@ -500,9 +626,6 @@ class mem_array
   powerDef power_decoder;  //Francesco: save the value of the power of the decoder to do the assignment in ucache.cc
   powerDef power_wordline; //Francesco: save the value of the power of the wordline to do the assignment in ucache.cc
 
-  min_values_t *arr_min;
-  enum Wire_type wt;
-
   // dram stats
   double activate_energy, read_energy, write_energy, precharge_energy, 
   refresh_power, leak_power_subbank_closed_page, leak_power_subbank_open_page,
@@ -518,8 +641,6 @@ class mem_array
   // Pleak_mem_array = num_rows * num_cols * num_subarrays_per_mat * Pleak_sram_cell.
   int subarray_num_rows, subarray_num_cols, num_subarrays_per_mat;
   // Alireza - End
-
-  static bool lt(const mem_array * m1, const mem_array * m2);
 };
 
 
@@ -122,11 +122,11 @@ double Component::compute_gate_area(
     double W_min = 2 * dt->H_fin;
     int N_fin_pmos = (int) (ceil(w_pmos / W_min));
     int N_fin_max_pmos = (int) (floor(w_folded_pmos / dt->P_fin)); // + 1;
-    if ( N_fin_max_pmos == 0 ) { cout << "ERROR: divide by zero in compute_gate_area function!\n"; exit(0); }
+    if ( N_fin_max_pmos == 0 ) throw cacti_error("divide by zero in compute_gate_area function!");
     num_folded_pmos = (int) (ceil((double)N_fin_pmos / N_fin_max_pmos));
     int N_fin_nmos = (int) (ceil(w_nmos / W_min));
     int N_fin_max_nmos = (int) (floor(w_folded_nmos / dt->P_fin)); // + 1;
-    if ( N_fin_max_nmos == 0 ) { cout << "ERROR: divide by zero in compute_gate_area function!\n"; exit(0); }
+    if ( N_fin_max_nmos == 0 ) throw cacti_error("divide by zero in compute_gate_area function!");
     num_folded_nmos = (int) (ceil((double)N_fin_nmos / N_fin_max_nmos));
   } else {
     num_folded_pmos = (int) (ceil(w_pmos / w_folded_pmos));
@@ -151,8 +151,7 @@ double Component::compute_gate_area(
       total_pdiff_w = compute_diffusion_width(1, num_inputs * num_folded_pmos);
       break;
     default:
-      cout << "Unknown gate type: " << gate_type << endl;
-      exit(1);
+      throw cacti_error("Unknown gate type", 1);
   }
 
   gate.w = MAX(total_ndiff_w, total_pdiff_w);
@@ -203,7 +202,7 @@ double Component::compute_tr_width_after_folding(
     double W_min = 2 * dt->H_fin;
     int N_fin = (int) (ceil(input_width / W_min));
     int N_fin_max = (int) (floor(threshold_folding_width / dt->P_fin)); // + 1;
-	 if ( N_fin_max == 0 ) { cout << "ERROR: divide by zero in compute_tr_width_after_folding function!\n"; exit(0); }
+	 if ( N_fin_max == 0 ) throw cacti_error("divide by zero in compute_tr_width_after_folding function!");
 	 num_folded_tr = (int) (ceil((double)N_fin / N_fin_max));
   } else {
     num_folded_tr = (int) (ceil(input_width / threshold_folding_width));
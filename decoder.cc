@@ -41,6 +41,7 @@
 
 #include "area.h"
 #include "decoder.h"
+#include "sram_cell.h"
 #include "parameter.h"
 #include <iostream>
 #include <math.h>
@@ -115,6 +116,7 @@ Decoder::Decoder(
 
 
 
+template <class Cell>
 void Decoder::compute_widths()
 {
   double F, g;
@@ -142,7 +144,7 @@ void Decoder::compute_widths()
       g = gnand3;
     }
     
-    if (g_ip->sram_cell_design.getType()==std_8T && is_wl_tr) { // Alireza: this 'if-else', and the body of 'if' was added by me! 
+    if (Cell::rd_wordline && !Cell::rwl_inv_demux && is_wl_tr) { // Alireza: this 'if-else', and the body of 'if' was added by me! 
       // row decoder for 8T SRAM cell has a DEMUX + WWL and RWL drivers
       w_nand_n = w_dec_n[0];
       w_nand_p = w_dec_p[0];
@@ -183,7 +185,7 @@ void Decoder::compute_widths()
           is_wl_tr,
           g_tp.max_w_nmos_dec);
       w_dec_n_rd[0] = w_nand_n; w_dec_p_rd[0] = w_nand_p; // returning the first gate to NAND gate for predecode calculation
-    } else if (g_ip->sram_cell_design.getType()==std_10T && is_wl_tr){ //Francesco: this part of if-else was added by me
+    } else if (Cell::rd_wordline && Cell::rwl_inv_demux && is_wl_tr){ //Francesco: this part of if-else was added by me
       // row decoder for 10T SRAM cell has a DEMUX + WWL and RWL drivers
       w_nand_n = w_dec_n[0];
       w_nand_p = w_dec_p[0];
@@ -247,6 +249,7 @@ void Decoder::compute_widths()
 
 
 
+template <class Cell>
 void Decoder::compute_area()
 {
   double cumulative_area = 0;
@@ -275,7 +278,7 @@ void Decoder::compute_area()
     }
     
     // Alireza: add area and leakage current of the DEMUX (i.e., one NOR2 gate), and RWL driver
-    if (g_ip->sram_cell_design.getType()==std_8T && is_wl_tr) {
+    if (Cell::rd_wordline && !Cell::rwl_inv_demux && is_wl_tr) {
       double p_to_n_sz_ratio = pmos_to_nmos_sz_ratio(is_dram, is_wl_tr);
       double w_nor_n = g_tp.min_w_nmos_;
       double w_nor_p = 2 * p_to_n_sz_ratio * g_tp.min_w_nmos_;
@@ -285,7 +288,7 @@ void Decoder::compute_area()
         cumulative_area += compute_gate_area(INV, 1, w_dec_p_rd[i], w_dec_n_rd[i], area.h);
         cumulative_curr += cmos_Ileak(w_dec_n_rd[i], w_dec_p_rd[i], is_dram) * INV_LEAK_STACK_FACTOR;
       }
-    } else if (g_ip->sram_cell_design.getType()==std_10T && is_wl_tr) {
+    } else if (Cell::rd_wordline && Cell::rwl_inv_demux && is_wl_tr) {
       double p_to_n_sz_ratio = pmos_to_nmos_sz_ratio(is_dram, is_wl_tr);
       double w_nor_n = g_tp.min_w_nmos_;
       double w_nor_p = 2 * p_to_n_sz_ratio * g_tp.min_w_nmos_;
@@ -308,6 +311,7 @@ void Decoder::compute_area()
 }
 
 
+template <class Cell>
 double Decoder::compute_delays(double inrisetime)
 {
   if (exist)
@@ -341,11 +345,11 @@ double Decoder::compute_delays(double inrisetime)
     c_intrinsic = drain_C_(w_dec_p[0], PCH, 1, 1, area.h, is_dram, false, is_wl_tr) * num_in_signals + 
                   drain_C_(w_dec_n[0], NCH, num_in_signals, 1, area.h, is_dram, false, is_wl_tr);
     //Alireza & Francesco
-    if (g_ip->sram_cell_design.getType()==std_8T && is_wl_tr) {
+    if (Cell::rd_wordline && !Cell::rwl_inv_demux && is_wl_tr) {
       // Alireza: for this case, load of the decoder is the DEMUX (a NOR gate)
       c_load = gate_C(w_nor_n + w_nor_p, 0.0, is_dram, false, is_wl_tr); // Alireza
       tf = rd * (c_intrinsic + 2*c_load);
-    } else if (g_ip->sram_cell_design.getType()==std_10T && is_wl_tr){ //Francesco
+    } else if (Cell::rd_wordline && Cell::rwl_inv_demux && is_wl_tr){ //Francesco
       //the load capacitance is given by a nor and an inverter because, in the 10T SRAM cell, we consider in the demux an inverter
       //before the RWL driver
       c_load = gate_C(w_nor_n + w_nor_p, 0.0, is_dram, false, is_wl_tr) + gate_C(w_dec_n_rd[1] + w_dec_p_rd[1], 0.0, is_dram, false, is_wl_tr);
@@ -357,7 +361,7 @@ double Decoder::compute_delays(double inrisetime)
     this_delay = horowitz(inrisetime, tf, 0.5, 0.5, RISE);
     delay += this_delay;
     inrisetime = this_delay / (1.0 - 0.5);  
-    if ((g_ip->sram_cell_design.getType()==std_8T || g_ip->sram_cell_design.getType()==std_10T) && is_wl_tr) { // Alireza & Francesco
+    if (Cell::rd_wordline && is_wl_tr) { // Alireza & Francesco
       power.readOp.dynamic += (c_load + c_intrinsic) * Vdd * Vdd; // Alireza
       power.writeOp.dynamic += power.readOp.dynamic; // Alireza
       delay_rd += delay; // Alireza
@@ -370,7 +374,7 @@ double Decoder::compute_delays(double inrisetime)
     } // Alireza
     
     // Alireza: add delay of DEMUX (one NOR2 gate)
-    if ((g_ip->sram_cell_design.getType()==std_8T || g_ip->sram_cell_design.getType()==std_10T) && is_wl_tr) { // Alireza: this 'if' is added by me!
+    if (Cell::rd_wordline && is_wl_tr) { // Alireza: this 'if' is added by me!
       rd = tr_R_on(w_nor_n, NCH, 2, is_dram, false, is_wl_tr);
       c_intrinsic = drain_C_(w_nor_p, PCH, 2, 1, area.h, is_dram, false, is_wl_tr) + 
                     drain_C_(w_nor_n, NCH, 1, 1, area.h, is_dram, false, is_wl_tr) * 2;
@@ -379,7 +383,7 @@ double Decoder::compute_delays(double inrisetime)
       this_delay = horowitz(inrisetime, tf, 0.5, 0.5, RISE);
       delay += this_delay;
       inrisetime = this_delay / (1.0 - 0.5);
-      if (g_ip->sram_cell_design.getType()==std_10T) { //Francesco
+      if (Cell::rwl_on_write) { //Francesco
         power.writeOp.dynamic += (c_load + c_intrinsic) * Vdd * Vdd;
         //add the nor power consumption to that of the decoder because we consider the demux part of the decoder
         power_decoder.readOp.dynamic += (c_load + c_intrinsic) * Vdd * Vdd; //Francesco
@@ -407,10 +411,10 @@ double Decoder::compute_delays(double inrisetime)
       this_delay = horowitz(inrisetime, tf, 0.5, 0.5, RISE);
       delay += this_delay;
       inrisetime = this_delay / (1.0 - 0.5);
-      if ((g_ip->sram_cell_design.getType()==std_8T || g_ip->sram_cell_design.getType()==std_10T) && is_wl_tr) { // Alireza & Francesco
+      if (Cell::rd_wordline && is_wl_tr) { // Alireza & Francesco
         power.writeOp.dynamic += (c_load + c_intrinsic) * Vdd * Vdd; // Alireza
         power_wordline.writeOp.dynamic += (c_load + c_intrinsic) * Vdd * Vdd; //Francesco
-        if (g_ip->sram_cell_design.getType()==std_10T) { //Francesco
+        if (Cell::rwl_on_write) { //Francesco
           //add the power consumption of the RWL driver to that of the WWL driver because, in 10T SRAM cell,
           //the access transistor connected to the RWL is active during the writing operation, so the RWL is active and must be considered
           c_load = gate_C(w_dec_p_rd[i+1] + w_dec_n_rd[i+1], 0.0, is_dram, false, is_wl_tr);
@@ -435,10 +439,10 @@ double Decoder::compute_delays(double inrisetime)
     this_delay = horowitz(inrisetime, tf, 0.5, 0.5, RISE);
     delay  += this_delay;
     ret_val = this_delay / (1.0 - 0.5);
-    if ((g_ip->sram_cell_design.getType()==std_8T || g_ip->sram_cell_design.getType()==std_10T) && is_wl_tr) { // Alireza & Francesco
+    if (Cell::rd_wordline && is_wl_tr) { // Alireza & Francesco
       power.writeOp.dynamic += c_load * Vpp * Vpp + c_intrinsic * Vdd * Vdd; // Alireza
       power_wordline.writeOp.dynamic += c_load * Vpp * Vpp + c_intrinsic * Vdd * Vdd; //Francesco
-      if (g_ip->sram_cell_design.getType()==std_10T) { //Francesco
+      if (Cell::rwl_on_write) { //Francesco
         //add the power consumption of the RWL final inverter to that of the WWL driver because, in 10T SRAM cell,
         //the access transistor connected to the RWL is active during the writing operation, so the RWL is active and must be considered
         i = num_gates_rd - 1;
@@ -455,9 +459,9 @@ double Decoder::compute_delays(double inrisetime)
     
     
     // Alireza: add delay of RWL driver
-    if ((g_ip->sram_cell_design.getType()==std_8T || g_ip->sram_cell_design.getType()==std_10T) && is_wl_tr) { // Alireza (& Francesco): this 'if' is added by me!
+    if (Cell::rd_wordline && is_wl_tr) { // Alireza (& Francesco): this 'if' is added by me!
       // add delay of DEMUX (one NOR2 gate)
-      if (g_ip->sram_cell_design.getType()==std_8T) {
+      if (!Cell::rwl_inv_demux) {
       rd = tr_R_on(w_nor_n, NCH, 2, is_dram, false, is_wl_tr);
       c_load = gate_C(w_dec_n_rd[1] + w_dec_p_rd[1], 0.0, is_dram, false, is_wl_tr);
       c_intrinsic = drain_C_(w_nor_p, PCH, 2, 1, area.h, is_dram, false, is_wl_tr) + 
@@ -524,6 +528,27 @@ double Decoder::compute_delays(double inrisetime)
 
 
 
+void Decoder::compute_widths()
+{
+  SRAM_CELL_DISPATCH(this, compute_widths, ());
+}
+
+
+
+void Decoder::compute_area()
+{
+  SRAM_CELL_DISPATCH(this, compute_area, ());
+}
+
+
+
+double Decoder::compute_delays(double inrisetime)
+{
+  SRAM_CELL_DISPATCH(this, compute_delays, (inrisetime));
+}
+
+
+
 PredecBlk::PredecBlk(
     int    num_dec_signals,
     Decoder * dec_,
@@ -89,6 +89,12 @@ class Decoder : public Component
     void   compute_widths();
     void   compute_area();
     double compute_delays(double inrisetime);  // return outrisetime
+
+  private:
+    // cell-type instances of the above, see sram_cell.h
+    template <class Cell> void   compute_widths();
+    template <class Cell> void   compute_area();
+    template <class Cell> double compute_delays(double inrisetime);
 };
 
 
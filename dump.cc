@@ -0,0 +1,493 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "dump.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+static const char dump_magic[8] = {'C', 'A', 'C', 'T', 'I', 'D', '0', '1'};
+
+enum Dump_codec
+{
+  Codec_varint = 0,  // non-negative integers
+  Codec_xor    = 1   // doubles, see dump.h
+};
+
+struct dump_column
+{
+  const char * name;
+  int          codec;
+};
+
+static const dump_column array_columns[] =
+{
+  { "Ndwl", Codec_varint }, { "Ndbl", Codec_varint }, { "Nspd", Codec_xor },
+  { "Ndcm", Codec_varint }, { "Ndsam1", Codec_varint }, { "Ndsam2", Codec_varint },
+  { "wt", Codec_varint },
+  { "access_ns", Codec_xor }, { "cycle_ns", Codec_xor }, { "area_mm2", Codec_xor },
+  { "read_nJ", Codec_xor }, { "write_nJ", Codec_xor }, { "leakage_mW", Codec_xor },
+  { "height_um", Codec_xor }, { "width_um", Codec_xor }
+};
+
+static const dump_column combined_columns[] =
+{
+  { "data_Ndwl", Codec_varint }, { "data_Ndbl", Codec_varint }, { "data_Nspd", Codec_xor },
+  { "data_Ndcm", Codec_varint }, { "data_Ndsam1", Codec_varint }, { "data_Ndsam2", Codec_varint },
+  { "data_wt", Codec_varint },
+  { "tag_Ndwl", Codec_varint }, { "tag_Ndbl", Codec_varint }, { "tag_Nspd", Codec_xor },
+  { "tag_Ndcm", Codec_varint }, { "tag_Ndsam1", Codec_varint }, { "tag_Ndsam2", Codec_varint },
+  { "tag_wt", Codec_varint },
+  { "access_ns", Codec_xor }, { "cycle_ns", Codec_xor }, { "area_mm2", Codec_xor },
+  { "read_nJ", Codec_xor }, { "write_nJ", Codec_xor }, { "leakage_mW", Codec_xor },
+  { "cost", Codec_xor }
+};
+
+static const uint32_t n_array_columns    = sizeof(array_columns)/sizeof(array_columns[0]);
+static const uint32_t n_combined_columns = sizeof(combined_columns)/sizeof(combined_columns[0]);
+
+static const char * const section_names[Dump_sections] = { "tag", "data", "combined" };
+
+static uint32_t dump_run = 0;
+
+
+
+template <class T> static void put(string & s, T v)
+{
+  s.append((const char *) &v, sizeof(T));
+}
+
+template <class T> static bool get(const char * & p, const char * end, T & v)
+{
+  if (end - p < (ptrdiff_t) sizeof(T)) return false;
+  memcpy(&v, p, sizeof(T));
+  p += sizeof(T);
+  return true;
+}
+
+
+
+// The encoders write to a buffer with room for the worst case (10 bytes
+// per varint, 9 per XOR value) and return the end.
+static char * put_varint(char * p, const double * v, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+  {
+    uint64_t x = (uint64_t) v[i];
+    while (x >= 0x80)
+    {
+      *p++ = (char) (x | 0x80);
+      x >>= 7;
+    }
+    *p++ = (char) x;
+  }
+  return p;
+}
+
+static char * put_xor(char * p, const double * v, uint32_t n)
+{
+  uint64_t prev = 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    uint64_t u;
+    memcpy(&u, &v[i], sizeof(u));
+    uint64_t x = u ^ prev;
+    prev = u;
+
+    int lead = 8, trail = 0;
+    if (x != 0)
+    {
+      lead  = __builtin_clzll(x) / 8;
+      trail = __builtin_ctzll(x) / 8;
+    }
+    *p++ = (char) ((lead << 4) | trail);
+    for (int b = trail; b < 8 - lead; b++) *p++ = (char) (x >> (8*b));
+  }
+  return p;
+}
+
+static bool get_varint(const char * p, const char * end, vector<double> & v)
+{
+  for (uint32_t i = 0; i < v.size(); i++)
+  {
+    uint64_t x = 0;
+    for (int shift = 0; ; shift += 7)
+    {
+      if (p == end || shift > 63) return false;
+      unsigned char c = *p++;
+      x |= (uint64_t) (c & 0x7f) << shift;
+      if ((c & 0x80) == 0) break;
+    }
+    v[i] = (double) x;
+  }
+  return p == end;
+}
+
+static bool get_xor(const char * p, const char * end, vector<double> & v)
+{
+  uint64_t prev = 0;
+  for (uint32_t i = 0; i < v.size(); i++)
+  {
+    if (p == end) return false;
+    int lead  = (unsigned char) *p >> 4;
+    int trail = *p++ & 0xf;
+    if (lead + trail > 8 || end - p < 8 - lead - trail) return false;
+
+    uint64_t x = 0;
+    for (int b = trail; b < 8 - lead; b++) x |= (uint64_t) (unsigned char) *p++ << (8*b);
+    prev ^= x;
+    memcpy(&v[i], &prev, sizeof(prev));
+  }
+  return p == end;
+}
+
+
+
+dump_block::dump_block(int section_)
+  : section(section_), rows(0),
+    columns((section_ == Dump_combined) ? n_combined_columns : n_array_columns)
+{
+}
+
+
+
+void dump_block::reserve(uint32_t n)
+{
+  for (uint32_t c = 0; c < columns.size(); c++) columns[c].reserve(n);
+}
+
+
+
+static vector<double> * add_org(vector<double> * col, const mem_array_metrics * m)
+{
+  (col++)->push_back(m ? m->Ndwl : 0);
+  (col++)->push_back(m ? m->Ndbl : 0);
+  (col++)->push_back(m ? m->Nspd : 0);
+  (col++)->push_back(m ? m->deg_bl_muxing : 0);
+  (col++)->push_back(m ? m->Ndsam_lev_1 : 0);
+  (col++)->push_back(m ? m->Ndsam_lev_2 : 0);
+  (col++)->push_back(m ? m->wt : 0);
+  return col;
+}
+
+static bool finite_power(const powerDef & p)
+{
+  return isfinite(p.readOp.dynamic) && isfinite(p.writeOp.dynamic) && isfinite(p.readOp.leakage);
+}
+
+void dump_block::add_array(const mem_array_metrics * m)
+{
+  if (!isfinite(m->access_time) || !isfinite(m->cycle_time) || !isfinite(m->area) ||
+      !finite_power(m->power) || !isfinite(m->height) || !isfinite(m->width))
+    return;
+  vector<double> * col = add_org(&columns[0], m);
+  (col++)->push_back(m->access_time*1e9);
+  (col++)->push_back(m->cycle_time*1e9);
+  (col++)->push_back(m->area*1e-6);
+  (col++)->push_back(m->power.readOp.dynamic*1e9);
+  (col++)->push_back(m->power.writeOp.dynamic*1e9);
+  (col++)->push_back(m->power.readOp.leakage*1e3);
+  (col++)->push_back(m->height);
+  (col++)->push_back(m->width);
+  rows++;
+}
+
+void dump_block::add_pair(const mem_array_metrics * tag, const mem_array_metrics * data,
+                          const uca_org_t & org, double cost)
+{
+  if (!isfinite(org.access_time) || !isfinite(org.cycle_time) || !isfinite(org.area) ||
+      !finite_power(org.power) || !isfinite(cost))
+    return;
+  vector<double> * col = add_org(&columns[0], data);
+  col = add_org(col, tag);
+  (col++)->push_back(org.access_time*1e9);
+  (col++)->push_back(org.cycle_time*1e9);
+  (col++)->push_back(org.area*1e-6);
+  (col++)->push_back(org.power.readOp.dynamic*1e9);
+  (col++)->push_back(org.power.writeOp.dynamic*1e9);
+  (col++)->push_back(org.power.readOp.leakage*1e3);
+  (col++)->push_back(cost);
+  rows++;
+}
+
+
+
+void dump_block::finish()
+{
+  const dump_column * cols = (section == Dump_combined) ? combined_columns : array_columns;
+  uint32_t ncols = columns.size();
+  vector<char> data((size_t) rows * 10 + 1);
+
+  bytes.clear();
+  put<uint32_t>(bytes, rows);
+  put<uint16_t>(bytes, ncols);
+  for (uint32_t c = 0; c < ncols; c++)
+  {
+    char * end = &data[0];
+    if (rows > 0)
+    {
+      if (cols[c].codec == Codec_varint) end = put_varint(end, &columns[c][0], rows);
+      else                               end = put_xor(end, &columns[c][0], rows);
+    }
+    put<uint8_t>(bytes, strlen(cols[c].name));
+    bytes += cols[c].name;
+    put<uint8_t>(bytes, cols[c].codec);
+    put<uint32_t>(bytes, end - &data[0]);
+    bytes.append(&data[0], end - &data[0]);
+    vector<double>().swap(columns[c]);
+  }
+}
+
+
+
+void candidate_dump_begin_run()
+{
+  dump_run++;
+}
+
+
+
+// configuration of g_ip, as it tells the blocks of a sweep apart
+static string dump_label()
+{
+  ostringstream label;
+  label << "size=" << g_ip->cache_sz << " block=" << g_ip->block_sz << " assoc=" << g_ip->assoc
+        << " banks=" << g_ip->nbanks << " mode=" << g_ip->access_mode << " node=" << g_ip->F_sz_nm
+        << "nm temp=" << g_ip->temp << "K cell=" << g_ip->sram_cell_conf_file;
+  return label.str();
+}
+
+
+
+// the dump file of g_ip, truncated on its first use by this process
+static FILE * dump_file()
+{
+  static FILE * fp = NULL;
+  static string path;
+  static set<string> opened;
+
+  if (fp != NULL && path == g_ip->dump_out_file)
+  {
+    return fp;
+  }
+  if (fp != NULL) fclose(fp);
+
+  path = g_ip->dump_out_file;
+  bool fresh = opened.insert(path).second;
+  fp = fopen(path.c_str(), fresh ? "wb" : "ab");
+  if (fp == NULL)
+  {
+    opened.erase(path);
+    throw cacti_error("cannot write candidate dump " + path);
+  }
+  if (fresh) fwrite(dump_magic, 1, sizeof(dump_magic), fp);
+  return fp;
+}
+
+
+
+void write_dump_block(const dump_block & b, uint32_t thread)
+{
+  string label = dump_label();
+  string rec;
+
+  put<uint32_t>(rec, 0);  // length, below
+  put<uint8_t>(rec, b.section);
+  put<uint32_t>(rec, dump_run);
+  put<uint32_t>(rec, thread);
+  put<uint16_t>(rec, label.size());
+  rec += label;
+  rec += b.bytes;
+  uint32_t len = rec.size() - sizeof(uint32_t);
+  memcpy(&rec[0], &len, sizeof(len));
+
+  FILE * fp = dump_file();
+  if (fwrite(rec.data(), 1, rec.size(), fp) != rec.size() || fflush(fp) != 0)
+  {
+    throw cacti_error(string("cannot write candidate dump ") + g_ip->dump_out_file);
+  }
+}
+
+
+
+void dump_array_candidates(int section, uint32_t thread, const list<mem_array_metrics *> & arr)
+{
+  if (arr.empty()) return;
+
+  dump_block b(section);
+  b.reserve(arr.size());
+  for (list<mem_array_metrics *>::const_iterator it = arr.begin(); it != arr.end(); ++it)
+  {
+    b.add_array(*it);
+  }
+  b.finish();
+  write_dump_block(b, thread);
+}
+
+
+
+static bool parse_block(const string & rec, dump_table & t)
+{
+  const char * p   = rec.data();
+  const char * end = p + rec.size();
+  uint8_t  section, name_len, codec;
+  uint16_t label_len, ncols;
+
+  if (!get(p, end, section) || section >= Dump_sections || !get(p, end, t.run) ||
+      !get(p, end, t.thread) || !get(p, end, label_len) || end - p < label_len)
+  {
+    return false;
+  }
+  t.section = section;
+  t.label.assign(p, label_len);
+  p += label_len;
+  if (!get(p, end, t.rows) || !get(p, end, ncols))
+  {
+    return false;
+  }
+
+  t.names.resize(ncols);
+  t.columns.assign(ncols, vector<double>(t.rows));
+  for (uint32_t c = 0; c < ncols; c++)
+  {
+    uint32_t len;
+    if (!get(p, end, name_len) || end - p < name_len) return false;
+    t.names[c].assign(p, name_len);
+    p += name_len;
+    if (!get(p, end, codec) || !get(p, end, len) || end - p < (ptrdiff_t) len) return false;
+
+    bool ok = (codec == Codec_varint) ? get_varint(p, p + len, t.columns[c]) :
+              (codec == Codec_xor)    ? get_xor(p, p + len, t.columns[c]) : false;
+    if (!ok) return false;
+    p += len;
+  }
+  return p == end;
+}
+
+
+
+bool read_candidate_dump(const string & file, vector<dump_table> & tables)
+{
+  ifstream in(file.c_str(), ios::binary);
+  char magic[sizeof(dump_magic)];
+
+  if (!in.read(magic, sizeof(magic)) || memcmp(magic, dump_magic, sizeof(magic)) != 0)
+  {
+    return false;
+  }
+
+  uint32_t len;
+  while (in.read((char *) &len, sizeof(len)))
+  {
+    string rec(len, '\0');
+    dump_table t;
+    if (!in.read(&rec[0], len) || !parse_block(rec, t))
+    {
+      return false;
+    }
+    tables.push_back(t);
+  }
+  return in.gcount() == 0;
+}
+
+
+
+int dump_to_csv(const string & file)
+{
+  vector<dump_table> tables;
+  bool complete = read_candidate_dump(file, tables);
+
+  if (!complete && tables.empty())
+  {
+    cout << "ERROR: " << file << " is not a candidate dump" << endl;
+    return 1;
+  }
+  if (!complete)
+  {
+    cout << "WARNING: " << file << " ends in a truncated block, converting the "
+         << tables.size() << " blocks before it" << endl;
+  }
+
+  for (int s = 0; s < Dump_sections; s++)
+  {
+    string out_file = file + "." + section_names[s] + ".csv";
+    ofstream csv(out_file.c_str());
+    uint64_t rows = 0;
+    bool header = false;
+
+    if (!csv)
+    {
+      cout << "ERROR: cannot open " << out_file << " for writing" << endl;
+      return 1;
+    }
+    csv.precision(10);
+    for (uint32_t i = 0; i < tables.size(); i++)
+    {
+      const dump_table & t = tables[i];
+      if (t.section != s) continue;
+      if (!header)
+      {
+        csv << "run,config";
+        for (uint32_t c = 0; c < t.names.size(); c++) csv << "," << t.names[c];
+        csv << endl;
+        header = true;
+      }
+      for (uint32_t r = 0; r < t.rows; r++)
+      {
+        csv << t.run << ",\"" << t.label << "\"";
+        for (uint32_t c = 0; c < t.columns.size(); c++) csv << "," << t.columns[c][r];
+        csv << "\n";
+      }
+      rows += t.rows;
+    }
+    cout << rows << " " << section_names[s] << " candidates written to " << out_file << endl;
+  }
+  return !complete;
+}
@@ -0,0 +1,135 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __DUMP_H__
+#define __DUMP_H__
+
+#include <stdint.h>
+#include <list>
+#include <string>
+#include <vector>
+#include "cacti_interface.h"
+
+using namespace std;
+
+
+enum Dump_section
+{
+  Dump_tag      = 0,  // candidates of a tag array pass
+  Dump_data     = 1,  // candidates of a data array pass (and of a fully-associative tag pass)
+  Dump_combined = 2,  // tag x data combinations scored by find_optimal_uca()
+  Dump_sections
+};
+
+
+/*
+ * Columnar dump of the candidates of every solve, written while
+ * g_ip->dump_enabled is set. The file starts with an 8-byte magic, then
+ * one block per section and thread:
+ *
+ *   uint32 length | uint8 section | uint32 run | uint32 thread |
+ *   uint16 label length | label | uint32 rows | uint16 columns | columns
+ *
+ * where every column is
+ *
+ *   uint8 name length | name | uint8 codec | uint32 length | data
+ *
+ * The partition and wire type columns are varints. The metric columns
+ * store the XOR of each value with the one before it as a byte with the
+ * number of leading and trailing zero bytes, then the bytes in between;
+ * repeated and neighboring values take one to a few bytes. run counts the
+ * solves of the process and label names the configuration. The records
+ * are in host byte order. The first block a process writes to a file
+ * truncates it, all later ones (every point of a sweep) are appended.
+ */
+class dump_block
+{
+  public:
+    dump_block(int section);
+
+    void reserve(uint32_t rows);
+    // add_array and add_pair drop a row whose metrics or cost are not finite
+    // (the model leaves the access time of some Ndsam2 > 1 partitions NaN)
+    void add_array(const mem_array_metrics * m);
+    // tag is NULL for a pure RAM; cost as ranked, BIGNUM past the max deviations
+    void add_pair(const mem_array_metrics * tag, const mem_array_metrics * data,
+                  const uca_org_t & org, double cost);
+    // compresses the rows into bytes and frees them; may run on any thread
+    void finish();
+
+    int      section;
+    uint32_t rows;
+    string   bytes;
+
+  private:
+    vector<vector<double> > columns;  // until finish()
+};
+
+// the blocks written from here on belong to a new run; called by solve()
+void candidate_dump_begin_run();
+// appends a finished block, labeled with the configuration in g_ip
+void write_dump_block(const dump_block & b, uint32_t thread);
+// dumps a list of array candidates as one block (a pass restored from a
+// sweep journal; swept passes fill a dump_block per thread)
+void dump_array_candidates(int section, uint32_t thread, const list<mem_array_metrics *> & arr);
+
+
+// one block as read back
+struct dump_table
+{
+  int      section;
+  uint32_t run;
+  uint32_t thread;
+  string   label;
+  uint32_t rows;
+  vector<string> names;
+  vector<vector<double> > columns;  // columns[c][row]
+};
+
+// Reads the blocks of a dump in file order. False if file is not a dump or
+// a block is cut short (the blocks before it are kept in tables).
+bool read_candidate_dump(const string & file, vector<dump_table> & tables);
+
+// Writes <file>.tag.csv, <file>.data.csv and <file>.combined.csv, one row
+// per candidate with its run and configuration; returns nonzero on failure.
+int dump_to_csv(const string & file);
+
+#endif
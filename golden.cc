@@ -0,0 +1,569 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "golden.h"
+#include "bench.h"
+#include "const.h"
+#include "parameter.h"
+#include "Ucache.h"
+#include "search.h"
+
+using namespace std;
+
+
+struct golden_case
+{
+  const char * name;
+  bench_point  point;
+};
+
+
+// kept small enough to check in a few seconds per thread count
+static const golden_case golden_corpus[] =
+{
+  // name                     cfg_file                        sram_cell_file                          size   assoc banks nuca  cache mode  forced
+  {"cmos_10T_forced",        {"xmls/cache_config_cmos.xml",   NULL,                                        0, 0, 0, false, -1, -1, true }},
+  {"cmos_6T_64K_ram",        {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_6T.xml",      65536, 1, 1, false, -1, -1, false}},
+  {"cmos_8T_64K_cache",      {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_8T.xml",      65536, 2, 1, false,  1,  0, false}},
+  {"cmos_10T_64K_cache",     {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_10T.xml",     65536, 4, 1, false,  1,  0, false}},
+  {"finfet_6T1_4M_ram",      {"xmls/cache_config_finfet.xml", NULL,                                        0, 0, 0, false, -1, -1, false}},
+  {"finfet_6T3_256K_seq",    {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T3.xml",  262144, 4, 1, false,  1,  1, false}},
+  {"finfet_6T4_256K_fast",   {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T4.xml",  262144, 4, 1, false,  1,  2, false}},
+  {"finfet_6T2_1M_2banks",   {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T2.xml", 1048576, 2, 2, false,  1,  0, false}},
+  {"cmos_6T_16K_fa",         {"xmls/cache_config_cmos.xml",   "xmls/sram_cells/cmos_sram_6T.xml",      16384, 0, 1, false,  1,  0, false}},
+  {"finfet_6T1_2M_nuca",     {"xmls/cache_config_finfet.xml", "xmls/sram_cells/finfet_sram_6T1.xml", 2097152, 8, 4, true ,  1,  0, false}},
+};
+
+
+
+struct golden_field
+{
+  string name;
+  double value;
+  bool   exact;  // organization parameters must match exactly
+};
+
+
+
+static void add_field(vector<golden_field> & f, const string & name, double value, bool exact = false)
+{
+  golden_field g;
+  g.name  = name;
+  g.value = value;
+  g.exact = exact;
+  f.push_back(g);
+}
+
+
+
+static void add_power(vector<golden_field> & f, const string & name, const powerDef & p)
+{
+  add_field(f, name + ".read_dynamic",  p.readOp.dynamic);
+  add_field(f, name + ".read_leakage",  p.readOp.leakage);
+  add_field(f, name + ".write_dynamic", p.writeOp.dynamic);
+  add_field(f, name + ".write_leakage", p.writeOp.leakage);
+}
+
+
+
+static void add_mem_array(vector<golden_field> & f, const string & n, const mem_array * m)
+{
+  if (m == NULL)
+  {
+    return;
+  }
+  add_field(f, n + ".Ndwl", m->Ndwl, true);
+  add_field(f, n + ".Ndbl", m->Ndbl, true);
+  add_field(f, n + ".Nspd", m->Nspd, true);
+  add_field(f, n + ".deg_bl_muxing", m->deg_bl_muxing, true);
+  add_field(f, n + ".Ndsam_lev_1", m->Ndsam_lev_1, true);
+  add_field(f, n + ".Ndsam_lev_2", m->Ndsam_lev_2, true);
+  add_field(f, n + ".wt", m->wt, true);
+  add_field(f, n + ".subarray_num_rows", m->subarray_num_rows, true);
+  add_field(f, n + ".subarray_num_cols", m->subarray_num_cols, true);
+  add_field(f, n + ".num_subarrays_per_mat", m->num_subarrays_per_mat, true);
+  add_field(f, n + ".access_time", m->access_time);
+  add_field(f, n + ".cycle_time", m->cycle_time);
+  add_field(f, n + ".multisubbank_interleave_cycle_time", m->multisubbank_interleave_cycle_time);
+  add_field(f, n + ".area", m->area);
+  add_field(f, n + ".area_ram_cells", m->area_ram_cells);
+  add_field(f, n + ".area_efficiency", m->area_efficiency);
+  add_field(f, n + ".height", m->height);
+  add_field(f, n + ".width", m->width);
+  add_field(f, n + ".mat_height", m->mat_height);
+  add_field(f, n + ".mat_length", m->mat_length);
+  add_field(f, n + ".subarray_height", m->subarray_height);
+  add_field(f, n + ".subarray_length", m->subarray_length);
+  add_field(f, n + ".delay_route_to_bank", m->delay_route_to_bank);
+  add_field(f, n + ".delay_input_htree", m->delay_input_htree);
+  add_field(f, n + ".delay_row_predecode_driver_and_block", m->delay_row_predecode_driver_and_block);
+  add_field(f, n + ".row_decoder_writing_delay", m->row_decoder_writing_delay);
+  add_field(f, n + ".row_decoder_reading_delay", m->row_decoder_reading_delay);
+  add_field(f, n + ".delay_bitlines", m->delay_bitlines);
+  add_field(f, n + ".delay_sense_amp", m->delay_sense_amp);
+  add_field(f, n + ".delay_subarray_output_driver", m->delay_subarray_output_driver);
+  add_field(f, n + ".delay_dout_htree", m->delay_dout_htree);
+  add_field(f, n + ".delay_comparator", m->delay_comparator);
+  add_field(f, n + ".delay_senseamp_mux_decoder", m->delay_senseamp_mux_decoder);
+  add_field(f, n + ".delay_before_subarray_output_driver", m->delay_before_subarray_output_driver);
+  add_field(f, n + ".delay_from_subarray_output_driver_to_output", m->delay_from_subarray_output_driver_to_output);
+  add_field(f, n + ".precharge_delay", m->precharge_delay);
+  add_power(f, n + ".power", m->power);
+  add_power(f, n + ".power_routing_to_bank", m->power_routing_to_bank);
+  add_power(f, n + ".power_addr_input_htree", m->power_addr_input_htree);
+  add_power(f, n + ".power_data_input_htree", m->power_data_input_htree);
+  add_power(f, n + ".power_data_output_htree", m->power_data_output_htree);
+  add_power(f, n + ".power_row_predecoder_drivers", m->power_row_predecoder_drivers);
+  add_power(f, n + ".power_row_predecoder_blocks", m->power_row_predecoder_blocks);
+  add_power(f, n + ".power_row_decoders", m->power_row_decoders);
+  add_power(f, n + ".power_bit_mux_decoders", m->power_bit_mux_decoders);
+  add_power(f, n + ".power_senseamp_mux_lev_1_decoders", m->power_senseamp_mux_lev_1_decoders);
+  add_power(f, n + ".power_senseamp_mux_lev_2_decoders", m->power_senseamp_mux_lev_2_decoders);
+  add_power(f, n + ".power_bitlines", m->power_bitlines);
+  add_power(f, n + ".power_sense_amps", m->power_sense_amps);
+  add_power(f, n + ".power_prechg_eq_drivers", m->power_prechg_eq_drivers);
+  add_power(f, n + ".power_output_drivers_at_subarray", m->power_output_drivers_at_subarray);
+  add_power(f, n + ".power_comparators", m->power_comparators);
+  add_power(f, n + ".power_decoder", m->power_decoder);
+  add_power(f, n + ".power_wordline", m->power_wordline);
+  add_field(f, n + ".activate_energy", m->activate_energy);
+  add_field(f, n + ".read_energy", m->read_energy);
+  add_field(f, n + ".write_energy", m->write_energy);
+  add_field(f, n + ".precharge_energy", m->precharge_energy);
+  add_field(f, n + ".refresh_power", m->refresh_power);
+  add_field(f, n + ".leak_power_subbank_closed_page", m->leak_power_subbank_closed_page);
+  add_field(f, n + ".leak_power_subbank_open_page", m->leak_power_subbank_open_page);
+  add_field(f, n + ".leak_power_request_and_reply_networks", m->leak_power_request_and_reply_networks);
+  add_field(f, n + ".leak_power_bank", m->leak_power_bank);
+  add_field(f, n + ".leak_power_mat", m->leak_power_mat);
+  add_field(f, n + ".leak_power_sram_cell", m->leak_power_sram_cell);
+  add_field(f, n + ".leak_power_mem_array", m->leak_power_mem_array);
+}
+
+
+
+static void golden_fields(const uca_org_t & r, vector<golden_field> & f)
+{
+  add_field(f, "uca.access_time", r.access_time);
+  add_field(f, "uca.cycle_time", r.cycle_time);
+  add_field(f, "uca.area", r.area);
+  add_field(f, "uca.area_efficiency", r.area_efficiency);
+  add_field(f, "uca.cache_ht", r.cache_ht);
+  add_field(f, "uca.cache_len", r.cache_len);
+  add_power(f, "uca.power", r.power);
+  add_mem_array(f, "tag", r.tag_array2);
+  add_mem_array(f, "data", r.data_array2);
+}
+
+
+
+// child side: solve one case and dump its fields; never returns
+static void golden_child(const golden_case & gc, uint32_t threads, const string & out_file)
+{
+  int null_fd = open("/dev/null", O_WRONLY);
+  dup2(null_fd, STDOUT_FILENO);  // keep the sim_nuca() statistics out of the report
+  dup2(null_fd, STDERR_FILENO);  // and the sim_nuca() separators
+  close(null_fd);
+
+  if (threads != 0)
+  {
+    nthreads = threads;
+  }
+  uca_org_t fin_res;
+  load_bench_point(gc.point);
+  solve_bench_point(gc.point, &fin_res);
+
+  vector<golden_field> f;
+  golden_fields(fin_res, f);
+  if (gc.point.nuca)
+  {
+    add_field(f, "nuca.bank_size", g_ip->cache_sz, true);  // sim_nuca()'s choice of bank count
+  }
+
+  FILE * fp = fopen(out_file.c_str(), "w");
+  if (fp == NULL)
+  {
+    _exit(2);
+  }
+  fprintf(fp, "# %s\n", gc.name);
+  for (uint32_t i = 0; i < f.size(); i++)
+  {
+    fprintf(fp, "%s %s%.17g\n", f[i].name.c_str(), f[i].exact ? "=" : "", f[i].value);
+  }
+  fclose(fp);
+  _exit(0);
+}
+
+
+
+// child side of a search case: solves the case exhaustively and with the
+// heuristic engine and writes the org_cost() of the latter's pick relative
+// to the former's, both against the minima of the exhaustive selection;
+// never returns
+static void search_child(const golden_case & gc, int engine, const string & out_file)
+{
+  int null_fd = open("/dev/null", O_WRONLY);
+  dup2(null_fd, STDOUT_FILENO);
+  dup2(null_fd, STDERR_FILENO);
+  close(null_fd);
+
+  uca_org_t org[2];
+  load_bench_point(gc.point);
+  g_ip->search_engine = Search_exhaustive;
+  uint64_t n0 = solve_partitions_evaluated;
+  solve_bench_point(gc.point, &org[0]);
+  min_values_t min = solve_selection_min;
+
+  // as many objective queries as the exhaustive sweep evaluated partitions
+  g_ip->search_engine     = engine;
+  g_ip->search_max_evals  = (solve_partitions_evaluated - n0) / 2;
+  g_ip->search_time_limit = 0;
+  solve_bench_point(gc.point, &org[1]);
+
+  FILE * fp = fopen(out_file.c_str(), "w");
+  if (fp == NULL)
+  {
+    _exit(2);
+  }
+  // with all weights 0 every organization within the deviations costs 0
+  double cost_exh = org_cost(org[0], &min), cost = org_cost(org[1], &min);
+  fprintf(fp, "%.17g\n", (cost == cost_exh) ? 1 : cost / cost_exh);
+  fclose(fp);
+  _exit(0);
+}
+
+
+
+struct golden_job
+{
+  uint32_t case_idx;
+  uint32_t threads;
+  int      engine;    // Search_exhaustive for a golden case, else the engine of a search case
+  string   out_file;
+  int      status;
+};
+
+
+
+// runs the jobs as child processes, at most njobs at a time
+static void run_golden_jobs(vector<golden_job> & jobs, uint32_t njobs)
+{
+  map<pid_t, uint32_t> running;
+  uint32_t next = 0;
+
+  if (njobs == 0) njobs = 1;
+  cout.flush();
+  fflush(stdout);
+
+  while (next < jobs.size() || running.empty() == false)
+  {
+    while (next < jobs.size() && running.size() < njobs)
+    {
+      pid_t pid = fork();
+      if (pid < 0)
+      {
+        cout << "ERROR: fork failed" << endl;
+        exit(1);
+      }
+      if (pid == 0)
+      {
+        const golden_job & j = jobs[next];
+        if (j.engine == Search_exhaustive)
+        {
+          golden_child(golden_corpus[j.case_idx], j.threads, j.out_file);
+        }
+        search_child(golden_corpus[j.case_idx], j.engine, j.out_file);
+      }
+      running[pid] = next++;
+    }
+
+    int status;
+    pid_t pid = wait(&status);
+    if (pid > 0 && running.count(pid))
+    {
+      jobs[running[pid]].status = (WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+      running.erase(pid);
+    }
+  }
+}
+
+
+
+// "name value" lines; '=' in front of the value marks an exact field
+static bool load_golden_file(const string & file, vector<golden_field> & f)
+{
+  ifstream in(file.c_str());
+  string line;
+
+  if (!in)
+  {
+    return false;
+  }
+  while (getline(in, line))
+  {
+    if (line.empty() || line[0] == '#') continue;
+    istringstream ss(line);
+    string name, val;
+    ss >> name >> val;
+    bool exact = (!val.empty() && val[0] == '=');
+    add_field(f, name, strtod(val.c_str() + (exact ? 1 : 0), NULL), exact);
+  }
+  return true;
+}
+
+
+
+// prints one line per mismatching field and returns their number
+static int diff_golden(const string & label, const vector<golden_field> & ref,
+                       const vector<golden_field> & act, double rtol)
+{
+  map<string, double> act_map;
+  int ndiff = 0;
+
+  for (uint32_t i = 0; i < act.size(); i++)
+  {
+    act_map[act[i].name] = act[i].value;
+  }
+  if (ref.size() != act.size())
+  {
+    printf("  %-28s field count differs: %u expected, %u found\n", label.c_str(),
+           (uint32_t) ref.size(), (uint32_t) act.size());
+    ndiff++;
+  }
+  for (uint32_t i = 0; i < ref.size(); i++)
+  {
+    map<string, double>::iterator it = act_map.find(ref[i].name);
+    if (it == act_map.end())
+    {
+      printf("  %-28s %-52s missing\n", label.c_str(), ref[i].name.c_str());
+      ndiff++;
+      continue;
+    }
+    double a = ref[i].value, b = it->second;
+    double scale = MAX(fabs(a), fabs(b));
+    double rel = (scale > 0) ? fabs(a - b) / scale : 0;
+    bool ok = (ref[i].exact || rtol == 0) ? (a == b) : (rel <= rtol);
+    if (!ok)
+    {
+      printf("  %-28s %-52s expected %-14.8g got %-14.8g rel diff %.3g\n", label.c_str(),
+             ref[i].name.c_str(), a, b, rel);
+      ndiff++;
+    }
+  }
+  return ndiff;
+}
+
+
+
+int record_golden(const string & dir, uint32_t njobs)
+{
+  uint32_t ncases = sizeof(golden_corpus)/sizeof(golden_corpus[0]);
+  vector<golden_job> jobs;
+  int nfail = 0;
+
+  for (uint32_t c = 0; c < ncases; c++)
+  {
+    golden_job j;
+    j.case_idx = c;
+    j.threads  = 0;
+    j.engine   = Search_exhaustive;
+    j.out_file = dir + "/" + golden_corpus[c].name + ".golden";
+    j.status   = -1;
+    jobs.push_back(j);
+  }
+  run_golden_jobs(jobs, njobs);
+
+  for (uint32_t i = 0; i < jobs.size(); i++)
+  {
+    vector<golden_field> f;
+    bool ok = (jobs[i].status == 0 && load_golden_file(jobs[i].out_file, f));
+    printf("%-28s %s\n", golden_corpus[jobs[i].case_idx].name,
+           ok ? "recorded" : "FAILED (solver exited)");
+    nfail += !ok;
+  }
+  return nfail;
+}
+
+
+
+// The heuristic engines are held to the exhaustive pick on the set-associative
+// UCA cases: the organization they select may cost at most this much more.
+static const double search_tolerance = 0.05;
+
+static bool searchable(const bench_point & bp)
+{
+  return !bp.nuca && !bp.force_cache_config && !(bp.cache_sz != 0 && bp.assoc == 0);
+}
+
+
+
+int check_golden(const string & dir, uint32_t njobs, double rtol,
+                 const vector<uint32_t> & thread_counts)
+{
+  uint32_t ncases = sizeof(golden_corpus)/sizeof(golden_corpus[0]);
+  vector<golden_job> jobs;
+  int nfail = 0;
+
+  char tmp_dir[] = "/tmp/cacti_golden_XXXXXX";
+  if (mkdtemp(tmp_dir) == NULL)
+  {
+    cout << "ERROR: cannot create a scratch directory" << endl;
+    exit(1);
+  }
+
+  for (uint32_t c = 0; c < ncases; c++)
+  {
+    for (uint32_t t = 0; t < thread_counts.size(); t++)
+    {
+      golden_job j;
+      ostringstream f;
+      f << tmp_dir << "/" << golden_corpus[c].name << ".t" << thread_counts[t];
+      j.case_idx = c;
+      j.threads  = thread_counts[t];
+      j.engine   = Search_exhaustive;
+      j.out_file = f.str();
+      j.status   = -1;
+      jobs.push_back(j);
+    }
+  }
+  uint32_t n_golden_jobs = jobs.size();
+  for (uint32_t c = 0; c < ncases; c++)
+  {
+    if (!searchable(golden_corpus[c].point)) continue;
+    for (int e = Search_anneal; e <= Search_descent; e++)
+    {
+      golden_job j;
+      ostringstream f;
+      f << tmp_dir << "/" << golden_corpus[c].name << ".search" << e;
+      j.case_idx = c;
+      j.threads  = 0;
+      j.engine   = e;
+      j.out_file = f.str();
+      j.status   = -1;
+      jobs.push_back(j);
+    }
+  }
+  run_golden_jobs(jobs, njobs);
+
+  for (uint32_t c = 0; c < ncases; c++)
+  {
+    const char * name = golden_corpus[c].name;
+    vector<golden_field> ref, first;
+    int ndiff = 0;
+
+    if (load_golden_file(dir + "/" + name + ".golden", ref) == false)
+    {
+      printf("%-28s FAIL: no golden file in %s\n", name, dir.c_str());
+      nfail++;
+      continue;
+    }
+
+    for (uint32_t t = 0; t < thread_counts.size(); t++)
+    {
+      const golden_job & j = jobs[c * thread_counts.size() + t];
+      vector<golden_field> act;
+      ostringstream label;
+      label << name << " (" << j.threads << " thr)";
+
+      if (j.status != 0 || load_golden_file(j.out_file, act) == false)
+      {
+        printf("  %-28s solver exited with status %d\n", label.str().c_str(), j.status);
+        ndiff++;
+        continue;
+      }
+      ndiff += diff_golden(label.str(), ref, act, rtol);
+      if (first.empty())
+      {
+        first = act;
+      }
+      else
+      {
+        ostringstream dlabel;
+        dlabel << name << " (" << jobs[c * thread_counts.size()].threads << " vs " << j.threads << " thr)";
+        ndiff += diff_golden(dlabel.str(), first, act, 0);
+      }
+      unlink(j.out_file.c_str());
+    }
+
+    printf("%-28s %s\n", name, ndiff ? "FAIL" : "ok");
+    nfail += (ndiff != 0);
+  }
+  printf("%d of %u cases failed\n", nfail, ncases);
+
+  int nfail_search = 0;
+  for (uint32_t i = n_golden_jobs; i < jobs.size(); i++)
+  {
+    const golden_job & j = jobs[i];
+    ostringstream label;
+    label << golden_corpus[j.case_idx].name << " (" << (j.engine == Search_anneal ? "anneal" : "descent") << ")";
+
+    ifstream in(j.out_file.c_str());
+    string line;
+    if (j.status != 0 || !getline(in, line))
+    {
+      printf("%-38s FAIL: solver exited with status %d\n", label.str().c_str(), j.status);
+      nfail_search++;
+    }
+    else
+    {
+      double cost = strtod(line.c_str(), NULL);  // inf if the engine's pick misses the deviations
+      bool ok = (cost <= 1 + search_tolerance);
+      printf("%-38s %s (cost %.4f of the exhaustive pick)\n", label.str().c_str(), ok ? "ok" : "FAIL", cost);
+      nfail_search += !ok;
+    }
+    unlink(j.out_file.c_str());
+  }
+  printf("%d of %u search cases failed\n", nfail_search, (uint32_t) (jobs.size() - n_golden_jobs));
+  rmdir(tmp_dir);
+
+  return nfail + nfail_search;
+}
@@ -0,0 +1,68 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __GOLDEN_H__
+#define __GOLDEN_H__
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+/*
+ * Golden-output regression harness. Every case of a fixed corpus is solved
+ * in its own child process (up to njobs at a time) and every field of the
+ * selected uca_org_t and of its tag/data mem_array is written as one
+ * "name value" line; a NUCA case adds the bank size sim_nuca() picked.
+ * record_golden() stores these files in dir;
+ * check_golden() solves the corpus again for each entry of thread_counts,
+ * compares against dir within a relative tolerance (organization fields
+ * exactly) and requires bit-identical results across the thread counts.
+ * It then solves every set-associative UCA case with the anneal and descent
+ * engines, which must pick an organization within a few percent of the
+ * exhaustive one by org_cost(). Returns the number of failing cases.
+ */
+int record_golden(const string & dir, uint32_t njobs);
+int check_golden(const string & dir, uint32_t njobs, double rtol,
+                 const vector<uint32_t> & thread_counts);
+
+#endif
@@ -0,0 +1,592 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <math.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "hier.h"
+#include "sweep.h"
+#include "pareto.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+// one organization of one alternative of a level
+struct hier_candidate
+{
+  uint32_t     alt;        // index into hier_level::alts
+  double       miss_rate;  // local, at the alternative's capacity
+  pareto_point org;
+};
+
+struct hier_level
+{
+  string name;
+  vector<sweep_point> alts;
+  vector<pair<double, double> > miss_curve;  // (bytes, local miss rate), by size
+  vector<hier_candidate> cand;               // pruned, by area
+  uint32_t n_orgs;                           // frontier points before pruning
+};
+
+// one hierarchy: an organization per level
+struct hier_eval
+{
+  double amat;        // s
+  double energy;      // J per access
+  double area;        // um2
+  double leakage;     // W
+  vector<uint32_t> pick;
+};
+
+struct hier_mt_wrapper_struct
+{
+  const vector<hier_level> * levels;
+  const vector<double> * min_rest_area;  // least area of the levels below
+  double   mem_latency;
+  double   mem_energy;
+  double   budget;                       // um2, 0 for none
+  uint32_t first;                        // level 0 candidates first, first + stride, ...
+  uint32_t stride;
+
+  uint64_t n_visited;                    // complete hierarchies within budget
+  map<double, hier_eval> frontier;       // by AMAT, energy falling
+};
+
+
+
+static void hier_error(const string & file, uint32_t line, const string & msg)
+{
+  cout << "ERROR: " << file << ":" << line << ": " << msg << endl;
+  exit(1);
+}
+
+
+
+// Reads the key=value tokens of a directive into the given keys.
+static void parse_hier_values(istream & tokens, const string & file, uint32_t line_no,
+                              uint32_t n, const char * const keys[], double * values)
+{
+  string tok;
+  while (tokens >> tok)
+  {
+    string::size_type eq = tok.find('=');
+    uint32_t k = 0;
+    while (k < n && (eq == string::npos || tok.substr(0, eq) != keys[k])) k++;
+    if (k == n)
+    {
+      hier_error(file, line_no, "unexpected " + tok);
+    }
+    values[k] = atof(tok.c_str() + eq + 1);
+    if (values[k] < 0)
+    {
+      hier_error(file, line_no, "negative value " + tok);
+    }
+  }
+}
+
+
+
+// Local miss rate at size bytes: linear in log(size) between the points of
+// the curve, clamped to its end points.
+static double miss_rate(const vector<pair<double, double> > & curve, double size)
+{
+  if (size <= curve.front().first) return curve.front().second;
+  if (size >= curve.back().first)  return curve.back().second;
+
+  uint32_t k = 1;
+  while (curve[k].first < size) k++;
+  double t = log(size / curve[k-1].first) / log(curve[k].first / curve[k-1].first);
+  return curve[k-1].second + t * (curve[k].second - curve[k-1].second);
+}
+
+
+
+// Adds e to a frontier that is sorted by AMAT with the energy falling. Of two
+// identical points the one with the lexicographically smaller pick is kept,
+// so the frontier does not depend on the order of insertion.
+static void frontier_insert(map<double, hier_eval> & f, const hier_eval & e)
+{
+  map<double, hier_eval>::iterator it = f.upper_bound(e.amat);
+  if (it != f.begin())
+  {
+    const hier_eval & prev = (--it)->second;  // least energy at AMAT <= e.amat
+    if (prev.energy < e.energy ||
+        (prev.energy == e.energy && (prev.amat < e.amat || prev.pick <= e.pick)))
+    {
+      return;
+    }
+  }
+  it = f.lower_bound(e.amat);
+  while (it != f.end() && it->second.energy >= e.energy)
+  {
+    f.erase(it++);
+  }
+  f[e.amat] = e;
+}
+
+
+
+// Depth-first over the candidates of level l and below. t and e hold the
+// time and energy of the levels above, weighted by the fraction of accesses
+// that reach them; reach is the fraction that reaches level l.
+static void hier_search(hier_mt_wrapper_struct * w, uint32_t l, double t, double e,
+                        double reach, double area, double leakage, vector<uint32_t> & pick)
+{
+  const hier_level & lv = (*w->levels)[l];
+  uint32_t first = (l == 0) ? w->first  : 0;
+  uint32_t step  = (l == 0) ? w->stride : 1;
+
+  for (uint32_t i = first; i < lv.cand.size(); i += step)
+  {
+    const hier_candidate & c = lv.cand[i];
+    double a = area + c.org.area;
+    if (w->budget > 0 && a + (*w->min_rest_area)[l] > w->budget)
+    {
+      break;  // the candidates are sorted by area
+    }
+
+    double t_l = t + reach * c.org.access_time;
+    double e_l = e + reach * c.org.read_energy;
+    double r_l = reach * c.miss_rate;
+    pick[l] = i;
+
+    if (l + 1 < w->levels->size())
+    {
+      hier_search(w, l + 1, t_l, e_l, r_l, a, leakage + c.org.leakage, pick);
+      continue;
+    }
+
+    hier_eval h;
+    h.amat    = t_l + r_l * w->mem_latency;
+    h.energy  = e_l + r_l * w->mem_energy;
+    h.area    = a;
+    h.leakage = leakage + c.org.leakage;
+    h.pick    = pick;
+    w->n_visited++;
+    frontier_insert(w->frontier, h);
+  }
+}
+
+
+
+static void *hier_mt_wrapper(void * void_obj)
+{
+  hier_mt_wrapper_struct * w = (hier_mt_wrapper_struct *) void_obj;
+  vector<uint32_t> pick(w->levels->size());
+  hier_search(w, 0, 0, 0, 1, 0, 0, pick);
+  return NULL;
+}
+
+
+
+static void read_hierarchy(const string & file, vector<hier_level> & levels,
+                           double & mem_latency, double & mem_energy,
+                           double & budget, double & w_amat, double & w_energy)
+{
+  ifstream in(file.c_str());
+  string line, dir;
+  uint32_t line_no = 0;
+  map<string, vector<pair<double, double> > > curves;
+  map<string, uint32_t> curve_line;
+  bool memory_set = false;
+
+  if (!in)
+  {
+    cout << "ERROR: cannot open hierarchy file " << file << endl;
+    exit(1);
+  }
+
+  while (getline(in, line))
+  {
+    line_no++;
+    line = line.substr(0, line.find('#'));
+    istringstream tokens(line);
+    if (!(tokens >> dir))
+    {
+      continue;
+    }
+
+    if (dir == "level" || dir == "miss")
+    {
+      string name;
+      if (!(tokens >> name))
+      {
+        hier_error(file, line_no, "missing level name");
+      }
+      if (dir == "level")
+      {
+        sweep_point sp;
+        if (!parse_sweep_point(tokens, sp, file, line_no))
+        {
+          hier_error(file, line_no, "missing configuration file");
+        }
+        uint32_t l = 0;
+        while (l < levels.size() && levels[l].name != name) l++;
+        if (l == levels.size())
+        {
+          levels.push_back(hier_level());
+          levels[l].name = name;
+        }
+        levels[l].alts.push_back(sp);
+        continue;
+      }
+
+      vector<pair<double, double> > & curve = curves[name];
+      string tok;
+      curve_line[name] = line_no;
+      while (tokens >> tok)
+      {
+        double size, rate;
+        char c;
+        istringstream pt(tok);
+        if (!(pt >> size >> c >> rate) || c != ':' || size <= 0 || rate < 0 || rate > 1)
+        {
+          hier_error(file, line_no, "expected <bytes>:<miss rate in [0,1]>, got " + tok);
+        }
+        curve.push_back(make_pair(size, rate));
+      }
+      sort(curve.begin(), curve.end());
+      for (uint32_t k = 1; k < curve.size(); k++)
+      {
+        if (curve[k].first == curve[k-1].first)
+        {
+          hier_error(file, line_no, "two miss rates for one size");
+        }
+      }
+    }
+    else if (dir == "memory")
+    {
+      static const char * const keys[] = {"latency_ns", "energy_nJ"};
+      double v[2] = {0, 0};
+      parse_hier_values(tokens, file, line_no, 2, keys, v);
+      mem_latency = v[0] * 1e-9;
+      mem_energy  = v[1] * 1e-9;
+      memory_set  = true;
+    }
+    else if (dir == "budget")
+    {
+      static const char * const keys[] = {"area_mm2"};
+      parse_hier_values(tokens, file, line_no, 1, keys, &budget);
+      budget *= 1e6;
+    }
+    else if (dir == "weights")
+    {
+      static const char * const keys[] = {"amat", "energy"};
+      double v[2] = {w_amat, w_energy};
+      parse_hier_values(tokens, file, line_no, 2, keys, v);
+      w_amat   = v[0];
+      w_energy = v[1];
+    }
+    else
+    {
+      hier_error(file, line_no, "unknown directive " + dir);
+    }
+  }
+
+  if (levels.empty())
+  {
+    hier_error(file, line_no, "no level");
+  }
+  if (memory_set == false)
+  {
+    hier_error(file, line_no, "no memory line");
+  }
+  if (w_amat + w_energy <= 0)
+  {
+    hier_error(file, line_no, "the weights are all 0");
+  }
+  for (map<string, uint32_t>::iterator it = curve_line.begin(); it != curve_line.end(); ++it)
+  {
+    uint32_t l = 0;
+    while (l < levels.size() && levels[l].name != it->first) l++;
+    if (l == levels.size())
+    {
+      hier_error(file, it->second, "miss rate curve of unknown level " + it->first);
+    }
+    if (curves[it->first].empty())
+    {
+      hier_error(file, it->second, "empty miss rate curve");
+    }
+    levels[l].miss_curve = curves[it->first];
+  }
+  for (uint32_t l = 0; l < levels.size(); l++)
+  {
+    if (levels[l].miss_curve.empty())
+    {
+      hier_error(file, line_no, "no miss rate curve for level " + levels[l].name);
+    }
+    // the strings are final now
+    for (uint32_t a = 0; a < levels[l].alts.size(); a++)
+    {
+      finish_sweep_point(levels[l].alts[a]);
+    }
+  }
+}
+
+
+
+static bool area_less(const hier_candidate & a, const hier_candidate & b)
+{
+  return a.org.area < b.org.area;
+}
+
+
+
+// Solves every alternative of the level and keeps the organizations that are
+// not dominated in access time, read energy, area and miss rate.
+static void solve_level(hier_level & lv)
+{
+  vector<hier_candidate> all;
+
+  for (uint32_t a = 0; a < lv.alts.size(); a++)
+  {
+    const sweep_point & sp = lv.alts[a];
+    load_bench_point(sp.bp);
+    if (g_ip->nuca)
+    {
+      cout << "ERROR: " << sp.label << ": NUCA levels are not supported" << endl;
+      exit(1);
+    }
+    g_ip->pareto_frontier    = true;
+    g_ip->pareto_out_file[0] = '\0';
+    double rate = miss_rate(lv.miss_curve, g_ip->cache_sz);
+
+    uca_org_t fin_res;
+    int saved_fd = silence_stdout();
+    try
+    {
+      solve_bench_point(sp.bp, &fin_res);
+    }
+    catch (const cacti_error &)
+    {
+      restore_stdout(saved_fd);
+      delete g_ip;
+      g_ip = NULL;
+      throw;
+    }
+    restore_stdout(saved_fd);
+    delete fin_res.data_array2;
+    delete fin_res.tag_array2;
+    delete g_ip;
+
+    for (uint32_t i = 0; i < pareto_frontier.size(); i++)
+    {
+      hier_candidate c;
+      c.alt       = a;
+      c.miss_rate = rate;
+      c.org       = pareto_frontier[i];
+      all.push_back(c);
+    }
+  }
+
+  vector<double> keys;
+  for (uint32_t i = 0; i < all.size(); i++)
+  {
+    keys.push_back(all[i].org.access_time);
+    keys.push_back(all[i].org.read_energy);
+    keys.push_back(all[i].org.area);
+    keys.push_back(all[i].miss_rate);
+  }
+  vector<uint32_t> front = non_dominated(keys, 4);
+
+  lv.n_orgs = all.size();
+  lv.cand.clear();
+  for (uint32_t i = 0; i < front.size(); i++)
+  {
+    lv.cand.push_back(all[front[i]]);
+  }
+  stable_sort(lv.cand.begin(), lv.cand.end(), area_less);
+}
+
+
+
+// data org, wire type and tag org ("-" for a RAM level)
+static void print_hier_org(ostream & os, const pareto_point & p)
+{
+  print_org(os, p.data_array, ":");
+  os << " " << wire_type_name(p.data_array.wt) << " ";
+  if (p.has_tag)
+  {
+    print_org(os, p.tag_array, ":");
+  }
+  else
+  {
+    os << "-";
+  }
+}
+
+
+
+static void print_hier_eval(const hier_eval & h)
+{
+  cout << setw(12) << h.amat*1e9
+       << setw(14) << h.energy*1e9
+       << setw(12) << h.area*1e-6
+       << setw(14) << h.leakage*1e3;
+}
+
+
+
+void run_hierarchy(const string & file)
+{
+  vector<hier_level> levels;
+  double mem_latency = 0, mem_energy = 0, budget = 0, w_amat = 1, w_energy = 1;
+
+  read_hierarchy(file, levels, mem_latency, mem_energy, budget, w_amat, w_energy);
+
+  cout << "\nCache hierarchy " << file << " (" << levels.size() << " levels):\n";
+  cout << "  level      configurations  organizations  kept" << endl;
+  for (uint32_t l = 0; l < levels.size(); l++)
+  {
+    solve_level(levels[l]);
+    cout << "  " << left << setw(10) << levels[l].name << right
+         << setw(16) << levels[l].alts.size()
+         << setw(15) << levels[l].n_orgs
+         << setw(6)  << levels[l].cand.size() << endl;
+    if (levels[l].cand.empty())
+    {
+      throw cacti_error("level " + levels[l].name + " has no feasible organization", 1);
+    }
+  }
+
+  vector<double> min_rest_area(levels.size(), 0);
+  for (int l = levels.size() - 2; l >= 0; l--)
+  {
+    min_rest_area[l] = min_rest_area[l+1] + levels[l+1].cand.front().org.area;
+  }
+
+  uint32_t n_thr = min<uint32_t>(nthreads, levels[0].cand.size());
+  vector<hier_mt_wrapper_struct> work(n_thr);
+  vector<pthread_t> threads(n_thr);
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    work[t].levels        = &levels;
+    work[t].min_rest_area = &min_rest_area;
+    work[t].mem_latency   = mem_latency;
+    work[t].mem_energy    = mem_energy;
+    work[t].budget        = budget;
+    work[t].first         = t;
+    work[t].stride        = n_thr;
+    work[t].n_visited     = 0;
+    pthread_create(&threads[t], NULL, hier_mt_wrapper, (void *) &work[t]);
+  }
+
+  map<double, hier_eval> frontier;
+  uint64_t n_visited = 0;
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    pthread_join(threads[t], NULL);
+    n_visited += work[t].n_visited;
+    for (map<double, hier_eval>::iterator it = work[t].frontier.begin(); it != work[t].frontier.end(); ++it)
+    {
+      frontier_insert(frontier, it->second);
+    }
+  }
+
+  if (frontier.empty())
+  {
+    ostringstream msg;
+    msg << "no hierarchy fits the area budget of " << budget*1e-6 << " mm2";
+    throw cacti_error(msg.str(), 1);
+  }
+
+  // the weighted optimum is on the frontier, whose ends hold the minima
+  double min_amat   = frontier.begin()->second.amat;
+  double min_energy = frontier.rbegin()->second.energy;
+  const hier_eval * best = NULL;
+  double best_cost = 0;
+  for (map<double, hier_eval>::iterator it = frontier.begin(); it != frontier.end(); ++it)
+  {
+    double cost = w_amat * it->second.amat / min_amat + w_energy * it->second.energy / min_energy;
+    if (best == NULL || cost < best_cost)
+    {
+      best      = &it->second;
+      best_cost = cost;
+    }
+  }
+
+  cout << "  " << n_visited << " hierarchies within budget";
+  if (budget > 0) cout << " (" << budget*1e-6 << " mm2)";
+  cout << "\n\nBest hierarchy (weights amat " << w_amat << ", energy " << w_energy << "):\n";
+  cout << "      AMAT (ns)  energy (nJ)   area (mm2)  leakage (mW)\n    ";
+  print_hier_eval(*best);
+  cout << endl;
+  cout << "  level      access (ns)   read (nJ)  area (mm2)  local miss  data Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2"
+       << "  wire type  tag Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2  configuration" << endl;
+  for (uint32_t l = 0; l < levels.size(); l++)
+  {
+    const hier_candidate & c = levels[l].cand[best->pick[l]];
+    cout << "  " << left << setw(10) << levels[l].name << right
+         << setw(12) << c.org.access_time*1e9
+         << setw(12) << c.org.read_energy*1e9
+         << setw(12) << c.org.area*1e-6
+         << setw(12) << c.miss_rate << "  ";
+    print_hier_org(cout, c.org);
+    cout << "  " << levels[l].alts[c.alt].label << endl;
+  }
+
+  cout << "\nAMAT / energy frontier (" << frontier.size() << " hierarchies):\n";
+  cout << "   #   AMAT (ns)  energy (nJ)   area (mm2)  leakage (mW)"
+       << "  configurations (data org, wire type, tag org)" << endl;
+  uint32_t n = 0;
+  for (map<double, hier_eval>::iterator it = frontier.begin(); it != frontier.end(); ++it)
+  {
+    const hier_eval & h = it->second;
+    cout << setw(4) << ++n;
+    print_hier_eval(h);
+    cout << "  ";
+    for (uint32_t l = 0; l < levels.size(); l++)
+    {
+      const hier_candidate & c = levels[l].cand[h.pick[l]];
+      cout << (l ? " | " : "") << levels[l].alts[c.alt].label << " ";
+      print_hier_org(cout, c.org);
+    }
+    cout << endl;
+  }
+}
@@ -0,0 +1,69 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __HIER_H__
+#define __HIER_H__
+
+#include <string>
+
+using namespace std;
+
+
+/*
+ * Co-optimizes a multi-level cache hierarchy described by file:
+ *
+ *   level   <name> <cfg_file> [sweep list keys]   one alternative of a level
+ *   miss    <name> <bytes>:<local miss rate> ...  miss rate curve of a level
+ *   memory  latency_ns=<t> energy_nJ=<e>          what the last level misses to
+ *   budget  area_mm2=<a>                          0 or absent: no budget
+ *   weights amat=<w> energy=<w>                   default 1 and 1
+ *
+ * Levels are ordered by their first line, closest to the core first, and
+ * '#' starts a comment. Every alternative is solved once for its Pareto
+ * frontier, which is reduced per level to the organizations not dominated
+ * in access time, read energy, area and miss rate. The joint search then
+ * picks one organization per level, minimizing the weighted AMAT and
+ * energy per access under the area budget, and reports the (AMAT, energy)
+ * frontier of the hierarchies within budget.
+ */
+void run_hierarchy(const string & file);
+
+#endif
@@ -54,11 +54,43 @@
 #include "crossbar.h"
 #include "arbiter.h"
 #include "xmlParser.h"	// Majid
+#include "montecarlo.h"
+#include "tempsweep.h"
+#include "voltsweep.h"
+#include "techsweep.h"
+#include "sensitivity.h"
+#include "trace.h"
+#include "banksim.h"
+#include "pareto.h"
+#include "search.h"
 
 using namespace std;
 
 
 
+/* Reads one <cache> or <array> block of <constraints> (ns, mm2, nJ, mW);
+ * a missing block or element means no bound */
+static void parse_constraints(XMLNode node, hard_constraints & limit)
+{
+	char temp_var[5000];
+	const char * names[5] = {"max_access_time", "max_cycle_time", "max_area", "max_read_energy", "max_leakage"};
+	const double scale[5] = {1e-9, 1e-9, 1e6, 1e-9, 1e-3};
+	double * fields[5] = {&limit.access_time, &limit.cycle_time, &limit.area, &limit.read_energy, &limit.leakage};
+
+	for (int i = 0; i < 5; i++) {
+		*fields[i] = 0;
+		if ( !node.isEmpty() && !node.getChildNode(names[i]).isEmpty() && node.getChildNode(names[i]).nText() > 0 ) {
+			strcpy(temp_var,node.getChildNode(names[i]).getText(0));
+			sscanf(temp_var, "%lf", fields[i]);
+			if (*fields[i] < 0) {
+				cerr << "ERROR: <" << names[i] << "> in <constraints> must not be negative.\n";
+				throw cacti_error("invalid <constraints>");
+			}
+			*fields[i] *= scale[i];
+		}
+	}
+}
+
 /* Parses "cache.cfg" file */
 void InputParameter::parse_cfg(const string & in_file)
 {
@@ -68,9 +100,9 @@ void InputParameter::parse_cfg(const string & in_file)
   char temp_var[5000];
 
   if(!fp) {
-    cout << in_file << " is missing!\n";
-    exit(-1);
+    throw cacti_error(in_file + " is missing!", -1);
   }
+  fclose(fp);
 
 	/******************** MAJID BEGIN ********************/
 	
@@ -78,11 +110,11 @@ void InputParameter::parse_cfg(const string & in_file)
 	
 	if ( xMainNode.getChildNode("transistor_type").isEmpty() ) {
 		cerr << "XML ERROR: <transistor_type> in the '" << in_file <<"' file is missing.\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else if ( xMainNode.getChildNode("transistor_type").nText() == 0 ) {
 		cerr << "XML ERROR: <transistor_type> in the '" << in_file <<"' file does not have a value.\n";
 		cerr << "Please specify either 'finfet' or 'cmos' as the transistor type." << endl;
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else {
 		strcpy(temp_var,xMainNode.getChildNode("transistor_type").getText(0));
 		for (int i = 0; temp_var[i]; i++) { temp_var[i] = tolower(temp_var[i]); }
@@ -92,16 +124,16 @@ void InputParameter::parse_cfg(const string & in_file)
 			is_finfet = 0;
 		} else {
 			cerr << "ERROR: Invalid transistor type!\nSupported transistor types: 'finfet', 'cmos'.\n";
-			exit(0);
+			throw cacti_error("invalid input file " + in_file);
 		}
 	}
 	
 	if ( xMainNode.getChildNode("technology_node").isEmpty() ) {
 		cerr << "XML ERROR: <technology_node> in the '" << in_file <<"' file is missing.\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else if ( xMainNode.getChildNode("technology_node").nText() == 0 ) {
 		cerr << "XML ERROR: <technology_node> in the '" << in_file <<"' file does not have a value.\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else {
 		strcpy(temp_var,xMainNode.getChildNode("technology_node").getText(0));
 		sscanf(temp_var, "%lf", &(F_sz_um));
@@ -110,11 +142,11 @@ void InputParameter::parse_cfg(const string & in_file)
 	
 	if ( xMainNode.getChildNode("operating_voltage").isEmpty() ) {
 		cerr << "XML ERROR: <operating_voltage> in the '" << in_file <<"' file is missing.\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else if ( xMainNode.getChildNode("operating_voltage").nText() == 0 ) {
 		cerr << "XML ERROR: <operating_voltage> in the '" << in_file <<"' file does not have a value.\n";
 		cerr << "Please specify either 'super-threshold' or 'near-threshold' as the operating voltage." << endl;
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else {
 		strcpy(temp_var,xMainNode.getChildNode("operating_voltage").getText(0));
 		for (int i = 0; temp_var[i]; i++) { temp_var[i] = tolower(temp_var[i]); }
@@ -124,24 +156,24 @@ void InputParameter::parse_cfg(const string & in_file)
 			is_near_threshold = 0;
 		} else {
 			cerr << "ERROR: Invalid operating voltage!\nSupported operating voltages: 'super-threshold', 'near-threshold'.\n";
-			exit(0);
+			throw cacti_error("invalid input file " + in_file);
 		}
 	}
 	
 	if ( xMainNode.getChildNode("temperature").isEmpty() ) {
 		cerr << "XML ERROR: <temperature> in the '" << in_file <<"' file is missing.\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else if ( xMainNode.getChildNode("temperature").nText() == 0 ) {
 		cerr << "XML ERROR: <temperature> in the '" << in_file <<"' file does not have a value.\n";
 		cerr << "Please specify a number between 300 and 400, which is a multiple of 10." << endl;
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	} else {
 		strcpy(temp_var,xMainNode.getChildNode("temperature").getText(0));
 		sscanf(temp_var, "%u", &(temp));
 		if (temp < 300 || temp > 400 || temp%10 != 0) {
 			cerr << "ERROR: " << temp << "K is not a valid temperature." << endl;
 			cerr << "The temperature must be a multiple of 10 between 300K and 400K." << endl;
-			exit(0);
+			throw cacti_error("invalid input file " + in_file);
 		}
 	}
 	
@@ -159,129 +191,7 @@ void InputParameter::parse_cfg(const string & in_file)
 	strcpy(tag_array_cell_tech_file,xMainNode.getChildNode("devices").getChildNode("tag_array").getChildNode("cell").getText(0));
 	strcpy(tag_array_peri_tech_file,xMainNode.getChildNode("devices").getChildNode("tag_array").getChildNode("peripheral").getText(0));
 
-	string sram_cell_file = xMainNode.getChildNode("sram_cell").getText(0);
-	XMLNode SRAM_cell_conf_node = XMLNode::openFileHelper(sram_cell_file.c_str(),"sram_cell");
-	strcpy(temp_var,SRAM_cell_conf_node.getChildNode("type").getText(0));
-	if (!strncmp("6T", temp_var, strlen("6T"))) {
-		sram_cell_design.setType(std_6T);
-	} else if (!strncmp("8T", temp_var, strlen("8T"))) {
-		sram_cell_design.setType(std_8T);
-	} else if (!strncmp("10T", temp_var, strlen("10T"))) {  //Francesco
-    sram_cell_design.setType(std_10T);
-  } else {
-		cerr << "ERROR: Invalid SRAM cell type!\n";
-		exit(0);
-	}
-	
-	if ( !SRAM_cell_conf_node.getChildNode("dual_gate_control").isEmpty() ) {
-		if ( SRAM_cell_conf_node.getChildNode("dual_gate_control").nText() == 0 ) {
-			cout << "XML ERROR: <dual_gate_control> in the '" << sram_cell_file <<"' file does not have a value.\n";
-			cerr << "Please specify either 'true' or 'false' for the dual_gate_control." << endl;
-			exit(0);
-		} else {
-			strcpy(temp_var,SRAM_cell_conf_node.getChildNode("dual_gate_control").getText(0));
-			for (int i = 0; temp_var[i]; i++) { temp_var[i] = tolower(temp_var[i]); }
-			if (!strncmp("true", temp_var, strlen("true"))) {
-				sram_cell_design.setDGcontrol(true);
-			} else if (!strncmp("false", temp_var, strlen("false"))) {
-				sram_cell_design.setDGcontrol(false);
-			} else {
-				cerr << "ERROR: Invalid value for the dual_gate_control in '" << sram_cell_file <<"' file!\n";
-				exit(0);
-			}
-		}
-	} else {
-		sram_cell_design.setDGcontrol(false);
-	}
-	
-	XMLNode SRAM_leak_power = SRAM_cell_conf_node.getChildNode("leakage_power");
-	if ( !SRAM_leak_power.getChildNode("bitline").isEmpty() ) {
-		if ( SRAM_leak_power.getChildNode("bitline").nText() > 0 ) {
-			strcpy(temp_var,SRAM_leak_power.getChildNode("bitline").getText(0));
-			double pleak;
-			sscanf(temp_var, "%lf", &(pleak));
-			sram_cell_design.setPleakAccTx(pleak);
-		}
-	}
-	if ( !SRAM_leak_power.getChildNode("cc_inverters").isEmpty() ) {
-		if ( SRAM_leak_power.getChildNode("cc_inverters").nText() > 0 ) {
-			strcpy(temp_var,SRAM_leak_power.getChildNode("cc_inverters").getText(0));
-			double pleak;
-			sscanf(temp_var, "%lf", &(pleak));
-			sram_cell_design.setPleakCCInv(pleak);
-		}
-	}
-	
-	int Nfins[5];
-	double Lphys[5], Ioffs[5];
-	XMLNode SRAM_transistor_parameters = SRAM_cell_conf_node.getChildNode("transistor_parameters");
-	if ( is_finfet ) {
-		strcpy(temp_var,SRAM_transistor_parameters.getChildNode("acc").getChildNode("num_of_fins").getText(0));
-		sscanf(temp_var,"%d",&(Nfins[0]));
-		strcpy(temp_var,SRAM_transistor_parameters.getChildNode("pup").getChildNode("num_of_fins").getText(0));
-		sscanf(temp_var,"%d",&(Nfins[1]));
-		strcpy(temp_var,SRAM_transistor_parameters.getChildNode("pdn").getChildNode("num_of_fins").getText(0));
-		sscanf(temp_var,"%d",&(Nfins[2]));
-		if (sram_cell_design.getType() == std_8T) {
-			strcpy(temp_var,SRAM_transistor_parameters.getChildNode("iso").getChildNode("num_of_fins").getText(0));
-			sscanf(temp_var,"%d",&(Nfins[3]));
-			strcpy(temp_var,SRAM_transistor_parameters.getChildNode("rac").getChildNode("num_of_fins").getText(0));
-			sscanf(temp_var,"%d",&(Nfins[4]));
-		}
-	} else {
-		Nfins[0] = 0; Nfins[1] = 0; Nfins[2] = 0; Nfins[3] = 0; Nfins[4] = 0;
-	}
-	
-	XMLNode SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("acc").getChildNode("device_type").getText(0),"device_definition");
-	strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
-	sscanf(temp_var,"%lf",&(Lphys[0]));
-	char temperature[10];
-	sprintf(temperature,"%d",g_ip->temp);
-	if (is_near_threshold)
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-	else
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-	sscanf(temp_var,"%lf",&(Ioffs[0]));
-
-	SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("pup").getChildNode("device_type").getText(0),"device_definition");
-	strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
-	sscanf(temp_var,"%lf",&(Lphys[1]));
-	if(is_near_threshold)
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("PMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-	else
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("PMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-	sscanf(temp_var,"%lf",&(Ioffs[1]));
-	
-	SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("pdn").getChildNode("device_type").getText(0),"device_definition");
-	strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
-	sscanf(temp_var,"%lf",&(Lphys[2]));
-	if(is_near_threshold)
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-	else
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-	sscanf(temp_var,"%lf",&(Ioffs[2]));
-	
-	if (sram_cell_design.getType() == std_8T) {
-		SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("iso").getChildNode("device_type").getText(0),"device_definition");
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
-		sscanf(temp_var,"%lf",&(Lphys[3]));
-		if (is_near_threshold)
-			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-		else
-			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-		sscanf(temp_var,"%lf",&(Ioffs[3]));
-
-		SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("rac").getChildNode("device_type").getText(0),"device_definition");
-		strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
-		sscanf(temp_var,"%lf",&(Lphys[4]));
-		if (is_near_threshold)
-			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-		else
-			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-		sscanf(temp_var,"%lf",&(Ioffs[4]));
-	}
-	
-	sram_cell_design.setTransistorParams(Nfins, Lphys, Ioffs);
+	parse_sram_cell(xMainNode.getChildNode("sram_cell").getText(0));
 
 	XMLNode ports_node = xMainNode.getChildNode("ports");
 	strcpy(temp_var,ports_node.getChildNode("read_write_port").getText(0));
@@ -335,6 +245,7 @@ void InputParameter::parse_cfg(const string & in_file)
 		sscanf(temp_var, "%u", &(tag_w));
 	}
 	
+	all_access_modes = false;
 	strcpy(temp_var,xMainNode.getChildNode("access_mode").getText(0));
 	if (!strncmp("fast", temp_var, strlen("fast"))) {
 		access_mode = 2;
@@ -342,9 +253,12 @@ void InputParameter::parse_cfg(const string & in_file)
 		access_mode = 1;
 	} else if(!strncmp("normal", temp_var, strlen("normal"))) {
 		access_mode = 0;
+	} else if(!strncmp("all", temp_var, strlen("all"))) {
+		access_mode = 0;
+		all_access_modes = true;
 	} else {
 		cout << "ERROR: Invalid access mode!\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	}
 
 	XMLNode objectiveFuncNode=xMainNode.getChildNode("objective_function");
@@ -408,7 +322,7 @@ void InputParameter::parse_cfg(const string & in_file)
 		is_itrs2012 = false;
 	} else {
 		cout << "ERROR: Invalid interconnect source!\n";
-		exit(0);
+		throw cacti_error("invalid input file " + in_file);
 	}
 	strcpy(temp_var,interconnectsInfoNode.getChildNode("wire_signalling").getText(0));
 	if (!strncmp("default", temp_var, strlen("default"))) {
@@ -524,6 +438,332 @@ void InputParameter::parse_cfg(const string & in_file)
 
 	/********************  MAJID END  ********************/
 
+	// Optional process-variation analysis of the chosen data array
+	mc_samples = 0;
+	mc_sigma_vth = 0.03;
+	mc_fin_loss_prob = 0.0;
+	mc_alpha = 1.3;
+	mc_seed = 1;
+	if ( !xMainNode.getChildNode("monte_carlo").isEmpty() ) {
+		XMLNode mc_node = xMainNode.getChildNode("monte_carlo");
+		if ( !mc_node.getChildNode("samples").isEmpty() ) {
+			strcpy(temp_var,mc_node.getChildNode("samples").getText(0));
+			sscanf(temp_var, "%u", &(mc_samples));
+		}
+		if ( !mc_node.getChildNode("sigma_vth").isEmpty() ) {
+			strcpy(temp_var,mc_node.getChildNode("sigma_vth").getText(0));
+			sscanf(temp_var, "%lf", &(mc_sigma_vth));
+		}
+		if ( !mc_node.getChildNode("fin_loss_probability").isEmpty() ) {
+			strcpy(temp_var,mc_node.getChildNode("fin_loss_probability").getText(0));
+			sscanf(temp_var, "%lf", &(mc_fin_loss_prob));
+		}
+		if ( !mc_node.getChildNode("alpha").isEmpty() ) {
+			strcpy(temp_var,mc_node.getChildNode("alpha").getText(0));
+			sscanf(temp_var, "%lf", &(mc_alpha));
+		}
+		if ( !mc_node.getChildNode("seed").isEmpty() ) {
+			strcpy(temp_var,mc_node.getChildNode("seed").getText(0));
+			sscanf(temp_var, "%u", &(mc_seed));
+		}
+		if (mc_sigma_vth < 0 || mc_fin_loss_prob < 0 || mc_fin_loss_prob >= 1 || mc_alpha <= 0) {
+			cerr << "ERROR: Invalid <monte_carlo> parameters in the '" << in_file << "' file.\n";
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional temperature sweep of the chosen organization
+	tsweep_start = tsweep_stop = temp;
+	tsweep_step = 0;
+	tsweep_reoptimize = false;
+	if ( !xMainNode.getChildNode("temperature_sweep").isEmpty() ) {
+		XMLNode ts_node = xMainNode.getChildNode("temperature_sweep");
+		if ( !ts_node.getChildNode("start").isEmpty() ) {
+			strcpy(temp_var,ts_node.getChildNode("start").getText(0));
+			sscanf(temp_var, "%u", &(tsweep_start));
+		}
+		if ( !ts_node.getChildNode("stop").isEmpty() ) {
+			strcpy(temp_var,ts_node.getChildNode("stop").getText(0));
+			sscanf(temp_var, "%u", &(tsweep_stop));
+		}
+		if ( !ts_node.getChildNode("step").isEmpty() ) {
+			strcpy(temp_var,ts_node.getChildNode("step").getText(0));
+			sscanf(temp_var, "%u", &(tsweep_step));
+		}
+		if ( !ts_node.getChildNode("reoptimize").isEmpty() ) {
+			strcpy(temp_var,ts_node.getChildNode("reoptimize").getText(0));
+			tsweep_reoptimize = !strncmp("true", temp_var, strlen("true"));
+		}
+		if (tsweep_step != 0 && (tsweep_start < 300 || tsweep_stop > 400 || tsweep_start > tsweep_stop ||
+		                         tsweep_start%10 != 0 || tsweep_step%10 != 0)) {
+			cerr << "ERROR: Invalid <temperature_sweep> in the '" << in_file << "' file.\n";
+			cerr << "start, stop and step must be multiples of 10 with 300 <= start <= stop <= 400." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional supply voltage sweep of the chosen organization
+	vdd_override = 0;
+	vsweep_start = vsweep_stop = 0;
+	vsweep_points = 0;
+	vsweep_out_file[0] = '\0';
+	if ( !xMainNode.getChildNode("voltage_sweep").isEmpty() ) {
+		XMLNode vs_node = xMainNode.getChildNode("voltage_sweep");
+		if ( !vs_node.getChildNode("start").isEmpty() ) {
+			strcpy(temp_var,vs_node.getChildNode("start").getText(0));
+			sscanf(temp_var, "%lf", &(vsweep_start));
+		}
+		if ( !vs_node.getChildNode("stop").isEmpty() ) {
+			strcpy(temp_var,vs_node.getChildNode("stop").getText(0));
+			sscanf(temp_var, "%lf", &(vsweep_stop));
+		}
+		if ( !vs_node.getChildNode("points").isEmpty() ) {
+			strcpy(temp_var,vs_node.getChildNode("points").getText(0));
+			sscanf(temp_var, "%u", &(vsweep_points));
+		}
+		if ( !vs_node.getChildNode("output").isEmpty() && vs_node.getChildNode("output").nText() > 0 ) {
+			strcpy(vsweep_out_file,vs_node.getChildNode("output").getText(0));
+		}
+		if (vsweep_points != 0 && (vsweep_start <= 0 || vsweep_stop < vsweep_start ||
+		                           (vsweep_points == 1 && vsweep_stop != vsweep_start))) {
+			cerr << "ERROR: Invalid <voltage_sweep> in the '" << in_file << "' file.\n";
+			cerr << "start and stop must be positive voltages with start <= stop." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional technology node sweep, solved anew at every node
+	nsweep_start = nsweep_stop = 0;
+	nsweep_points = 0;
+	nsweep_warm_start = true;
+	nsweep_radius = 1;
+	nsweep_out_file[0] = '\0';
+	if ( !xMainNode.getChildNode("tech_sweep").isEmpty() ) {
+		XMLNode ns_node = xMainNode.getChildNode("tech_sweep");
+		if ( !ns_node.getChildNode("start").isEmpty() ) {
+			strcpy(temp_var,ns_node.getChildNode("start").getText(0));
+			sscanf(temp_var, "%lf", &(nsweep_start));
+		}
+		if ( !ns_node.getChildNode("stop").isEmpty() ) {
+			strcpy(temp_var,ns_node.getChildNode("stop").getText(0));
+			sscanf(temp_var, "%lf", &(nsweep_stop));
+		}
+		if ( !ns_node.getChildNode("points").isEmpty() ) {
+			strcpy(temp_var,ns_node.getChildNode("points").getText(0));
+			sscanf(temp_var, "%u", &(nsweep_points));
+		}
+		if ( !ns_node.getChildNode("warm_start").isEmpty() ) {
+			strcpy(temp_var,ns_node.getChildNode("warm_start").getText(0));
+			nsweep_warm_start = !strncmp("true", temp_var, strlen("true"));
+		}
+		if ( !ns_node.getChildNode("radius").isEmpty() ) {
+			strcpy(temp_var,ns_node.getChildNode("radius").getText(0));
+			sscanf(temp_var, "%u", &(nsweep_radius));
+		}
+		if ( !ns_node.getChildNode("output").isEmpty() && ns_node.getChildNode("output").nText() > 0 ) {
+			strcpy(nsweep_out_file,ns_node.getChildNode("output").getText(0));
+		}
+		// init_tech_params() interpolates between 90 and 14 nm only
+		if (nsweep_points != 0 && (nsweep_start < 14 || nsweep_stop > 90 || nsweep_stop < nsweep_start ||
+		                           (nsweep_points == 1 && nsweep_stop != nsweep_start) ||
+		                           nsweep_radius < 1 || nsweep_radius > 4)) {
+			cerr << "ERROR: Invalid <tech_sweep> in the '" << in_file << "' file.\n";
+			cerr << "start and stop must be nodes from 14 to 90 nm with start <= stop, and radius from 1 to 4." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional sensitivity of the chosen organization to the device and wire values
+	sens_enabled = false;
+	sens_step = 0.01;
+	sens_out_file[0] = '\0';
+	if ( !xMainNode.getChildNode("sensitivity").isEmpty() ) {
+		XMLNode se_node = xMainNode.getChildNode("sensitivity");
+		if ( !se_node.getChildNode("enabled").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("enabled").getText(0));
+			sens_enabled = !strncmp("true", temp_var, strlen("true"));
+		}
+		if ( !se_node.getChildNode("step").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("step").getText(0));
+			sscanf(temp_var, "%lf", &(sens_step));
+		}
+		if ( !se_node.getChildNode("output").isEmpty() && se_node.getChildNode("output").nText() > 0 ) {
+			strcpy(sens_out_file,se_node.getChildNode("output").getText(0));
+		}
+		if (sens_step <= 0 || sens_step >= 0.5) {
+			cerr << "ERROR: Invalid <sensitivity> step in the '" << in_file << "' file.\n";
+			cerr << "step is the relative perturbation, between 0 and 0.5." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional dump of all candidates for plotting
+	dump_enabled = false;
+	strcpy(dump_out_file, "candidates.dump");
+	if ( !xMainNode.getChildNode("candidate_dump").isEmpty() ) {
+		XMLNode cd_node = xMainNode.getChildNode("candidate_dump");
+		if ( !cd_node.getChildNode("enabled").isEmpty() ) {
+			strcpy(temp_var,cd_node.getChildNode("enabled").getText(0));
+			dump_enabled = !strncmp("true", temp_var, strlen("true"));
+		}
+		if ( !cd_node.getChildNode("output").isEmpty() && cd_node.getChildNode("output").nText() > 0 ) {
+			strcpy(dump_out_file,cd_node.getChildNode("output").getText(0));
+		}
+	}
+
+	// Optional absolute constraints
+	parse_constraints(xMainNode.getChildNode("constraints").getChildNode("cache"), cache_limit);
+	parse_constraints(xMainNode.getChildNode("constraints").getChildNode("array"), array_limit);
+
+	// Optional Pareto frontier of all organizations
+	pareto_frontier = false;
+	pareto_out_file[0] = '\0';
+	if ( !xMainNode.getChildNode("pareto_frontier").isEmpty() ) {
+		XMLNode pf_node = xMainNode.getChildNode("pareto_frontier");
+		if ( !pf_node.getChildNode("enabled").isEmpty() ) {
+			strcpy(temp_var,pf_node.getChildNode("enabled").getText(0));
+			pareto_frontier = !strncmp("true", temp_var, strlen("true"));
+		}
+		if ( !pf_node.getChildNode("output").isEmpty() && pf_node.getChildNode("output").nText() > 0 ) {
+			strcpy(pareto_out_file,pf_node.getChildNode("output").getText(0));
+		}
+	}
+
+	// Optional heuristic partition search
+	search_engine = Search_exhaustive;
+	search_extended = false;
+	search_chains = 16;
+	search_max_evals = 2000;
+	search_time_limit = 0;
+	search_seed = 1;
+	search_compare = false;
+	if ( !xMainNode.getChildNode("search").isEmpty() ) {
+		XMLNode se_node = xMainNode.getChildNode("search");
+		if ( !se_node.getChildNode("engine").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("engine").getText(0));
+			if (!strncmp("exhaustive", temp_var, strlen("exhaustive"))) search_engine = Search_exhaustive;
+			else if (!strncmp("anneal", temp_var, strlen("anneal"))) search_engine = Search_anneal;
+			else if (!strncmp("descent", temp_var, strlen("descent"))) search_engine = Search_descent;
+			else {
+				cerr << "ERROR: Invalid <search><engine> in the '" << in_file << "' file.\n";
+				cerr << "Use exhaustive, anneal or descent." << endl;
+				throw cacti_error("invalid input file " + in_file);
+			}
+		}
+		if ( !se_node.getChildNode("extended_space").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("extended_space").getText(0));
+			search_extended = !strncmp("true", temp_var, strlen("true"));
+		}
+		if ( !se_node.getChildNode("chains").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("chains").getText(0));
+			sscanf(temp_var, "%u", &(search_chains));
+		}
+		if ( !se_node.getChildNode("max_evaluations").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("max_evaluations").getText(0));
+			sscanf(temp_var, "%u", &(search_max_evals));
+		}
+		if ( !se_node.getChildNode("time_limit").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("time_limit").getText(0));
+			sscanf(temp_var, "%lf", &(search_time_limit));
+		}
+		if ( !se_node.getChildNode("seed").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("seed").getText(0));
+			sscanf(temp_var, "%u", &(search_seed));
+		}
+		if ( !se_node.getChildNode("compare").isEmpty() ) {
+			strcpy(temp_var,se_node.getChildNode("compare").getText(0));
+			search_compare = !strncmp("true", temp_var, strlen("true"));
+		}
+		if (search_engine != Search_exhaustive && (search_chains == 0 || search_time_limit < 0 ||
+		                                           (search_max_evals == 0 && search_time_limit == 0))) {
+			cerr << "ERROR: Invalid <search> in the '" << in_file << "' file.\n";
+			cerr << "A heuristic engine needs at least one chain and a max_evaluations or time_limit budget." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional trace-driven energy of the chosen organization
+	trace_file[0] = '\0';
+	trace_time_unit = 1e-12;
+	if ( !xMainNode.getChildNode("trace").isEmpty() ) {
+		XMLNode tr_node = xMainNode.getChildNode("trace");
+		if ( !tr_node.getChildNode("file").isEmpty() && tr_node.getChildNode("file").nText() > 0 ) {
+			strcpy(trace_file,tr_node.getChildNode("file").getText(0));
+		}
+		if ( !tr_node.getChildNode("time_unit_ps").isEmpty() ) {
+			strcpy(temp_var,tr_node.getChildNode("time_unit_ps").getText(0));
+			sscanf(temp_var, "%lf", &(trace_time_unit));
+			trace_time_unit *= 1e-12;
+		}
+		if (trace_time_unit <= 0) {
+			cerr << "ERROR: Invalid <trace> in the '" << in_file << "' file.\n";
+			cerr << "time_unit_ps must be positive." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
+	// Optional bank-conflict simulation of the chosen organization
+	bsim_stream = Bsim_none;
+	bsim_requests = 100000;
+	bsim_rate = 1e9;
+	bsim_sequential = false;
+	bsim_write_fraction = 0.3;
+	bsim_seed = 1;
+	bsim_wt = 0;
+	bsim_shortlist = 32;
+	if ( !xMainNode.getChildNode("bank_sim").isEmpty() ) {
+		XMLNode bs_node = xMainNode.getChildNode("bank_sim");
+		if ( !bs_node.getChildNode("stream").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("stream").getText(0));
+			if (!strncmp("none", temp_var, strlen("none"))) bsim_stream = Bsim_none;
+			else if (!strncmp("synthetic", temp_var, strlen("synthetic"))) bsim_stream = Bsim_synthetic;
+			else if (!strncmp("trace", temp_var, strlen("trace"))) bsim_stream = Bsim_trace;
+			else {
+				cerr << "ERROR: Invalid <bank_sim><stream> in the '" << in_file << "' file.\n";
+				cerr << "Use none, synthetic or trace." << endl;
+				throw cacti_error("invalid input file " + in_file);
+			}
+		}
+		if ( !bs_node.getChildNode("requests").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("requests").getText(0));
+			sscanf(temp_var, "%u", &(bsim_requests));
+		}
+		if ( !bs_node.getChildNode("rate_ghz").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("rate_ghz").getText(0));
+			sscanf(temp_var, "%lf", &(bsim_rate));
+			bsim_rate *= 1e9;
+		}
+		if ( !bs_node.getChildNode("pattern").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("pattern").getText(0));
+			bsim_sequential = !strncmp("sequential", temp_var, strlen("sequential"));
+		}
+		if ( !bs_node.getChildNode("write_fraction").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("write_fraction").getText(0));
+			sscanf(temp_var, "%lf", &(bsim_write_fraction));
+		}
+		if ( !bs_node.getChildNode("seed").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("seed").getText(0));
+			sscanf(temp_var, "%u", &(bsim_seed));
+		}
+		if ( !bs_node.getChildNode("weight").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("weight").getText(0));
+			sscanf(temp_var, "%lf", &(bsim_wt));
+		}
+		if ( !bs_node.getChildNode("shortlist").isEmpty() ) {
+			strcpy(temp_var,bs_node.getChildNode("shortlist").getText(0));
+			sscanf(temp_var, "%u", &(bsim_shortlist));
+		}
+		if (bsim_stream != Bsim_none && (bsim_rate <= 0 || bsim_write_fraction < 0 || bsim_write_fraction > 1 ||
+		                                 bsim_wt < 0 || bsim_shortlist == 0 ||
+		                                 (bsim_stream == Bsim_synthetic && bsim_requests == 0) ||
+		                                 (bsim_stream == Bsim_trace && trace_file[0] == '\0'))) {
+			cerr << "ERROR: Invalid <bank_sim> in the '" << in_file << "' file.\n";
+			cerr << "The synthetic stream needs requests and a positive rate_ghz, the trace stream a <trace><file>;\n";
+			cerr << "write_fraction must be in [0, 1], weight must not be negative." << endl;
+			throw cacti_error("invalid input file " + in_file);
+		}
+	}
+
 	data_arr_ram_cell_tech_type = 0;
 	data_arr_peri_global_tech_type = 0;
 	tag_arr_ram_cell_tech_type = 0;
@@ -532,9 +772,141 @@ void InputParameter::parse_cfg(const string & in_file)
 	////////////////////////////////////////////////////////////
   
   rpters_in_htree = true;
-  fclose(fp);
 }
 
+/* Parses the SRAM cell file referenced by <sram_cell>; is_finfet,
+ * is_near_threshold and temp must already be set */
+void InputParameter::parse_sram_cell(const string & sram_cell_file)
+{
+	char temp_var[5000];
+
+	strcpy(sram_cell_conf_file, sram_cell_file.c_str());
+	XMLNode SRAM_cell_conf_node = XMLNode::openFileHelper(sram_cell_file.c_str(),"sram_cell");
+	strcpy(temp_var,SRAM_cell_conf_node.getChildNode("type").getText(0));
+	if (!strncmp("6T", temp_var, strlen("6T"))) {
+		sram_cell_design.setType(std_6T);
+	} else if (!strncmp("8T", temp_var, strlen("8T"))) {
+		sram_cell_design.setType(std_8T);
+	} else if (!strncmp("10T", temp_var, strlen("10T"))) {  //Francesco
+    sram_cell_design.setType(std_10T);
+  } else {
+		cerr << "ERROR: Invalid SRAM cell type!\n";
+		throw cacti_error("invalid SRAM cell file " + sram_cell_file);
+	}
+	
+	if ( !SRAM_cell_conf_node.getChildNode("dual_gate_control").isEmpty() ) {
+		if ( SRAM_cell_conf_node.getChildNode("dual_gate_control").nText() == 0 ) {
+			cout << "XML ERROR: <dual_gate_control> in the '" << sram_cell_file <<"' file does not have a value.\n";
+			cerr << "Please specify either 'true' or 'false' for the dual_gate_control." << endl;
+			throw cacti_error("invalid SRAM cell file " + sram_cell_file);
+		} else {
+			strcpy(temp_var,SRAM_cell_conf_node.getChildNode("dual_gate_control").getText(0));
+			for (int i = 0; temp_var[i]; i++) { temp_var[i] = tolower(temp_var[i]); }
+			if (!strncmp("true", temp_var, strlen("true"))) {
+				sram_cell_design.setDGcontrol(true);
+			} else if (!strncmp("false", temp_var, strlen("false"))) {
+				sram_cell_design.setDGcontrol(false);
+			} else {
+				cerr << "ERROR: Invalid value for the dual_gate_control in '" << sram_cell_file <<"' file!\n";
+				throw cacti_error("invalid SRAM cell file " + sram_cell_file);
+			}
+		}
+	} else {
+		sram_cell_design.setDGcontrol(false);
+	}
+	
+	XMLNode SRAM_leak_power = SRAM_cell_conf_node.getChildNode("leakage_power");
+	if ( !SRAM_leak_power.getChildNode("bitline").isEmpty() ) {
+		if ( SRAM_leak_power.getChildNode("bitline").nText() > 0 ) {
+			strcpy(temp_var,SRAM_leak_power.getChildNode("bitline").getText(0));
+			double pleak;
+			sscanf(temp_var, "%lf", &(pleak));
+			sram_cell_design.setPleakAccTx(pleak);
+		}
+	}
+	if ( !SRAM_leak_power.getChildNode("cc_inverters").isEmpty() ) {
+		if ( SRAM_leak_power.getChildNode("cc_inverters").nText() > 0 ) {
+			strcpy(temp_var,SRAM_leak_power.getChildNode("cc_inverters").getText(0));
+			double pleak;
+			sscanf(temp_var, "%lf", &(pleak));
+			sram_cell_design.setPleakCCInv(pleak);
+		}
+	}
+	
+	int Nfins[5];
+	double Lphys[5], Ioffs[5];
+	XMLNode SRAM_transistor_parameters = SRAM_cell_conf_node.getChildNode("transistor_parameters");
+	if ( is_finfet ) {
+		strcpy(temp_var,SRAM_transistor_parameters.getChildNode("acc").getChildNode("num_of_fins").getText(0));
+		sscanf(temp_var,"%d",&(Nfins[0]));
+		strcpy(temp_var,SRAM_transistor_parameters.getChildNode("pup").getChildNode("num_of_fins").getText(0));
+		sscanf(temp_var,"%d",&(Nfins[1]));
+		strcpy(temp_var,SRAM_transistor_parameters.getChildNode("pdn").getChildNode("num_of_fins").getText(0));
+		sscanf(temp_var,"%d",&(Nfins[2]));
+		if (sram_cell_design.getType() == std_8T) {
+			strcpy(temp_var,SRAM_transistor_parameters.getChildNode("iso").getChildNode("num_of_fins").getText(0));
+			sscanf(temp_var,"%d",&(Nfins[3]));
+			strcpy(temp_var,SRAM_transistor_parameters.getChildNode("rac").getChildNode("num_of_fins").getText(0));
+			sscanf(temp_var,"%d",&(Nfins[4]));
+		}
+	} else {
+		Nfins[0] = 0; Nfins[1] = 0; Nfins[2] = 0; Nfins[3] = 0; Nfins[4] = 0;
+	}
+	
+	XMLNode SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("acc").getChildNode("device_type").getText(0),"device_definition");
+	strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
+	sscanf(temp_var,"%lf",&(Lphys[0]));
+	char temperature[10];
+	sprintf(temperature,"%d",temp);
+	if (is_near_threshold)
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+	else
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+	sscanf(temp_var,"%lf",&(Ioffs[0]));
+
+	SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("pup").getChildNode("device_type").getText(0),"device_definition");
+	strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
+	sscanf(temp_var,"%lf",&(Lphys[1]));
+	if(is_near_threshold)
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("PMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+	else
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("PMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+	sscanf(temp_var,"%lf",&(Ioffs[1]));
+	
+	SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("pdn").getChildNode("device_type").getText(0),"device_definition");
+	strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
+	sscanf(temp_var,"%lf",&(Lphys[2]));
+	if(is_near_threshold)
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+	else
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+	sscanf(temp_var,"%lf",&(Ioffs[2]));
+	
+	if (sram_cell_design.getType() == std_8T) {
+		SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("iso").getChildNode("device_type").getText(0),"device_definition");
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
+		sscanf(temp_var,"%lf",&(Lphys[3]));
+		if (is_near_threshold)
+			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+		else
+			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+		sscanf(temp_var,"%lf",&(Ioffs[3]));
+
+		SRAM_transistor_definition = XMLNode::openFileHelper(SRAM_transistor_parameters.getChildNode("rac").getChildNode("device_type").getText(0),"device_definition");
+		strcpy(temp_var,SRAM_transistor_definition.getChildNode("geometries").getChildNode("Lphy").getText(0));
+		sscanf(temp_var,"%lf",&(Lphys[4]));
+		if (is_near_threshold)
+			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+		else
+			strcpy(temp_var,SRAM_transistor_definition.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS").getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
+		sscanf(temp_var,"%lf",&(Ioffs[4]));
+	}
+	
+	sram_cell_design.setTransistorParams(Nfins, Lphys, Ioffs);
+}
+
+
+
   void
 InputParameter::display_ip()
 {
@@ -644,7 +1016,7 @@ uca_org_t cacti_interface(const string & infile_name)
   g_ip = new InputParameter();
   g_ip->parse_cfg(infile_name);
   
-  if (g_ip->error_checking() == false) { cout << "ERROR: Invalid input parameters!\n", exit(0); }
+  if (g_ip->error_checking() == false) throw cacti_error("Invalid input parameters!");
   if (g_ip->print_input_args) g_ip->display_ip();
 
   init_tech_params(g_ip->F_sz_um, false);
@@ -662,11 +1034,32 @@ uca_org_t cacti_interface(const string & infile_name)
     n.sim_nuca();
   }
 //  g_ip->display_ip();
-  solve(&fin_res);
+  uca_org_t mode_res[Access_modes];
+  int mode_passes = 0;
+  if (g_ip->all_access_modes)
+  {
+    mode_passes = solve_access_modes(mode_res);
+    fin_res = mode_res[g_ip->access_mode];
+  }
+  else
+  {
+    solve(&fin_res);
+  }
 
   output_UCA(&fin_res);
+  output_pruning_counters();
+  if (g_ip->all_access_modes) output_access_modes(mode_res, mode_passes);
   //output_summary_of_results(&fin_res);
   output_summary_of_results_file(&fin_res);
+  if (g_ip->pareto_frontier && g_ip->nuca == 0) output_pareto_frontier();
+  if (g_ip->search_compare) search_comparison();
+  if (g_ip->mc_samples > 0) monte_carlo_variation(&fin_res);
+  if (g_ip->tsweep_step > 0) temperature_sweep(&fin_res);
+  if (g_ip->vsweep_points > 0) voltage_sweep(&fin_res);
+  if (g_ip->nsweep_points > 0) tech_sweep(&fin_res);
+  if (g_ip->sens_enabled) sensitivity_analysis(&fin_res);
+  if (g_ip->trace_file[0] != '\0') trace_energy(&fin_res);
+  if (g_ip->bsim_stream != Bsim_none) bank_sim_report(&fin_res);
 
   delete (g_ip);
   return fin_res;
@@ -731,6 +1124,19 @@ uca_org_t cacti_interface(
 {
   g_ip = new InputParameter();
   g_ip->add_ecc_b_ = true;
+  g_ip->vdd_override = 0;
+  g_ip->nsweep_points = 0;
+  g_ip->sens_enabled = false;
+  g_ip->dump_enabled = false;
+  g_ip->pareto_frontier = false;
+  g_ip->search_engine = Search_exhaustive;
+  g_ip->search_compare = false;
+  g_ip->all_access_modes = false;
+  g_ip->trace_file[0] = '\0';
+  g_ip->bsim_stream = Bsim_none;
+  g_ip->bsim_wt = 0;
+  memset(&g_ip->cache_limit, 0, sizeof(hard_constraints));
+  memset(&g_ip->array_limit, 0, sizeof(hard_constraints));
 
   g_ip->data_arr_ram_cell_tech_type    = data_arr_ram_cell_tech_flavor_in;
   g_ip->data_arr_peri_global_tech_type = data_arr_peri_global_tech_flavor_in;
@@ -800,8 +1206,7 @@ uca_org_t cacti_interface(
       g_ip->wt = Low_swing;
       break;
     default:
-      cout << "Unknown wire type!\n";
-      exit(0);
+      throw cacti_error("Unknown wire type!");
   }
 
   g_ip->delay_wt_nuca = nuca_obj_func_delay;
@@ -846,7 +1251,7 @@ uca_org_t cacti_interface(
   uca_org_t fin_res;
   fin_res.valid = false;
 
-  if (g_ip->error_checking() == false) exit(0);
+  if (g_ip->error_checking() == false) throw cacti_error("Invalid input parameters!");
   if (g_ip->print_input_args) 
     g_ip->display_ip();
   init_tech_params(g_ip->F_sz_um, false);
@@ -868,11 +1273,35 @@ uca_org_t cacti_interface(
 
 
 
+// needs tag_assoc and fully_assoc from error_checking()
+void InputParameter::set_access_mode(unsigned int mode)
+{
+  access_mode = mode;
+  fast_access = (mode != Access_normal && mode != Access_sequential);
+
+  /*dt: testing sequential access mode*/
+  if (mode == Access_sequential)
+  {
+    data_assoc = 1;
+    is_seq_acc = true;
+  }
+  else
+  {
+    data_assoc = tag_assoc;
+    is_seq_acc = false;
+  }
+
+  if (fully_assoc)
+  {
+    data_assoc = 1;
+  }
+}
+
+
+
 bool InputParameter::error_checking()
 {
   int  A;
-  bool seq_access  = false;
-  fast_access = true;
   
   ///if ( (is_finfet && F_sz_nm != 7) || (!is_finfet && F_sz_nm == 7) ) // Alireza
   ///  return false;
@@ -882,22 +1311,6 @@ bool InputParameter::error_checking()
   /// finfet just supports 5nm (just HP), 7nm (just HP), and maybe 32nm
   /// near-threshold not yet
   
-  switch (access_mode)
-  {
-    case 0:
-      seq_access  = false;
-      fast_access = false;
-      break;
-    case 1:
-      seq_access  = true;
-      fast_access = false;
-      break;
-    case 2:
-      seq_access  = false;
-      fast_access = true;
-      break;
-  }
-
   if(is_main_mem)
   {
     if(ic_proj_type == 0)
@@ -1012,24 +1425,8 @@ bool InputParameter::error_checking()
 
   block_sz = B;
 
-  /*dt: testing sequential access mode*/
-  if(seq_access)
-  {
-    tag_assoc  = A;
-    data_assoc = 1;
-    is_seq_acc = true;
-  }
-  else
-  {
-    tag_assoc  = A;
-    data_assoc = A;
-    is_seq_acc = false;
-  }
-
-  if (fully_assoc)
-  {
-    data_assoc = 1;
-  }
+  tag_assoc = A;
+  set_access_mode(access_mode);
   num_rw_ports    = RWP;
   num_rd_ports    = ERP;
   num_wr_ports    = EWP;
@@ -1191,6 +1588,15 @@ void output_data_csv(const uca_org_t & fin_res)
 
 
 
+static string wire_type_error(const char * array, int wt)
+{
+  ostringstream msg;
+  msg << "unknown " << array << " array wire type " << wt;
+  return msg.str();
+}
+
+
+
 void output_UCA(uca_org_t *fr)
 {
   //    if (NUCA) 
@@ -1316,8 +1722,7 @@ void output_UCA(uca_org_t *fr)
       cout <<  "    Data array, wire type: Low swing wires\n";
       break;
     default:
-      cout << "ERROR - Unknown wire type " << (int) fr->data_array2->wt <<endl;
-      exit(0);
+      throw cacti_error(wire_type_error("data", fr->data_array2->wt), 1);
   }
 
   if (g_ip->is_cache) {
@@ -1341,8 +1746,7 @@ void output_UCA(uca_org_t *fr)
         cout <<  "    Tag array, wire type: Low swing wires\n";
         break;
       default:
-        cout << "ERROR - Unknown wire type " << (int) fr->tag_array2->wt <<endl;
-        exit(-1);
+        throw cacti_error(wire_type_error("tag", fr->tag_array2->wt), -1);
     }
   }
 
@@ -1653,6 +2057,52 @@ void output_summary_of_results(uca_org_t *fr) {
   cout << "-------------------------------------------------------------\n";
 }
 
+// partitions whose evaluation stopped early on the <constraints> bounds
+void output_pruning_counters()
+{
+  static const char * names[Eval_abort_types] = {"", "row path", "bitline", "sense amp", "output path", "read energy"};
+  uint64_t total = 0;
+  for (int r = 1; r < Eval_abort_types; r++) total += solve_partitions_aborted[r];
+  if (total == 0) return;
+
+  cout << "Partitions cut short by <constraints>: " << total << " of " << solve_partitions_evaluated << " (";
+  for (int r = 1; r < Eval_abort_types; r++)
+  {
+    cout << names[r] << " " << solve_partitions_aborted[r] << ((r + 1 < Eval_abort_types) ? ", " : ")\n");
+  }
+}
+
+
+
+void output_access_modes(const uca_org_t * res, int passes)
+{
+  static const char * names[Access_modes] = {"normal", "sequential", "fast"};
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  int per_mode = (pure_ram ? 0 : 1) + (g_ip->fully_assoc ? 0 : 1);
+
+  cout << "\nAccess modes (" << passes << " array sweeps for " << Access_modes << " modes, "
+       << Access_modes * per_mode << " if solved one by one):\n";
+  cout << "  mode        access (ns)  cycle (ns)   read (nJ)  write (nJ)  leakage (mW)   area (mm2)"
+       << "  data / tag Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2" << endl;
+  for (int m = 0; m < Access_modes; m++)
+  {
+    const uca_org_t & r = res[m];
+    printf("  %-10s %12.4f %11.4f %11.5f %11.5f %13.4f %12.4f", names[m],
+           r.access_time*1e9, r.cycle_time*1e9, r.power.readOp.dynamic*1e9,
+           r.power.writeOp.dynamic*1e9, r.power.readOp.leakage*1e3, r.area*1e-6);
+    const mem_array * a[2] = {r.data_array2, r.tag_array2};
+    for (int k = 0; k < (pure_ram ? 1 : 2); k++)
+    {
+      printf("%s%d:%d:%g:%d:%d:%d", (k == 0) ? "  " : " / ", a[k]->Ndwl, a[k]->Ndbl, a[k]->Nspd,
+             a[k]->deg_bl_muxing, a[k]->Ndsam_lev_1, a[k]->Ndsam_lev_2);
+    }
+    printf("\n");
+  }
+  fflush(stdout);
+}
+
+
+
 void output_summary_of_results_file(uca_org_t *fr) {
   ofstream fout("pcacti_report.txt", ios::out);
   fout << "Access time                           : " << fr->access_time*1e9 << " ns" << endl;
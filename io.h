@@ -50,5 +50,8 @@ void output_data_csv(const uca_org_t & fin_res);
 void output_UCA(uca_org_t * fin_res);
 void output_summary_of_results(uca_org_t * fin_res); // Alireza
 void output_summary_of_results_file(uca_org_t * fin_res); // Alireza
+void output_pruning_counters();
+// <access_mode>all: one row per mode, passes as returned by solve_access_modes()
+void output_access_modes(const uca_org_t * res, int passes);
 
 #endif
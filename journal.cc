@@ -0,0 +1,599 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "journal.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+sweep_journal * solve_journal = NULL;
+
+static const char     journal_magic[8] = {'C', 'A', 'C', 'T', 'I', 'J', '0', '1'};
+static const uint32_t record_header    = 16;  // length, type, padding, key
+static const uint32_t record_trailer   = 4;   // CRC-32
+static const uint32_t record_overhead  = record_header + record_trailer;
+static const uint64_t compact_min_dead = 64 << 20;  // bytes, while a sweep runs
+
+
+
+static uint32_t crc32(const unsigned char * buf, size_t len, uint32_t crc)
+{
+  static uint32_t table[256];
+  static bool     init = false;
+
+  if (!init)
+  {
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320 ^ (c >> 1) : c >> 1;
+      table[i] = c;
+    }
+    init = true;
+  }
+  crc = ~crc;
+  for (size_t i = 0; i < len; i++) crc = table[(crc ^ buf[i]) & 0xff] ^ (crc >> 8);
+  return ~crc;
+}
+
+
+
+uint64_t fnv1a64(const void * buf, size_t len, uint64_t h)
+{
+  const unsigned char * p = (const unsigned char *) buf;
+  for (size_t i = 0; i < len; i++)
+  {
+    h ^= p[i];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+
+
+template <class T> static void put(string & s, T v)
+{
+  s.append((const char *) &v, sizeof(T));
+}
+
+template <class T> static T get(const char * & p)
+{
+  T v;
+  memcpy(&v, p, sizeof(T));
+  p += sizeof(T);
+  return v;
+}
+
+
+
+// one candidate without its wire type; kind 0 is a tag, 1 a data array
+static const uint32_t candidate_size = 1 + 5*4 + 13*8 + 2;
+
+static void put_candidate(string & s, uint8_t kind, const mem_array_metrics * m)
+{
+  put<uint8_t>(s, kind);
+  put<int32_t>(s, m->Ndwl);
+  put<int32_t>(s, m->Ndbl);
+  put<int32_t>(s, m->deg_bl_muxing);
+  put<int32_t>(s, m->Ndsam_lev_1);
+  put<int32_t>(s, m->Ndsam_lev_2);
+  put<double>(s, m->Nspd);
+  put<double>(s, m->access_time);
+  put<double>(s, m->cycle_time);
+  put<double>(s, m->area);
+  put<double>(s, m->power.readOp.dynamic);
+  put<double>(s, m->power.readOp.leakage);
+  put<double>(s, m->power.writeOp.dynamic);
+  put<double>(s, m->power.writeOp.leakage);
+  put<double>(s, m->delay_senseamp_mux_decoder);
+  put<double>(s, m->delay_before_subarray_output_driver);
+  put<double>(s, m->delay_from_subarray_output_driver_to_output);
+  put<double>(s, m->height);
+  put<double>(s, m->width);
+}
+
+static uint8_t get_candidate(const char * & p, mem_array_metrics * m)
+{
+  uint8_t kind = get<uint8_t>(p);
+  m->Ndwl          = get<int32_t>(p);
+  m->Ndbl          = get<int32_t>(p);
+  m->deg_bl_muxing = get<int32_t>(p);
+  m->Ndsam_lev_1   = get<int32_t>(p);
+  m->Ndsam_lev_2   = get<int32_t>(p);
+  m->Nspd          = get<double>(p);
+  m->access_time   = get<double>(p);
+  m->cycle_time    = get<double>(p);
+  m->area          = get<double>(p);
+  m->power.readOp.dynamic  = get<double>(p);
+  m->power.readOp.leakage  = get<double>(p);
+  m->power.writeOp.dynamic = get<double>(p);
+  m->power.writeOp.leakage = get<double>(p);
+  m->delay_senseamp_mux_decoder                  = get<double>(p);
+  m->delay_before_subarray_output_driver         = get<double>(p);
+  m->delay_from_subarray_output_driver_to_output = get<double>(p);
+  m->height        = get<double>(p);
+  m->width         = get<double>(p);
+  m->arr_min       = NULL;
+  return kind;
+}
+
+
+
+// evaluate_partition() enters a partition once per wire type, back to back
+static void put_candidates(string & s, uint8_t kind, const list<mem_array_metrics *> & l)
+{
+  string prev, cur;
+  int wt0 = 0, nwt = 0;
+
+  for (list<mem_array_metrics *>::const_iterator it = l.begin(); it != l.end(); ++it)
+  {
+    cur.clear();
+    put_candidate(cur, kind, *it);
+    if (nwt > 0 && cur == prev && (*it)->wt == wt0 + nwt && nwt < 255)
+    {
+      nwt++;
+      continue;
+    }
+    if (nwt > 0)
+    {
+      s += prev;
+      put<uint8_t>(s, wt0);
+      put<uint8_t>(s, nwt);
+    }
+    prev.swap(cur);
+    wt0 = (*it)->wt;
+    nwt = 1;
+  }
+  if (nwt > 0)
+  {
+    s += prev;
+    put<uint8_t>(s, wt0);
+    put<uint8_t>(s, nwt);
+  }
+}
+
+
+
+sweep_journal::sweep_journal()
+  : passes_restored(0), bytes_dropped(0), fd(-1), end(0), live_bytes(0), dead_bytes(0),
+    cur_key(0), cur_pass(0)
+{
+}
+
+
+
+sweep_journal::~sweep_journal()
+{
+  if (fd >= 0) close(fd);
+}
+
+
+
+bool sweep_journal::open(const string & file, bool read_only)
+{
+  struct stat st;
+  char magic[sizeof(journal_magic)];
+
+  path = file;
+  fd = read_only ? ::open(file.c_str(), O_RDONLY) : ::open(file.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd < 0 || fstat(fd, &st) != 0)
+  {
+    return false;
+  }
+  if (st.st_size < (off_t) sizeof(journal_magic) && !read_only)
+  {
+    // new file, or a crash before the magic was synced
+    if (ftruncate(fd, 0) != 0 ||
+        pwrite(fd, journal_magic, sizeof(journal_magic), 0) != (ssize_t) sizeof(journal_magic) ||
+        fdatasync(fd) != 0)
+    {
+      return false;
+    }
+    end = live_bytes = sizeof(journal_magic);
+    return true;
+  }
+  if (pread(fd, magic, sizeof(magic), 0) != (ssize_t) sizeof(magic) ||
+      memcmp(magic, journal_magic, sizeof(magic)) != 0)
+  {
+    return false;
+  }
+
+  off_t off = sizeof(journal_magic);
+  string rec;
+  for (;;)
+  {
+    unsigned char hdr[record_header];
+    if (off + (off_t) record_header > st.st_size ||
+        pread(fd, hdr, record_header, off) != (ssize_t) record_header)
+    {
+      break;
+    }
+    uint32_t len;
+    uint64_t key;
+    memcpy(&len, hdr, 4);
+    memcpy(&key, hdr + 8, 8);
+    if (off + (off_t) (len + record_overhead) > st.st_size)
+    {
+      break;
+    }
+    rec.resize(len + record_trailer);
+    if (pread(fd, &rec[0], rec.size(), off + record_header) != (ssize_t) rec.size())
+    {
+      break;
+    }
+    uint32_t crc;
+    memcpy(&crc, &rec[len], 4);
+    if (crc32((const unsigned char *) rec.data(), len,
+              crc32(hdr + 4, record_header - 4, 0)) != crc)
+    {
+      break;
+    }
+
+    off_t payload = off + record_header;
+    if (hdr[4] == Journal_point)
+    {
+      point_off[key] = make_pair(payload, len);
+    }
+    else if (hdr[4] == Journal_pass && len >= 5)
+    {
+      uint32_t pass;
+      memcpy(&pass, rec.data(), 4);
+      pass_off[make_pair(key, pass)] = make_pair(payload, len);
+    }
+    off += len + record_overhead;
+  }
+
+  if (off < st.st_size)
+  {
+    bytes_dropped = st.st_size - off;
+    if (!read_only && (ftruncate(fd, off) != 0 || fdatasync(fd) != 0))
+    {
+      return false;
+    }
+  }
+  end = off;
+
+  // the candidates of finished points are not needed again
+  for (map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> >::iterator it = pass_off.begin();
+       it != pass_off.end(); )
+  {
+    if (point_off.count(it->first.first)) pass_off.erase(it++);
+    else ++it;
+  }
+
+  live_bytes = sizeof(journal_magic);
+  for (map<uint64_t, pair<off_t, uint32_t> >::iterator it = point_off.begin(); it != point_off.end(); ++it)
+  {
+    live_bytes += it->second.second + record_overhead;
+  }
+  for (map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> >::iterator it = pass_off.begin();
+       it != pass_off.end(); ++it)
+  {
+    live_bytes += it->second.second + record_overhead;
+  }
+  dead_bytes = end - live_bytes;
+  if (dead_bytes > live_bytes && !read_only)
+  {
+    compact();
+  }
+  return true;
+}
+
+
+
+// copies the live records to path.tmp and renames it over path; on any
+// failure the journal is left as it was
+bool sweep_journal::compact()
+{
+  if (dead_bytes == 0)
+  {
+    return true;
+  }
+
+  string tmp = path + ".tmp";
+  int nfd = ::open(tmp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  off_t noff = sizeof(journal_magic);
+  map<uint64_t, pair<off_t, uint32_t> > npoint = point_off;
+  map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> > npass = pass_off;
+  bool ok = (nfd >= 0 &&
+             pwrite(nfd, journal_magic, sizeof(journal_magic), 0) == (ssize_t) sizeof(journal_magic));
+  string rec;
+
+  for (map<uint64_t, pair<off_t, uint32_t> >::iterator it = npoint.begin(); ok && it != npoint.end(); ++it)
+  {
+    rec.resize(it->second.second + record_overhead);
+    ok = (pread(fd, &rec[0], rec.size(), it->second.first - record_header) == (ssize_t) rec.size() &&
+          pwrite(nfd, rec.data(), rec.size(), noff) == (ssize_t) rec.size());
+    it->second.first = noff + record_header;
+    noff += rec.size();
+  }
+  for (map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> >::iterator it = npass.begin();
+       ok && it != npass.end(); ++it)
+  {
+    rec.resize(it->second.second + record_overhead);
+    ok = (pread(fd, &rec[0], rec.size(), it->second.first - record_header) == (ssize_t) rec.size() &&
+          pwrite(nfd, rec.data(), rec.size(), noff) == (ssize_t) rec.size());
+    it->second.first = noff + record_header;
+    noff += rec.size();
+  }
+  ok = ok && fdatasync(nfd) == 0 && rename(tmp.c_str(), path.c_str()) == 0;
+  if (!ok)
+  {
+    if (nfd >= 0) close(nfd);
+    unlink(tmp.c_str());
+    return false;
+  }
+
+  // make the rename itself durable
+  string dir = (path.find('/') == string::npos) ? "." : path.substr(0, path.rfind('/') + 1);
+  int dfd = ::open(dir.c_str(), O_RDONLY);
+  if (dfd >= 0)
+  {
+    fsync(dfd);
+    close(dfd);
+  }
+
+  close(fd);
+  fd = nfd;
+  end = live_bytes = noff;
+  dead_bytes = 0;
+  point_off.swap(npoint);
+  pass_off.swap(npass);
+  return true;
+}
+
+
+
+void sweep_journal::drop_passes(uint64_t key)
+{
+  map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> >::iterator it =
+    pass_off.lower_bound(make_pair(key, (uint32_t) 0));
+
+  while (it != pass_off.end() && it->first.first == key)
+  {
+    live_bytes -= it->second.second + record_overhead;
+    dead_bytes += it->second.second + record_overhead;
+    pass_off.erase(it++);
+  }
+}
+
+
+
+void sweep_journal::append(uint8_t type, uint64_t key, const string & payload)
+{
+  string rec;
+  put<uint32_t>(rec, payload.size());
+  put<uint8_t>(rec, type);
+  rec.append(3, '\0');
+  put<uint64_t>(rec, key);
+  rec += payload;
+  put<uint32_t>(rec, crc32((const unsigned char *) rec.data() + 4, rec.size() - 4, 0));
+
+  size_t done = 0;
+  while (done < rec.size())
+  {
+    ssize_t n = pwrite(fd, rec.data() + done, rec.size() - done, end + done);
+    if (n <= 0)
+    {
+      cout << "ERROR: cannot append to the sweep journal" << endl;
+      exit(1);
+    }
+    done += n;
+  }
+  if (fdatasync(fd) != 0)
+  {
+    cout << "ERROR: cannot sync the sweep journal" << endl;
+    exit(1);
+  }
+
+  pair<off_t, uint32_t> & entry = (type == Journal_point) ? point_off[key] :
+                                  pass_off[make_pair(key, cur_pass - 1)];
+  if (entry.second != 0)
+  {
+    live_bytes -= entry.second + record_overhead;
+    dead_bytes += entry.second + record_overhead;
+  }
+  entry = make_pair(end + record_header, (uint32_t) payload.size());
+  end += rec.size();
+  live_bytes += rec.size();
+}
+
+
+
+bool sweep_journal::read_payload(off_t off, uint32_t len, string & payload) const
+{
+  payload.resize(len);
+  return len == 0 || pread(fd, &payload[0], len, off) == (ssize_t) len;
+}
+
+
+
+bool sweep_journal::point_done(uint64_t key, string * label, uint32_t * index,
+                               vector<double> * values, string * error) const
+{
+  map<uint64_t, pair<off_t, uint32_t> >::const_iterator it = point_off.find(key);
+  string payload;
+
+  if (it == point_off.end())
+  {
+    return false;
+  }
+  if (label == NULL && index == NULL && values == NULL && error == NULL)
+  {
+    return true;
+  }
+  if (!read_payload(it->second.first, it->second.second, payload))
+  {
+    return false;
+  }
+
+  const char * p = payload.data();
+  uint32_t idx = get<uint32_t>(p);
+  uint32_t label_len = get<uint32_t>(p);
+  if (index) *index = idx;
+  if (label) label->assign(p, label_len);
+  p += label_len;
+  uint32_t n = get<uint32_t>(p);
+  if (values)
+  {
+    values->resize(n);
+    for (uint32_t i = 0; i < n; i++) (*values)[i] = get<double>(p);
+  }
+  else
+  {
+    p += n*sizeof(double);
+  }
+  // the error message is appended only for a failed point
+  if (error)
+  {
+    error->clear();
+    if (p < payload.data() + payload.size())
+    {
+      uint32_t error_len = get<uint32_t>(p);
+      error->assign(p, error_len);
+    }
+  }
+  return true;
+}
+
+
+
+void sweep_journal::record_point(uint64_t key, const string & label, uint32_t index,
+                                 const vector<double> & values, const string & error)
+{
+  string payload;
+  put<uint32_t>(payload, index);
+  put<uint32_t>(payload, label.size());
+  payload += label;
+  put<uint32_t>(payload, values.size());
+  for (uint32_t i = 0; i < values.size(); i++) put<double>(payload, values[i]);
+  if (error != "")
+  {
+    put<uint32_t>(payload, error.size());
+    payload += error;
+  }
+  append(Journal_point, key, payload);
+
+  drop_passes(key);
+  if (dead_bytes > compact_min_dead && dead_bytes > live_bytes)
+  {
+    compact();
+  }
+}
+
+
+
+void sweep_journal::point_keys(vector<uint64_t> & keys) const
+{
+  keys.clear();
+  for (map<uint64_t, pair<off_t, uint32_t> >::const_iterator it = point_off.begin(); it != point_off.end(); ++it)
+  {
+    keys.push_back(it->first);
+  }
+}
+
+
+
+void sweep_journal::begin_point(uint64_t key)
+{
+  cur_key         = key;
+  cur_pass        = 0;
+  passes_restored = 0;
+}
+
+
+
+bool sweep_journal::restore_pass(bool is_tag, calc_time_mt_wrapper_struct * calc_array)
+{
+  map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> >::const_iterator it =
+    pass_off.find(make_pair(cur_key, cur_pass++));
+  string payload;
+
+  if (it == pass_off.end() ||
+      !read_payload(it->second.first, it->second.second, payload) ||
+      (payload.size() - 5) % candidate_size != 0 ||
+      (payload[4] != 0) != is_tag)
+  {
+    return false;
+  }
+
+  calc_time_mt_wrapper_struct & c = calc_array[0];
+  const char * p = payload.data() + 5;
+  mem_array_metrics m;
+  while (p < payload.data() + payload.size())
+  {
+    uint8_t kind = get_candidate(p, &m);
+    int wt0 = get<uint8_t>(p);
+    int nwt = get<uint8_t>(p);
+    list<mem_array_metrics *> & l = (kind == 0) ? c.tag_arr : c.data_arr;
+    ((kind == 0) ? c.tag_res : c.data_res)->update_min_values(&m);
+    for (int wr = wt0; wr < wt0 + nwt; wr++)
+    {
+      l.push_back(new mem_array_metrics(m));
+      l.back()->wt = (enum Wire_type) wr;
+    }
+  }
+  passes_restored++;
+  return true;
+}
+
+
+
+void sweep_journal::record_pass(bool is_tag, const calc_time_mt_wrapper_struct * calc_array, uint32_t n)
+{
+  string payload;
+  put<uint32_t>(payload, cur_pass - 1);
+  put<uint8_t>(payload, is_tag);
+  for (uint32_t t = 0; t < n; t++)
+  {
+    put_candidates(payload, 0, calc_array[t].tag_arr);
+    put_candidates(payload, 1, calc_array[t].data_arr);
+  }
+  append(Journal_pass, cur_key, payload);
+}
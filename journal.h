@@ -0,0 +1,136 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __JOURNAL_H__
+#define __JOURNAL_H__
+
+#include <stdint.h>
+#include <sys/types.h>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct calc_time_mt_wrapper_struct;
+
+
+enum Journal_record
+{
+  Journal_pass  = 1,   // candidate lists of one array pass of a point
+  Journal_point = 2    // result of a finished point
+};
+
+
+/*
+ * Append-only checkpoint journal of a design-space sweep. Every record is
+ * built in memory, written at the end of the file with pwrite() (repeated
+ * until all of it is written) and fdatasync()ed:
+ *
+ *   uint32 payload length | uint8 type | 3 x 0 | uint64 point key | payload | uint32 CRC-32
+ *
+ * The CRC covers everything from the type byte to the end of the payload.
+ * open() replays the file and truncates it at the first short or corrupt
+ * record, so a crash in the middle of an append only loses that record.
+ *
+ * Within a point, solve() numbers its array passes in the order it runs them
+ * (a NUCA point solves several bank sizes). A pass found in the journal is
+ * restored instead of swept, so a point cut short resumes after its last
+ * completed pass. Candidates are stored once per partition with their run
+ * of wire types. The passes of a finished point are dead weight; once they
+ * outgrow the live records the journal is rewritten into a temporary file
+ * that then replaces it. The records are in host byte order.
+ */
+class sweep_journal
+{
+  public:
+    sweep_journal();
+    ~sweep_journal();
+
+    // returns false if file cannot be opened or is not a journal; a
+    // read_only journal is neither created, truncated nor compacted
+    bool open(const string & file, bool read_only = false);
+    // rewrites the journal without the candidates of finished points
+    bool compact();
+
+    // result of a finished point: its label, index in the sweep and fields,
+    // or for a point that failed no fields and the error message
+    bool point_done(uint64_t key, string * label = NULL, uint32_t * index = NULL,
+                    vector<double> * values = NULL, string * error = NULL) const;
+    void record_point(uint64_t key, const string & label, uint32_t index,
+                      const vector<double> & values, const string & error = "");
+    void point_keys(vector<uint64_t> & keys) const;
+
+    // passes of solve() are keyed to this point from here on
+    void begin_point(uint64_t key);
+    // called by solve() for each array pass: restore_pass() refills
+    // calc_array[0] if the pass is journaled, record_pass() appends it
+    bool restore_pass(bool is_tag, calc_time_mt_wrapper_struct * calc_array);
+    void record_pass(bool is_tag, const calc_time_mt_wrapper_struct * calc_array, uint32_t n);
+
+    uint32_t passes_restored;   // since begin_point()
+    uint64_t bytes_dropped;     // torn tail cut off (read_only: ignored) by open()
+
+  private:
+    string   path;
+    int      fd;
+    off_t    end;
+    uint64_t live_bytes;        // records still referenced, magic included
+    uint64_t dead_bytes;
+    uint64_t cur_key;
+    uint32_t cur_pass;
+
+    // payload offset and length of the live records
+    map<uint64_t, pair<off_t, uint32_t> > point_off;
+    map<pair<uint64_t, uint32_t>, pair<off_t, uint32_t> > pass_off;
+
+    void append(uint8_t type, uint64_t key, const string & payload);
+    bool read_payload(off_t off, uint32_t len, string & payload) const;
+    void drop_passes(uint64_t key);
+};
+
+// set while a sweep point is solved, NULL otherwise
+extern sweep_journal * solve_journal;
+
+// 64-bit FNV-1a, chained through h
+uint64_t fnv1a64(const void * buf, size_t len, uint64_t h = 0xcbf29ce484222325ULL);
+
+#endif
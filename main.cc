@@ -40,12 +40,22 @@
  *------------------------------------------------------------*/
 
 #include "io.h"
+#include "bench.h"
+#include "golden.h"
+#include "hier.h"
+#include "whatif.h"
+#include "dump.h"
+#include "sweep.h"
+#include "Ucache.h"
 #include <iostream>
+#include <vector>
+#include <string.h>
+#include <stdio.h>
 
 using namespace std;
 
 
-int main(int argc,char *argv[])
+static int run_main(int argc,char *argv[])
 {
 
   uca_org_t result;
@@ -53,22 +63,188 @@ int main(int argc,char *argv[])
   {
     bool infile_specified = false;
     string infile_name("");
+    bool bench = false;
+    string bench_out("bench_baseline.csv");
+    uint32_t bench_warmup = 1;
+    uint32_t bench_reps   = 5;
+    string golden_dir("");
+    bool golden_record = false;
+    uint32_t golden_jobs = 4;
+    double golden_rtol = 1e-9;
+    vector<uint32_t> golden_threads;
+    string sweep_list("");
+    string sweep_journal_file("");
+    string sweep_out("");
+    uint32_t shard = 0, nshards = 1;
+    vector<string> merge_journals;
+    string hier_file("");
+    string whatif_file("");
+    string dump_csv_file("");
 
     for (int32_t i = 0; i < argc; i++)
     {
-      if (argv[i] == string("-infile"))
+      if (argv[i] == string("-infile") && i+1 < argc)
       {
         infile_specified = true;
         i++;
         infile_name = argv[i];
       }
+      else if (argv[i] == string("-nthreads") && i+1 < argc)
+      {
+        i++;
+        nthreads = atoi(argv[i]);
+        if (nthreads < 1) nthreads = 1;
+      }
+      else if (argv[i] == string("-bench"))
+      {
+        bench = true;
+      }
+      else if (argv[i] == string("-bench_out") && i+1 < argc)
+      {
+        i++;
+        bench_out = argv[i];
+      }
+      else if (argv[i] == string("-warmup") && i+1 < argc)
+      {
+        i++;
+        bench_warmup = atoi(argv[i]);
+      }
+      else if (argv[i] == string("-reps") && i+1 < argc)
+      {
+        i++;
+        bench_reps = atoi(argv[i]);
+      }
+      else if ((argv[i] == string("-golden_check") || argv[i] == string("-golden_record")) && i+1 < argc)
+      {
+        golden_record = (argv[i] == string("-golden_record"));
+        i++;
+        golden_dir = argv[i];
+      }
+      else if (argv[i] == string("-golden_jobs") && i+1 < argc)
+      {
+        i++;
+        golden_jobs = atoi(argv[i]);
+      }
+      else if (argv[i] == string("-golden_rtol") && i+1 < argc)
+      {
+        i++;
+        golden_rtol = atof(argv[i]);
+      }
+      else if (argv[i] == string("-golden_threads") && i+1 < argc)
+      {
+        // comma separated list, e.g. 1,3,16
+        i++;
+        char * tok = strtok(argv[i], ",");
+        while (tok != NULL)
+        {
+          if (atoi(tok) > 0) golden_threads.push_back(atoi(tok));
+          tok = strtok(NULL, ",");
+        }
+      }
+      else if (argv[i] == string("-sweep") && i+1 < argc)
+      {
+        i++;
+        sweep_list = argv[i];
+      }
+      else if (argv[i] == string("-journal") && i+1 < argc)
+      {
+        i++;
+        sweep_journal_file = argv[i];
+      }
+      else if (argv[i] == string("-sweep_out") && i+1 < argc)
+      {
+        i++;
+        sweep_out = argv[i];
+      }
+      else if (argv[i] == string("-shard") && i+1 < argc)
+      {
+        i++;
+        if (sscanf(argv[i], "%u/%u", &shard, &nshards) != 2 || nshards == 0 || shard >= nshards)
+        {
+          cerr << "Invalid shard " << argv[i] << ", expected <i>/<N> with 0 <= i < N" << endl;
+          exit(1);
+        }
+      }
+      else if (argv[i] == string("-sweep_merge"))
+      {
+        // every following argument up to the next option is a journal
+        while (i+1 < argc && argv[i+1][0] != '-')
+        {
+          merge_journals.push_back(argv[++i]);
+        }
+      }
+      else if (argv[i] == string("-hierarchy") && i+1 < argc)
+      {
+        i++;
+        hier_file = argv[i];
+      }
+      else if (argv[i] == string("-whatif") && i+1 < argc)
+      {
+        i++;
+        whatif_file = argv[i];
+      }
+      else if (argv[i] == string("-dump_csv") && i+1 < argc)
+      {
+        i++;
+        dump_csv_file = argv[i];
+      }
     }
 
-    if (infile_specified == false)
+    if (bench)
+    {
+      run_bench(bench_out, bench_warmup, bench_reps);
+    }
+    else if (golden_dir != "")
+    {
+      if (golden_threads.empty())
+      {
+        golden_threads.push_back(1);
+        golden_threads.push_back(3);
+        golden_threads.push_back(nthreads);
+      }
+      int nfail = golden_record ? record_golden(golden_dir, golden_jobs) :
+                  check_golden(golden_dir, golden_jobs, golden_rtol, golden_threads);
+      return (nfail != 0);
+    }
+    else if (hier_file != "")
+    {
+      run_hierarchy(hier_file);
+    }
+    else if (whatif_file != "")
+    {
+      run_whatif(whatif_file);
+    }
+    else if (dump_csv_file != "")
+    {
+      return dump_to_csv(dump_csv_file);
+    }
+    else if (sweep_list != "" && merge_journals.empty() == false)
+    {
+      if (sweep_out == "") sweep_out = "sweep_results.csv";
+      return (merge_sweep(sweep_list, merge_journals, sweep_out) != 0);
+    }
+    else if (sweep_list != "")
+    {
+      // every shard gets its own files by default
+      char suffix[64] = "";
+      if (nshards > 1) snprintf(suffix, sizeof(suffix), ".shard%uof%u", shard, nshards);
+      if (sweep_journal_file == "") sweep_journal_file = sweep_list + suffix + ".journal";
+      if (sweep_out == "") sweep_out = string("sweep_results") + suffix + ".csv";
+      run_sweep(sweep_list, sweep_journal_file, sweep_out, shard, nshards);
+    }
+    else if (infile_specified == false)
     {
       cerr << " Invalid arguments -- how to use CACTI:" << endl;
-      cerr << "  1) cacti -infile <input file name>" << endl;
+      cerr << "  1) cacti -infile <input file name> [-nthreads <n>]" << endl;
       cerr << "  2) cacti arg1 ... arg54 -- please refer to the README file" << endl;
+      cerr << "  3) cacti -bench [-nthreads <n>] [-warmup <n>] [-reps <n>] [-bench_out <csv file>]" << endl;
+      cerr << "  4) cacti -golden_record <dir> | -golden_check <dir> [-golden_jobs <n>] [-golden_rtol <x>]" << endl;
+      cerr << "           [-golden_threads <n1,n2,...>]" << endl;
+      cerr << "  5) cacti -sweep <list file> [-shard <i>/<N>] [-journal <file>] [-sweep_out <csv file>] [-nthreads <n>]" << endl;
+      cerr << "  6) cacti -sweep <list file> -sweep_merge <journal> ... [-sweep_out <csv file>]" << endl;
+      cerr << "  7) cacti -hierarchy <hierarchy file> [-nthreads <n>]" << endl;
+      cerr << "  8) cacti -whatif <input file name> [-nthreads <n>]   (edits on stdin)" << endl;
+      cerr << "  9) cacti -dump_csv <candidate dump>" << endl;
       cerr << " No. of arguments input - " << argc << endl;
       exit(1);
     }
@@ -139,3 +315,17 @@ int main(int argc,char *argv[])
   return 0;
 }
 
+
+
+int main(int argc,char *argv[])
+{
+  try
+  {
+    return run_main(argc, argv);
+  }
+  catch (const cacti_error & e)
+  {
+    cout << "ERROR: " << e.msg << endl;
+    return e.status;
+  }
+}
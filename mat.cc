@@ -40,6 +40,7 @@
  *------------------------------------------------------------*/
 
 #include "mat.h"
+#include "sram_cell.h"
 #include <assert.h>
 
 
@@ -59,6 +60,7 @@ Mat::Mat(const DynamicParameter & dyn_p)
   leak_power_sense_amps_open_page_state(0),
   delay_subarray_out_drv(0), 
   delay_comparator(0), power_comparator(), num_do_b_mat(dyn_p.num_do_b_mat),
+  delay_budget(BIGNUM), eval_abort(Eval_complete),
   num_subarrays_per_mat(dp.num_subarrays/dp.num_mats),
   num_subarrays_per_row(dp.Ndwl/dp.num_mats_h_dir)
 {
@@ -428,11 +430,42 @@ double Mat::compute_delays(double inrisetime)
 
   outrisetime = compute_bitline_delay(row_dec_outrisetime);  //Francesco: delay value of RWL is used (for 8T and 10T SRAM cell) as input
   outrisetime = compute_sa_delay(outrisetime);
+
+  // UCA::compute_delays takes MAX(row_path, col_path), and MAX drops the row
+  // path when the column path is NaN, so the row path only bounds the access
+  // time from below once the column path is known to be a number
+  double col_path = b_mux_predec->delay + bit_mux_dec->delay + delay_sa;
+  double path_delay = (col_path == col_path) ? col_path : 0;
+  if (col_path == col_path)
+  {
+    double row_path[3] = {r_predec->delay + row_dec->delay, delay_bitline, delay_sa};
+    double sum = 0;
+    for (int i = 0; i < 3; i++)
+    {
+      sum += row_path[i];
+      if (sum > delay_budget)
+      {
+        eval_abort = Eval_abort_row_path + i;
+        return 0;
+      }
+    }
+    path_delay = MAX(path_delay, sum);
+  }
+  if (path_delay > delay_budget)
+  {
+    eval_abort = Eval_abort_sense_amp;
+    return 0;
+  }
   outrisetime = compute_subarray_out_drv(outrisetime);
   subarray_out_wire->set_in_rise_time(outrisetime);
   outrisetime = subarray_out_wire->signal_rise_time();
 
   delay_subarray_out_drv_htree = delay_subarray_out_drv + subarray_out_wire->delay;
+  if (path_delay + delay_subarray_out_drv_htree > delay_budget)
+  {
+    eval_abort = Eval_abort_output;
+    return 0;
+  }
 
   if (dp.is_tag == true && g_ip->fully_assoc == false)
   {
@@ -522,33 +555,34 @@ void Mat::delay_fa_tag(
 
   dynPower = 0.0;
 
-  Wdecdrivep    =  450 * g_ip->F_sz_um;//this was 360 micron for the 0.8 micron process
-  Wdecdriven    =  300 * g_ip->F_sz_um;//this was 240 micron for the 0.8 micron process
-  Wfadriven     = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process
-  Wfadrivep     =  125 * g_ip->F_sz_um;//this was 100 micron for the 0.8 micron process
-  Wfadrive2n    =  250 * g_ip->F_sz_um;//this was 200 micron for the 0.8 micron process
-  Wfadrive2p    =  500 * g_ip->F_sz_um;//this was 400 micron for the 0.8 micron process
-  Wfadecdrive1n = 6.25 * g_ip->F_sz_um;//this was   5 micron for the 0.8 micron process
-  Wfadecdrive1p = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
-  Wfadecdrive2n =   25 * g_ip->F_sz_um;//this was  20 micron for the 0.8 micron process
-  Wfadecdrive2p =   50 * g_ip->F_sz_um;//this was  40 micron for the 0.8 micron process  
-  Wfadecdriven  = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process
-  Wfadecdrivep  =  125 * g_ip->F_sz_um;//this was 100 micron for the 0.8 micron process
-  Wfaprechn     =  7.5 * g_ip->F_sz_um;//this was   6 micron for the 0.8 micron process
-  Wfaprechp     = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
-  Wdummyn       = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
-  Wdummyinvn    =   75 * g_ip->F_sz_um;//this was  60 micron for the 0.8 micron process  
-  Wdummyinvp    =  100 * g_ip->F_sz_um;//this was  80 micron for the 0.8 micron process
-  Wfainvn       = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process  
-  Wfainvp       =   25 * g_ip->F_sz_um;//this was  20 micron for the 0.8 micron process  
-  Waddrnandn    = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process  
-  Waddrnandp    = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process  
-  Wfanandn      =   25 * g_ip->F_sz_um;//this was  20 micron for the 0.8 micron process  
-  Wfanandp      = 37.5 * g_ip->F_sz_um;//this was  30 micron for the 0.8 micron process
-  Wfanorn       = 6.25 * g_ip->F_sz_um;//this was   5 micron for the 0.8 micron process  
-  Wfanorp       = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
-  Wdecnandn     = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process  
-  Wdecnandp     = 37.5 * g_ip->F_sz_um;//this was  30 micron for the 0.8 micron process
+  const TechnologyParameter::CamType & cam = g_tp.fa_cam;
+  Wdecdrivep    = cam.w_dec_drive_p;
+  Wdecdriven    = cam.w_dec_drive_n;
+  Wfadriven     = cam.w_fa_drive_n;
+  Wfadrivep     = cam.w_fa_drive_p;
+  Wfadrive2n    = cam.w_fa_drive2_n;
+  Wfadrive2p    = cam.w_fa_drive2_p;
+  Wfadecdrive1n = cam.w_fa_dec_drive1_n;
+  Wfadecdrive1p = cam.w_fa_dec_drive1_p;
+  Wfadecdrive2n = cam.w_fa_dec_drive2_n;
+  Wfadecdrive2p = cam.w_fa_dec_drive2_p;
+  Wfadecdriven  = cam.w_fa_dec_drive_n;
+  Wfadecdrivep  = cam.w_fa_dec_drive_p;
+  Wfaprechn     = cam.w_fa_prech_n;
+  Wfaprechp     = cam.w_fa_prech_p;
+  Wdummyn       = cam.w_dummy_n;
+  Wdummyinvn    = cam.w_dummy_inv_n;
+  Wdummyinvp    = cam.w_dummy_inv_p;
+  Wfainvn       = cam.w_fa_inv_n;
+  Wfainvp       = cam.w_fa_inv_p;
+  Waddrnandn    = cam.w_addr_nand_n;
+  Waddrnandp    = cam.w_addr_nand_p;
+  Wfanandn      = cam.w_fa_nand_n;
+  Wfanandp      = cam.w_fa_nand_p;
+  Wfanorn       = cam.w_fa_nor_n;
+  Wfanorp       = cam.w_fa_nor_p;
+  Wdecnandn     = cam.w_dec_nand_n;
+  Wdecnandp     = cam.w_dec_nand_p;
 
   Htagbits = (int)(ceil ((double) (tagbits) / 2.0));
 
@@ -638,6 +672,7 @@ double Mat::compute_comparators_height(
 }
 
 
+template <class Cell>
 double Mat::compute_bitline_delay(double inrisetime)
 {
   double V_b_pre, v_th_mem_cell, V_wl;
@@ -671,16 +706,8 @@ double Mat::compute_bitline_delay(double inrisetime)
     V_b_pre = g_tp.sram.Vbitpre;
     v_th_mem_cell = g_tp.sram_cell.Vth;
     V_wl = g_tp.sram_cell.Vdd;
-    if (g_ip->sram_cell_design.getType() == std_10T) { //Francesco
-      R_cell_pull_down = tr_R_on(g_tp.sram.cell_iso_w, NCH, 1, false, true);
-		  R_cell_acc = tr_R_on(g_tp.sram.cell_readacc_w, NCH, 1, false, true);
-    } else if (g_ip->sram_cell_design.getType() == std_8T) {
-      R_cell_pull_down = tr_R_on(g_tp.sram.cell_rd_iso_w, NCH, 1, false, true);
-		  R_cell_acc = tr_R_on(g_tp.sram.cell_rd_a_w, NCH, 1, false, true);
-    } else {
-      R_cell_pull_down = tr_R_on(g_tp.sram.cell_nmos_w, NCH, 1, false, true);
-		  R_cell_acc = tr_R_on(g_tp.sram.cell_a_w, NCH, 1, false, true);
-    }
+    R_cell_pull_down = Cell::R_pull_down();
+    R_cell_acc       = Cell::R_acc();
 	
 	  //Leakage current of an SRAM cell
     // Alireza - Begin
@@ -695,19 +722,7 @@ double Mat::compute_bitline_delay(double inrisetime)
     // Alireza - End
     //leak_power_RD_port_sram_cell = leak_power_acc_tr_RW_or_WR_port_sram_cell * NAND2_LEAK_STACK_FACTOR;
     
-    //Francesco start
-    if (g_ip->sram_cell_design.getType() == std_10T) {
-      double Ileak_a2 = cmos_Ileak(g_tp.sram.cell_readacc_w, 0,  false, true);
-      double Ileak_a1 = cmos_Ileak(g_tp.sram.cell_acc_w, 0,  false, true);
-      leak_power_acc_tr_RW_or_WR_port_sram_cell = g_tp.sram_cell.Vdd * (Ileak_a2 + Ileak_a1);
-      leak_power_RD_port_sram_cell = g_tp.sram_cell.Vdd * (Ileak_a2 * LEAK_STACK_FACTOR);
-    } else if (g_ip->sram_cell_design.getType() == std_8T) {
-      leak_power_acc_tr_RW_or_WR_port_sram_cell = g_ip->sram_cell_design.getPleakAccTx(g_tp.sram_cell.Vdd, g_tp.sram_cell.H_fin);
-      leak_power_RD_port_sram_cell = leak_power_acc_tr_RW_or_WR_port_sram_cell * NAND2_LEAK_STACK_FACTOR;
-    } else { //Francesco: for 6T SRAM cell
-      leak_power_acc_tr_RW_or_WR_port_sram_cell = g_ip->sram_cell_design.getPleakAccTx(g_tp.sram_cell.Vdd, g_tp.sram_cell.H_fin);
-    }
-    //Francesco end
+    Cell::port_leakage(leak_power_acc_tr_RW_or_WR_port_sram_cell, leak_power_RD_port_sram_cell);
     
   }
 
@@ -737,10 +752,11 @@ double Mat::compute_bitline_delay(double inrisetime)
   }
   else
   {
-    double tau;
+    double tau, C_cell_path;
 	  double trip_point=0.3; // trip_point models the trip point voltage of the skewed inverter: trip_point*Vdd is the voltage drop on RBL 
     if (deg_bl_muxing > 1) { 
   
+      C_cell_path = C_bl + 2*C_drain_bit_mux + 2*C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux;
       tau = (R_cell_pull_down + R_cell_acc) *
         (C_bl + 2*C_drain_bit_mux + 2*C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux) +
         R_bl * (C_bl/2 + 2*C_drain_bit_mux + 2*C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux) +
@@ -753,10 +769,11 @@ double Mat::compute_bitline_delay(double inrisetime)
         2 * dp.V_b_sense * g_tp.sram_cell.Vdd * (subarray.num_cols * num_subarrays_per_mat / deg_bl_muxing);
 		
       //Fabio start // for 8T cell, we do not have a iso PMOS in the precharge circuit
-		  if (g_ip->sram_cell_design.getType() == std_8T) {
+		  if (Cell::skewed_inv_sa) {
 			
 		    C_sense_amp_latch = gate_C(g_tp.w_skewed_inv_n + g_tp.w_skewed_inv_p, 0, is_dram); // if 8T, the latch SA is replaced by a skewed inverter	
 		
+		    C_cell_path = C_bl + 2*C_drain_bit_mux + 1*C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux;
 		    tau = (R_cell_pull_down + R_cell_acc) *
           (C_bl + 2*C_drain_bit_mux + 1*C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux) +
           R_bl * (C_bl/2 + 2*C_drain_bit_mux + 1*C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux) +
@@ -777,6 +794,7 @@ double Mat::compute_bitline_delay(double inrisetime)
     }
     else
     {
+      C_cell_path = C_bl + C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux;
       tau = (R_cell_pull_down + R_cell_acc) * 
         (C_bl + C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux) + R_bl * C_bl / 2 +
         R_sense_amp_iso * (C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux);
@@ -787,8 +805,9 @@ double Mat::compute_bitline_delay(double inrisetime)
       
 	  
 		  //Fabio start
-		  if (g_ip->sram_cell_design.getType() == std_8T) {
+		  if (Cell::skewed_inv_sa) {
         C_sense_amp_latch = gate_C(g_tp.w_skewed_inv_n + g_tp.w_skewed_inv_p, 0, is_dram); // if 8T, the latch SA is replaced by a skewed inverter	
+			  C_cell_path = C_bl + C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux;
 			  tau = (R_cell_pull_down + R_cell_acc) * 
 			    (C_bl + C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux) + R_bl * C_bl / 2 +
 			    R_sense_amp_iso * (C_drain_sense_amp_iso + C_sense_amp_latch + C_drain_sense_amp_mux);
@@ -806,7 +825,7 @@ double Mat::compute_bitline_delay(double inrisetime)
     }
     tstep = tau * log(V_b_pre / (V_b_pre - dp.V_b_sense));
 	  //Fabio start
-	  if (g_ip->sram_cell_design.getType() == std_8T) {	
+	  if (Cell::skewed_inv_sa) {	
 		tstep = tau * log(V_b_pre / (V_b_pre - 0.5*trip_point*g_tp.sram_cell.Vdd)); // for 8T SRAM cell: 0.5 due to the same strategy adopted for tau with dp.V_b_sense (i.e. 50% of the BL swing)
 	  }
 	  // Fabio end
@@ -819,6 +838,20 @@ double Mat::compute_bitline_delay(double inrisetime)
       leak_power_acc_tr_RW_or_WR_port_sram_cell + 
       leak_power_acc_tr_RW_or_WR_port_sram_cell * (RWP + EWP - 1) +
       leak_power_RD_port_sram_cell * ERP;
+
+    bl_terms.R_pull_down = R_cell_pull_down;
+    bl_terms.R_acc       = R_cell_acc;
+    bl_terms.C_cell_path = C_cell_path;
+    bl_terms.tau_rest    = tau - (R_cell_pull_down + R_cell_acc) * C_cell_path;
+    bl_terms.log_swing   = tstep / tau;
+    bl_terms.V_wl        = V_wl;
+    bl_terms.v_th        = v_th_mem_cell;
+    bl_terms.inrisetime  = inrisetime;
+    bl_terms.leak_cc     = leak_power_cc_inverters_sram_cell;
+    bl_terms.leak_acc    = leak_power_acc_tr_RW_or_WR_port_sram_cell;
+    bl_terms.leak_rd     = leak_power_RD_port_sram_cell;
+    bl_terms.n_wr_ports  = RWP + EWP;
+    bl_terms.n_rd_ports  = ERP;
   }
 
   // take input rise time into account
@@ -840,12 +873,6 @@ double Mat::compute_bitline_delay(double inrisetime)
     power_bitline.writeOp.dynamic = dynWriteEnergy;
   }
 
-// Fabio start
-cout<<"C_bl; 2 * C_drain_sense_amp_iso; C_sense_amp_latch; C_drain_sense_amp_mux: "<<C_bl<<" - "<<(2 * C_drain_sense_amp_iso)<<" - "<<C_sense_amp_latch<<" - "<<C_drain_sense_amp_mux<<endl;
-cout<<"dp.V_b_sense; g_tp.sram_cell.Vdd; subarray.num_cols; num_subarrays_per_mat: "<<dp.V_b_sense<<" - "<<g_tp.sram_cell.Vdd<<" - "<<subarray.num_cols<<" - "<<num_subarrays_per_mat<<endl;
-
-
-// Fabio ends	
 
 
   double outrisetime = 0; 
@@ -854,6 +881,7 @@ cout<<"dp.V_b_sense; g_tp.sram_cell.Vdd; subarray.num_cols; num_subarrays_per_ma
 
 
 
+template <class Cell>
 double Mat::compute_sa_delay(double inrisetime)
 {
   int num_sa_subarray = subarray.num_cols / deg_bl_muxing; //in a subarray
@@ -884,7 +912,7 @@ double Mat::compute_sa_delay(double inrisetime)
   double tau = C_ld / g_tp.gm_sense_amp_latch;
   delay_sa = tau * log(g_tp.peri_global.Vdd / dp.V_b_sense);
   //Fabio start -- 8T has a skewed INV as sense amplifier
-  if (g_ip->sram_cell_design.getType() == std_8T)
+  if (Cell::skewed_inv_sa)
 	{	C_ld = 	drain_C_(g_tp.w_skewed_inv_n, NCH, 1, 0, cell.w * deg_bl_muxing / (RWP + ERP), is_dram) + 
 				drain_C_(g_tp.w_skewed_inv_p, PCH, 1, 0, cell.w * deg_bl_muxing / (RWP + ERP), is_dram) + 
 				drain_C_(g_tp.w_nmos_sa_mux, NCH, 1, 0, cell.w * deg_bl_muxing / (RWP + ERP), is_dram);
@@ -899,16 +927,6 @@ double Mat::compute_sa_delay(double inrisetime)
   power_sa.readOp.dynamic = C_ld * g_tp.peri_global.Vdd * g_tp.peri_global.Vdd * num_sa_subarray *
                             num_subarrays_per_mat;// * num_act_mats_hor_dir;
 							
-// Fabio start
-
-cout<<     "C_ld : "<< C_ld<<endl;
-cout<<     "g_tp.peri_global.Vdd: "<<g_tp.peri_global.Vdd<<endl;
-cout<<     "num_sa_subarray: "<<num_sa_subarray<<endl;
-cout<<     "num_subarrays_per_mat: "<<num_subarrays_per_mat<<endl;
-cout<<     "subarray.num_rows: "<<subarray.num_rows<<endl;
-cout<<     "dp.num_subarrays: "<<dp.num_subarrays<<endl;
-cout<<     "dp.num_mats: "<<dp.num_mats<<endl;
-// Fabio end
   power_sa.readOp.leakage = lkgIdle * g_tp.peri_global.Vdd;
 
   double outrisetime = 0;  
@@ -917,6 +935,20 @@ cout<<     "dp.num_mats: "<<dp.num_mats<<endl;
 
 
 
+double Mat::compute_bitline_delay(double inrisetime)
+{
+  SRAM_CELL_DISPATCH(this, compute_bitline_delay, (inrisetime));
+}
+
+
+
+double Mat::compute_sa_delay(double inrisetime)
+{
+  SRAM_CELL_DISPATCH(this, compute_sa_delay, (inrisetime));
+}
+
+
+
 double Mat::compute_subarray_out_drv(double inrisetime)
 {
   double C_ld, rd, tf, this_delay;
@@ -47,6 +47,26 @@
 #include "wire.h"
 #include "subarray.h"
 
+// Variation-sensitive pieces of the SRAM bitline model, kept so that the
+// read delay and cell leakage can be re-evaluated for perturbed devices
+// without rebuilding the Mat (see montecarlo.cc).
+struct bitline_terms
+{
+  double R_pull_down;   // read-path pull-down (isolator for 8T/10T)
+  double R_acc;         // read-path access transistor
+  double C_cell_path;   // tau = (R_pull_down + R_acc) * C_cell_path + tau_rest
+  double tau_rest;
+  double log_swing;     // tstep = tau * log_swing
+  double V_wl;
+  double v_th;
+  double inrisetime;
+  double leak_cc;       // per-cell leakage power of the cross-coupled inverters
+  double leak_acc;      // ... of a write (or RW) port access transistor
+  double leak_rd;       // ... of a read port
+  int    n_wr_ports;    // RWP + EWP
+  int    n_rd_ports;    // ERP
+};
+
 class Mat : public Component
 {
   public:
@@ -111,6 +131,10 @@ class Mat : public Component
     int      num_do_b_mat;
     double   C_bl;
 	  double   leak_power_sram_cell; // Alireza
+    bitline_terms bl_terms;
+
+    double   delay_budget;  // access time left for the mat and its output driver
+    int      eval_abort;    // Eval_abort; set when compute_delays() ran out of delay_budget
 
     uint32_t num_subarrays_per_mat;  // the number of subarrays in a mat
     uint32_t num_subarrays_per_row;  // the number of subarrays in a row of a mat
@@ -123,6 +147,8 @@ class Mat : public Component
     void   delay_fa_tag(int tagbits, int Ntbl, bool is_dram);
     double compute_bitline_delay(double inrisetime);
     double compute_sa_delay(double inrisetime);
+    template <class Cell> double compute_bitline_delay(double inrisetime);  // see sram_cell.h
+    template <class Cell> double compute_sa_delay(double inrisetime);
     double compute_subarray_out_drv(double inrisetime);
     double compute_comparator_delay(double inrisetime);
 
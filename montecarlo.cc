@@ -0,0 +1,300 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <math.h>
+#include <pthread.h>
+
+#include "montecarlo.h"
+#include "parameter.h"
+#include "uca.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+#define MC_BATCH          4096
+#define MC_SUBTHRESHOLD_N 1.5    // subthreshold slope factor
+#define MC_KB_OVER_Q      8.617333e-5
+
+struct mc_batch_struct
+{
+  uint32_t tid;
+  uint32_t n_batches;
+  uint32_t samples;
+  const bitline_terms * bt;
+  int      nfin_pd, nfin_acc;   // read-path fins, 0 for planar CMOS
+  double * delay;               // per-sample cell read delay (s); < 0 if the read path is open
+  double * leak;                // per-sample cell leakage (W)
+};
+
+
+static inline uint64_t splitmix64(uint64_t & s)
+{
+  uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static inline double uniform01(uint64_t & s)
+{
+  return ((splitmix64(s) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// fills n standard normal deviates (Box-Muller)
+static void gaussian_fill(uint64_t & s, double * x, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i += 2)
+  {
+    double r  = sqrt(-2.0 * log(uniform01(s)));
+    double th = 2.0 * M_PI * uniform01(s);
+    x[i] = r * cos(th);
+    if (i + 1 < n) x[i+1] = r * sin(th);
+  }
+}
+
+static int surviving_fins(uint64_t & s, int nfin, double p_loss)
+{
+  int n = 0;
+  for (int f = 0; f < nfin; f++)
+  {
+    if (uniform01(s) >= p_loss) n++;
+  }
+  return n;
+}
+
+
+static void * mc_batch_worker(void * arg)
+{
+  mc_batch_struct * w = (mc_batch_struct *) arg;
+  const bitline_terms & bt = *(w->bt);
+
+  double overdrive = bt.V_wl - bt.v_th;
+  double v_t       = MC_SUBTHRESHOLD_N * MC_KB_OVER_Q * g_ip->temp;
+  double sigma     = g_ip->mc_sigma_vth;
+  double m         = bt.V_wl / bt.inrisetime;
+
+  // one row per varied device: read-path pull-down and access, cross-coupled
+  // inverters, write-port access, read port
+  vector<double> dvth(5 * MC_BATCH);
+  vector<double> fin_pd(MC_BATCH), fin_acc(MC_BATCH);   // R multipliers from lost fins, 0 if all are lost
+
+  for (uint32_t b = w->tid; b < w->n_batches; b += nthreads)
+  {
+    uint32_t first = b * MC_BATCH;
+    uint32_t n     = MIN(MC_BATCH, w->samples - first);
+    uint64_t s     = ((uint64_t) g_ip->mc_seed << 32) ^ b;
+
+    for (uint32_t d = 0; d < 5; d++)
+    {
+      gaussian_fill(s, &dvth[d * MC_BATCH], n);
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+      fin_pd[i] = fin_acc[i] = 1.0;
+      if (w->nfin_pd > 0 && g_ip->mc_fin_loss_prob > 0)
+      {
+        int pd  = surviving_fins(s, w->nfin_pd,  g_ip->mc_fin_loss_prob);
+        int acc = surviving_fins(s, w->nfin_acc, g_ip->mc_fin_loss_prob);
+        fin_pd[i]  = (pd  == 0) ? 0 : (double) w->nfin_pd  / pd;
+        fin_acc[i] = (acc == 0) ? 0 : (double) w->nfin_acc / acc;
+      }
+    }
+
+    double * delay = w->delay + first;
+    double * leak  = w->leak  + first;
+    for (uint32_t i = 0; i < n; i++)
+    {
+      double dv_pd  = sigma * dvth[i];
+      double dv_acc = sigma * dvth[MC_BATCH + i];
+      if (fin_pd[i] == 0 || fin_acc[i] == 0 || dv_pd >= overdrive || dv_acc >= overdrive)
+      {
+        delay[i] = -1;
+      }
+      else
+      {
+        double R = bt.R_pull_down * fin_pd[i]  * pow(overdrive / (overdrive - dv_pd),  g_ip->mc_alpha) +
+                   bt.R_acc       * fin_acc[i] * pow(overdrive / (overdrive - dv_acc), g_ip->mc_alpha);
+        double tstep = (R * bt.C_cell_path + bt.tau_rest) * bt.log_swing;
+        // same input-slope correction as Mat::compute_bitline_delay()
+        if (tstep <= (0.5 * overdrive / m))
+          delay[i] = sqrt(2 * tstep * overdrive / m);
+        else
+          delay[i] = tstep + overdrive / (2 * m);
+      }
+      leak[i] = bt.leak_cc  * exp(-sigma * dvth[2*MC_BATCH + i] / v_t) +
+                bt.leak_acc * exp(-sigma * dvth[3*MC_BATCH + i] / v_t) * bt.n_wr_ports +
+                bt.leak_rd  * exp(-sigma * dvth[4*MC_BATCH + i] / v_t) * bt.n_rd_ports;
+    }
+  }
+  return NULL;
+}
+
+
+// value at quantile q of the sorted vector v
+static double quantile(const vector<double> & v, double q)
+{
+  if (v.empty()) return 0;
+  size_t i = (size_t) (q * (v.size() - 1) + 0.5);
+  return v[MIN(i, v.size() - 1)];
+}
+
+// z such that P(Z > z) = p for a standard normal Z
+static double normal_upper_quantile(double p)
+{
+  double lo = 0, hi = 40;
+  for (int i = 0; i < 200; i++)
+  {
+    double mid = 0.5 * (lo + hi);
+    if (0.5 * erfc(mid / sqrt(2.0)) > p) lo = mid; else hi = mid;
+  }
+  return 0.5 * (lo + hi);
+}
+
+
+void monte_carlo_variation(uca_org_t * fin_res)
+{
+  if (g_ip->fully_assoc || fin_res->data_array2 == NULL)
+  {
+    cout << "\nMonte Carlo variation: not supported for fully associative arrays, skipped\n";
+    return;
+  }
+  if (g_ip->data_arr_ram_cell_tech_type == lp_dram || g_ip->data_arr_ram_cell_tech_type == comm_dram)
+  {
+    cout << "\nMonte Carlo variation: only SRAM cells are modeled, skipped\n";
+    return;
+  }
+
+  // rebuild the winning data array to get its nominal bitline terms
+  const mem_array * d = fin_res->data_array2;
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  init_tech_params(g_ip->F_sz_um, false);
+  DynamicParameter dyn_p(false, pure_ram, d->Nspd, d->Ndwl, d->Ndbl, d->deg_bl_muxing,
+                         d->Ndsam_lev_1, d->Ndsam_lev_2, g_ip->is_main_mem);
+  UCA * uca = new UCA(dyn_p);
+  bitline_terms bt = uca->bank.mat.bl_terms;
+  double nominal_delay = uca->bank.mat.delay_bitline;
+  delete uca;
+
+  mc_batch_struct * work = new mc_batch_struct[nthreads];
+  pthread_t * threads    = new pthread_t[nthreads];
+  vector<double> delay(g_ip->mc_samples), leak(g_ip->mc_samples);
+
+  int nfin[5];
+  g_ip->sram_cell_design.getNfins(nfin);
+  bool rd_port_cell = (g_ip->sram_cell_design.getType() != std_6T);
+
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    work[t].tid       = t;
+    work[t].samples   = g_ip->mc_samples;
+    work[t].n_batches = (g_ip->mc_samples + MC_BATCH - 1) / MC_BATCH;
+    work[t].bt        = &bt;
+    work[t].nfin_pd   = g_ip->is_finfet ? nfin[rd_port_cell ? 3 : 2] : 0;
+    work[t].nfin_acc  = g_ip->is_finfet ? nfin[rd_port_cell ? 4 : 0] : 0;
+    work[t].delay     = &delay[0];
+    work[t].leak      = &leak[0];
+    pthread_create(&threads[t], NULL, mc_batch_worker, (void *) &work[t]);
+  }
+  for (uint32_t t = 0; t < nthreads; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+  delete [] threads;
+  delete [] work;
+
+  double leak_sum = 0, leak_sq = 0, delay_sum = 0;
+  vector<double> valid;
+  valid.reserve(delay.size());
+  for (uint32_t i = 0; i < g_ip->mc_samples; i++)
+  {
+    leak_sum += leak[i];
+    leak_sq  += leak[i] * leak[i];
+    if (delay[i] >= 0) { valid.push_back(delay[i]); delay_sum += delay[i]; }
+  }
+  uint32_t n_open = g_ip->mc_samples - valid.size();
+  sort(valid.begin(), valid.end());
+  sort(leak.begin(), leak.end());
+
+  double leak_mean = leak_sum / g_ip->mc_samples;
+  double leak_sd   = sqrt(MAX(0.0, leak_sq / g_ip->mc_samples - leak_mean * leak_mean));
+  double delay_mean = valid.empty() ? 0 : delay_sum / valid.size();
+  double delay_sd = 0;
+  for (size_t i = 0; i < valid.size(); i++)
+  {
+    delay_sd += (valid[i] - delay_mean) * (valid[i] - delay_mean);
+  }
+  delay_sd = valid.empty() ? 0 : sqrt(delay_sd / valid.size());
+
+  // every data bit of the array is one cell
+  double n_cells = (double) g_ip->cache_sz * 8;
+  double z_cells = normal_upper_quantile(1.0 / n_cells);
+
+  cout << "\nMonte Carlo variation of the data array cells (" << g_ip->mc_samples << " samples, "
+       << "sigma Vth " << g_ip->mc_sigma_vth * 1e3 << " mV";
+  if (g_ip->is_finfet) cout << ", fin loss probability " << g_ip->mc_fin_loss_prob;
+  cout << ", seed " << g_ip->mc_seed << "):\n";
+  cout << "    Cell read delay (ps): nominal " << nominal_delay * 1e12
+       << "  mean " << delay_mean * 1e12
+       << "  p50 " << quantile(valid, 0.5) * 1e12
+       << "  p90 " << quantile(valid, 0.9) * 1e12
+       << "  p99 " << quantile(valid, 0.99) * 1e12
+       << "  p99.9 " << quantile(valid, 0.999) * 1e12
+       << "  max " << (valid.empty() ? 0 : valid.back()) * 1e12 << endl;
+  cout << "    Cells with an open read path: " << n_open << endl;
+  cout << "    Cell leakage (nW): nominal " << (bt.leak_cc + bt.leak_acc * bt.n_wr_ports + bt.leak_rd * bt.n_rd_ports) * 1e9
+       << "  mean " << leak_mean * 1e9
+       << "  p50 " << quantile(leak, 0.5) * 1e9
+       << "  p90 " << quantile(leak, 0.9) * 1e9
+       << "  p99 " << quantile(leak, 0.99) * 1e9
+       << "  p99.9 " << quantile(leak, 0.999) * 1e9
+       << "  max " << leak.back() * 1e9 << endl;
+  if (g_ip->mc_samples >= n_cells)
+    cout << "    Array worst-case cell read delay (ps): " << quantile(valid, 1.0 - 1.0 / n_cells) * 1e12 << endl;
+  else
+    cout << "    Array worst-case cell read delay (ps, mean + " << z_cells << " sigma): "
+         << (delay_mean + z_cells * delay_sd) * 1e12 << endl;
+  cout << "    Array cell leakage (mW): mean " << n_cells * leak_mean * 1e3
+       << "  p99 " << (n_cells * leak_mean + 2.326 * sqrt(n_cells) * leak_sd) * 1e3 << endl;
+}
@@ -65,8 +65,7 @@ Nuca::init_cont()
   char jk[5000];
   cont = fopen("contention.dat", "r");
   if (!cont) {
-    cout << "contention.dat file is missing!\n";
-    exit(0);
+    throw cacti_error("contention.dat file is missing!");
   }
 
   for(int i=0; i<2; i++) { 
@@ -183,6 +182,7 @@ Nuca::sim_nuca()
   min_values_t minval; 
 
   int bank_start = 0;
+  unsigned int min_banksize = MIN_BANKSIZE;  // scaled to the associativity below
 
   int flit_width = 0;
 
@@ -203,19 +203,19 @@ Nuca::sim_nuca()
   if (g_ip->cores <= 4) core_in = 2;
   else if (g_ip->cores <= 8) core_in = 3;
   else if (g_ip->cores <= 16) core_in = 4;
-  else {cout << "Number of cores should be <= 16!\n"; exit(0);}
+  else throw cacti_error("Number of cores should be <= 16!");
 
 
   // set the lower bound to an appropriate value. this depends on cache associativity
   if (g_ip->assoc > 2) {
     i = 2;
     while (i != g_ip->assoc) {
-      MIN_BANKSIZE *= 2;
+      min_banksize *= 2;
       i *= 2;
     }
   }
 
-  iterations = (int)logtwo((int)g_ip->cache_sz/MIN_BANKSIZE);
+  iterations = (int)logtwo((int)g_ip->cache_sz/min_banksize);
 
   if (g_ip->force_wiretype)
   {
@@ -104,6 +104,41 @@ void TechnologyParameter::MemoryType::display(uint32_t indent)
 
 
 
+void TechnologyParameter::CamType::display(uint32_t indent)
+{
+  string indent_str(indent, ' ');
+
+  cout << indent_str << "w_dec_drive_p     = " << setw(12) << w_dec_drive_p     << " um" << endl;
+  cout << indent_str << "w_dec_drive_n     = " << setw(12) << w_dec_drive_n     << " um" << endl;
+  cout << indent_str << "w_fa_drive_n      = " << setw(12) << w_fa_drive_n      << " um" << endl;
+  cout << indent_str << "w_fa_drive_p      = " << setw(12) << w_fa_drive_p      << " um" << endl;
+  cout << indent_str << "w_fa_drive2_n     = " << setw(12) << w_fa_drive2_n     << " um" << endl;
+  cout << indent_str << "w_fa_drive2_p     = " << setw(12) << w_fa_drive2_p     << " um" << endl;
+  cout << indent_str << "w_fa_dec_drive1_n = " << setw(12) << w_fa_dec_drive1_n << " um" << endl;
+  cout << indent_str << "w_fa_dec_drive1_p = " << setw(12) << w_fa_dec_drive1_p << " um" << endl;
+  cout << indent_str << "w_fa_dec_drive2_n = " << setw(12) << w_fa_dec_drive2_n << " um" << endl;
+  cout << indent_str << "w_fa_dec_drive2_p = " << setw(12) << w_fa_dec_drive2_p << " um" << endl;
+  cout << indent_str << "w_fa_dec_drive_n  = " << setw(12) << w_fa_dec_drive_n  << " um" << endl;
+  cout << indent_str << "w_fa_dec_drive_p  = " << setw(12) << w_fa_dec_drive_p  << " um" << endl;
+  cout << indent_str << "w_fa_prech_n      = " << setw(12) << w_fa_prech_n      << " um" << endl;
+  cout << indent_str << "w_fa_prech_p      = " << setw(12) << w_fa_prech_p      << " um" << endl;
+  cout << indent_str << "w_dummy_n         = " << setw(12) << w_dummy_n         << " um" << endl;
+  cout << indent_str << "w_dummy_inv_n     = " << setw(12) << w_dummy_inv_n     << " um" << endl;
+  cout << indent_str << "w_dummy_inv_p     = " << setw(12) << w_dummy_inv_p     << " um" << endl;
+  cout << indent_str << "w_fa_inv_n        = " << setw(12) << w_fa_inv_n        << " um" << endl;
+  cout << indent_str << "w_fa_inv_p        = " << setw(12) << w_fa_inv_p        << " um" << endl;
+  cout << indent_str << "w_addr_nand_n     = " << setw(12) << w_addr_nand_n     << " um" << endl;
+  cout << indent_str << "w_addr_nand_p     = " << setw(12) << w_addr_nand_p     << " um" << endl;
+  cout << indent_str << "w_fa_nand_n       = " << setw(12) << w_fa_nand_n       << " um" << endl;
+  cout << indent_str << "w_fa_nand_p       = " << setw(12) << w_fa_nand_p       << " um" << endl;
+  cout << indent_str << "w_fa_nor_n        = " << setw(12) << w_fa_nor_n        << " um" << endl;
+  cout << indent_str << "w_fa_nor_p        = " << setw(12) << w_fa_nor_p        << " um" << endl;
+  cout << indent_str << "w_dec_nand_n      = " << setw(12) << w_dec_nand_n      << " um" << endl;
+  cout << indent_str << "w_dec_nand_p      = " << setw(12) << w_dec_nand_p      << " um" << endl;
+}
+
+
+
 void TechnologyParameter::display(uint32_t indent)
 {
   string indent_str(indent, ' ');
@@ -183,11 +218,15 @@ void TechnologyParameter::display(uint32_t indent)
   cout << endl;
   cout << indent_str << "DRAM" << endl;
   dram.display(indent + 2);
+
+  cout << endl;
+  cout << indent_str << "FA CAM" << endl;
+  fa_cam.display(indent + 2);
 }
 
 
 DynamicParameter::DynamicParameter():
-  use_inp_params(0), cell(), is_valid(true)
+  use_inp_params(0), cell(), is_valid(true), max_access_time(0), max_read_energy(0)
 {
 }
 
@@ -206,7 +245,7 @@ DynamicParameter::DynamicParameter(
   is_tag(is_tag_), pure_ram(pure_ram_), tagbits(0), Nspd(Nspd_), Ndwl(Ndwl_), Ndbl(Ndbl_),
   Ndsam_lev_1(Ndsam_lev_1_), Ndsam_lev_2(Ndsam_lev_2_),
   number_way_select_signals_mat(0), V_b_sense(0), use_inp_params(0),
-  is_main_mem(is_main_mem_), cell(), is_valid(false)
+  is_main_mem(is_main_mem_), cell(), is_valid(false), max_access_time(0), max_read_energy(0)
 {
   ram_cell_tech_type = (is_tag) ? g_ip->tag_arr_ram_cell_tech_type : g_ip->data_arr_ram_cell_tech_type;
   is_dram            = ((ram_cell_tech_type == lp_dram) || (ram_cell_tech_type == comm_dram));
@@ -424,8 +463,7 @@ DynamicParameter::DynamicParameter(
     C_bl = num_r_subarray * (Cbitrow_drain_access + c_b_metal);
     } else {
     
-    std::cerr << "Unsupported SRAM cell type!" << std::endl;
-    exit(1);
+    throw cacti_error("Unsupported SRAM cell type!", 1);
     }
     //Francesco end
 
@@ -159,6 +159,41 @@ class TechnologyParameter
     void display(uint32_t indent = 0);
   };
 
+  // transistor sizing of the fully-associative CAM tag path
+  class CamType
+  {
+   public:
+    double w_dec_drive_p;
+    double w_dec_drive_n;
+    double w_fa_drive_n;
+    double w_fa_drive_p;
+    double w_fa_drive2_n;
+    double w_fa_drive2_p;
+    double w_fa_dec_drive1_n;
+    double w_fa_dec_drive1_p;
+    double w_fa_dec_drive2_n;
+    double w_fa_dec_drive2_p;
+    double w_fa_dec_drive_n;
+    double w_fa_dec_drive_p;
+    double w_fa_prech_n;
+    double w_fa_prech_p;
+    double w_dummy_n;
+    double w_dummy_inv_n;
+    double w_dummy_inv_p;
+    double w_fa_inv_n;
+    double w_fa_inv_p;
+    double w_addr_nand_n;
+    double w_addr_nand_p;
+    double w_fa_nand_n;
+    double w_fa_nand_p;
+    double w_fa_nor_n;
+    double w_fa_nor_p;
+    double w_dec_nand_n;
+    double w_dec_nand_p;
+
+    void display(uint32_t indent = 0);
+  };
+
   double ram_wl_stitching_overhead_;
   double min_w_nmos_;
   double max_w_nmos_;
@@ -226,6 +261,7 @@ class TechnologyParameter
  
   MemoryType sram;
   MemoryType dram;
+  CamType    fa_cam;
 
   void display(uint32_t indent = 0);
 
@@ -255,6 +291,21 @@ class TechnologyParameter
 
 
 
+// why the evaluation of a partition was cut short (see
+// DynamicParameter::max_access_time / max_read_energy)
+enum Eval_abort
+{
+  Eval_complete,
+  Eval_abort_row_path,     // predecode and row decoder
+  Eval_abort_bitline,
+  Eval_abort_sense_amp,
+  Eval_abort_output,       // subarray output driver and data-out H-trees
+  Eval_abort_read_energy,
+  Eval_abort_types
+};
+
+
+
 class DynamicParameter
 {
   public:
@@ -309,6 +360,11 @@ class DynamicParameter
     bool   is_main_mem;
     Area   cell;
     bool   is_valid;
+
+    // If > 0, UCA stops evaluating once the partial access time or read
+    // energy of the array is already above this bound (0 = evaluate fully)
+    double max_access_time;
+    double max_read_energy;
 };
 
 
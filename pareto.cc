@@ -0,0 +1,279 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <algorithm>
+
+#include "pareto.h"
+#include "parameter.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+vector<pareto_point> pareto_frontier;
+
+
+struct key_less
+{
+  const vector<double> & keys;
+  uint32_t m;
+  key_less(const vector<double> & k, uint32_t m_) : keys(k), m(m_) { }
+  bool operator()(uint32_t a, uint32_t b) const
+  {
+    for (uint32_t d = 0; d < m; d++)
+    {
+      if (keys[a*m + d] != keys[b*m + d]) return keys[a*m + d] < keys[b*m + d];
+    }
+    return a < b;
+  }
+};
+
+// Candidates are visited in lexicographic order, so a point can only be
+// dominated by one already on the frontier; the frontier point that
+// dominated the last candidate is checked first.
+vector<uint32_t> non_dominated(const vector<double> & keys, uint32_t m)
+{
+  uint32_t n = keys.size() / m;
+  vector<uint32_t> order(n), front;
+  for (uint32_t i = 0; i < n; i++) order[i] = i;
+  sort(order.begin(), order.end(), key_less(keys, m));
+
+  uint32_t last_hit = 0;
+  for (uint32_t i = 0; i < n; i++)
+  {
+    const double * p = &keys[order[i] * m];
+    bool dominated = false;
+    for (uint32_t j = 0; j < front.size() && !dominated; j++)
+    {
+      uint32_t f = (j == 0) ? last_hit : ((j <= last_hit) ? j - 1 : j);
+      const double * q = &keys[front[f] * m];
+      uint32_t d = 0;
+      while (d < m && q[d] <= p[d]) d++;
+      if (d == m)
+      {
+        dominated = true;
+        last_hit  = f;
+      }
+    }
+    if (!dominated) front.push_back(order[i]);
+  }
+  return front;
+}
+
+
+static bool all_finite(const double * k, uint32_t m)
+{
+  for (uint32_t d = 0; d < m; d++)
+  {
+    if (!(k[d] == k[d]) || k[d] > BIGNUM) return false;
+  }
+  return true;
+}
+
+// quantities of one array the combined organization is non-decreasing in
+static uint32_t array_key(const mem_array_metrics * a, bool is_tag, double * k)
+{
+  k[0] = a->access_time;
+  k[1] = a->cycle_time;
+  k[2] = a->power.readOp.dynamic;
+  k[3] = a->power.writeOp.dynamic;
+  k[4] = a->power.readOp.leakage;
+  k[5] = a->height;
+  k[6] = a->width;
+  if (is_tag) return 7;
+  k[7] = a->delay_senseamp_mux_decoder;
+  k[8] = a->delay_before_subarray_output_driver;
+  k[9] = a->delay_from_subarray_output_driver_to_output;
+  return 10;
+}
+
+// the non-dominated arrays of arr in mem_array_metrics::lt order; arrays with
+// non-finite results are left out
+static vector<mem_array_metrics *> prune(const list<mem_array_metrics *> & arr, bool is_tag)
+{
+  vector<mem_array_metrics *> all, kept;
+  vector<double> keys;
+  double k[10];
+  uint32_t m = 0;
+  for (list<mem_array_metrics *>::const_iterator it = arr.begin(); it != arr.end(); ++it)
+  {
+    m = array_key(*it, is_tag, k);
+    if (!all_finite(k, m)) continue;
+    all.push_back(*it);
+    keys.insert(keys.end(), k, k + m);
+  }
+  if (all.empty()) return kept;
+
+  vector<uint32_t> front = non_dominated(keys, m);
+  sort(front.begin(), front.end());
+  for (uint32_t i = 0; i < front.size(); i++) kept.push_back(all[front[i]]);
+  return kept;
+}
+
+
+void find_pareto_frontier(const list<mem_array_metrics *> & tag_arr, const list<mem_array_metrics *> & data_arr, bool pure_ram)
+{
+  vector<mem_array_metrics *> tags;
+  vector<mem_array_metrics *> datas = prune(data_arr, false);
+  if (pure_ram)
+    tags.push_back(NULL);
+  else
+    tags = prune(tag_arr, true);
+
+  const uint32_t m = 6;
+  vector<double> keys;
+  vector<pair<uint32_t, uint32_t> > combo;
+  keys.reserve(tags.size() * datas.size() * m);
+  for (uint32_t t = 0; t < tags.size(); t++)
+  {
+    for (uint32_t d = 0; d < datas.size(); d++)
+    {
+      uca_org_t org;
+      org.find_delay(tags[t], datas[d]);
+      org.find_energy(tags[t], datas[d]);
+      org.find_area(tags[t], datas[d]);
+      org.find_cyc(tags[t], datas[d]);
+      if (!org_within_constraints(org)) continue;
+
+      combo.push_back(make_pair(t, d));
+      keys.push_back(org.access_time);
+      keys.push_back(org.cycle_time);
+      keys.push_back(org.power.readOp.dynamic);
+      keys.push_back(org.power.writeOp.dynamic);
+      keys.push_back(org.power.readOp.leakage);
+      keys.push_back(org.area);
+    }
+  }
+
+  // non_dominated() returns the frontier in ascending access time
+  vector<uint32_t> front = non_dominated(keys, m);
+  pareto_frontier.clear();
+  for (uint32_t i = 0; i < front.size(); i++)
+  {
+    const double * k = &keys[front[i] * m];
+    uint32_t t = combo[front[i]].first;
+    uint32_t d = combo[front[i]].second;
+
+    pareto_point p;
+    p.access_time  = k[0];
+    p.cycle_time   = k[1];
+    p.read_energy  = k[2];
+    p.write_energy = k[3];
+    p.leakage      = k[4];
+    p.area         = k[5];
+    p.has_tag      = (tags[t] != NULL);
+    if (p.has_tag) p.tag_array = *tags[t];
+    p.data_array   = *datas[d];
+    pareto_frontier.push_back(p);
+  }
+}
+
+
+const char * wire_type_name(int wt)
+{
+  static const char * names[] = {"Global", "Global_5", "Global_10", "Global_20", "Global_30",
+                                 "Low_swing", "Semi_global", "Transmission", "Optical"};
+  return (wt >= Global && wt < Invalid_wtype) ? names[wt] : "?";
+}
+
+void print_org(ostream & os, const mem_array_metrics & a, const char * sep)
+{
+  os << a.Ndwl << sep << a.Ndbl << sep << a.Nspd << sep << a.deg_bl_muxing << sep
+     << a.Ndsam_lev_1 << sep << a.Ndsam_lev_2;
+}
+
+
+void output_pareto_frontier()
+{
+  cout << "\nPareto frontier (" << pareto_frontier.size() << " organizations; access time, cycle time, "
+       << "read/write energy, leakage and area):\n";
+  cout << "   #  access (ns)  cycle (ns)   read (nJ)  write (nJ)  leakage (mW)  area (mm2)"
+       << "  data Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2  wire type";
+  if (g_ip->is_cache) cout << "  tag Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2";
+  cout << endl;
+  for (uint32_t i = 0; i < pareto_frontier.size(); i++)
+  {
+    const pareto_point & p = pareto_frontier[i];
+    cout << setw(4) << i + 1
+         << setw(13) << p.access_time*1e9
+         << setw(12) << p.cycle_time*1e9
+         << setw(12) << p.read_energy*1e9
+         << setw(12) << p.write_energy*1e9
+         << setw(14) << p.leakage*1e3
+         << setw(12) << p.area*1e-6 << "  ";
+    print_org(cout, p.data_array, ":");
+    cout << "  " << wire_type_name(p.data_array.wt);
+    if (p.has_tag)
+    {
+      cout << "  ";
+      print_org(cout, p.tag_array, ":");
+    }
+    cout << endl;
+  }
+
+  if (g_ip->pareto_out_file[0] != '\0')
+  {
+    ofstream fout(g_ip->pareto_out_file);
+    if (!fout)
+    {
+      throw cacti_error(string("cannot write ") + g_ip->pareto_out_file);
+    }
+    fout << "access_time_ns,cycle_time_ns,read_energy_nJ,write_energy_nJ,leakage_mW,area_mm2,"
+         << "data_Ndwl,data_Ndbl,data_Nspd,data_Ndcm,data_Ndsam1,data_Ndsam2,wire_type,"
+         << "tag_Ndwl,tag_Ndbl,tag_Nspd,tag_Ndcm,tag_Ndsam1,tag_Ndsam2\n";
+    fout << setprecision(9);
+    for (uint32_t i = 0; i < pareto_frontier.size(); i++)
+    {
+      const pareto_point & p = pareto_frontier[i];
+      fout << p.access_time*1e9 << "," << p.cycle_time*1e9 << "," << p.read_energy*1e9 << ","
+           << p.write_energy*1e9 << "," << p.leakage*1e3 << "," << p.area*1e-6 << ",";
+      print_org(fout, p.data_array, ",");
+      fout << "," << wire_type_name(p.data_array.wt) << ",";
+      if (p.has_tag) print_org(fout, p.tag_array, ",");
+      else fout << ",,,,,";
+      fout << "\n";
+    }
+    cout << "Pareto frontier written to " << g_ip->pareto_out_file << endl;
+  }
+}
@@ -0,0 +1,95 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __PARETO_H__
+#define __PARETO_H__
+
+#include <iostream>
+#include <list>
+#include <vector>
+#include "cacti_interface.h"
+
+using namespace std;
+
+
+// one non-dominated cache organization
+struct pareto_point
+{
+  double access_time;
+  double cycle_time;
+  double read_energy;
+  double write_energy;
+  double leakage;
+  double area;
+  bool      has_tag;
+  mem_array_metrics tag_array;
+  mem_array_metrics data_array;
+};
+
+// Indices of the m-dimensional keys (stored row by row) that no other key
+// is <= in every dimension, in lexicographic order of the keys; of a group
+// of identical keys only the first is kept.
+vector<uint32_t> non_dominated(const vector<double> & keys, uint32_t m);
+
+// frontier of the last solve() with g_ip->pareto_frontier set
+extern vector<pareto_point> pareto_frontier;
+
+/*
+ * Replaces pareto_frontier with the organizations that are not dominated in
+ * access time, cycle time, read/write energy, leakage and area, taken over
+ * all tag x data combinations (before the deviation filters). Each side is
+ * first reduced to the arrays that are not dominated in every quantity the
+ * uca_org_t::find_*() combinations are monotone in, so the product that has
+ * to be sorted stays small. Identical points (e.g. the same partition under
+ * different wire types) are reported once.
+ */
+void find_pareto_frontier(const list<mem_array_metrics *> & tag_arr, const list<mem_array_metrics *> & data_arr, bool pure_ram);
+
+// Ndwl, Ndbl, Nspd, Ndcm, Ndsam1 and Ndsam2 of the array, sep between them
+void print_org(ostream & os, const mem_array_metrics & a, const char * sep);
+
+// name of the wire type wt ("?" if out of range)
+const char * wire_type_name(int wt);
+
+// prints pareto_frontier (and writes g_ip->pareto_out_file if set)
+void output_pareto_frontier();
+
+#endif
@@ -0,0 +1,581 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <time.h>
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+
+#include "search.h"
+#include "parameter.h"
+#include "dump.h"
+
+using namespace std;
+
+
+static const int n_axes = 6;  // Nspd, Ndwl, Ndbl, Ndcm, Ndsam_lev_1, Ndsam_lev_2
+
+
+static double wall_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+static inline uint64_t splitmix64(uint64_t & s)
+{
+  uint64_t z = (s += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+static inline double uniform01(uint64_t & s)
+{
+  return ((splitmix64(s) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static inline uint32_t uniform_index(uint64_t & s, uint32_t n)
+{
+  return MIN((uint32_t) (uniform01(s) * n), n - 1);
+}
+
+
+
+search_state::search_state(double Nspd_min)
+ :n_chains(MAX(g_ip->search_chains, 1u)), next_chain(0), chain_steps(0),
+  t_start(wall_time()), deadline(0)
+{
+  // Nspd: each octave split into quarters (1, 1.25, 1.5, 1.75 x 2^k)
+  int nspd_steps = g_ip->search_extended ? 4 : 1;
+  for (double Nspd = Nspd_min; Nspd <= MAXDATASPD; Nspd *= 2)
+  {
+    for (int q = 0; q < nspd_steps && Nspd * (1 + q / 4.0) <= MAXDATASPD; q++)
+    {
+      Nspd_v.push_back(Nspd * (1 + q / 4.0));
+    }
+  }
+  // Ndwl, Ndbl: a mat holds 2x2 subarrays, so counts above one stay even
+  for (unsigned int n = 1; n <= MAXDATAN; n = (g_ip->search_extended && n > 1) ? n + 2 : n * 2)
+  {
+    Ndwl_v.push_back(n);
+    Ndbl_v.push_back(n);
+  }
+  for (unsigned int n = 1; n <= MAX_COL_MUX; n *= 2)
+  {
+    Ndcm_v.push_back(n);
+    Ndsam_lev_1_v.push_back(n);
+    Ndsam_lev_2_v.push_back(n);
+  }
+
+  if (g_ip->search_max_evals > 0)
+  {
+    chain_steps = (g_ip->search_max_evals + n_chains - 1) / n_chains;
+  }
+  if (g_ip->search_time_limit > 0)
+  {
+    deadline = t_start + g_ip->search_time_limit;
+  }
+  pthread_mutex_init(&seen_lock, NULL);
+}
+
+
+
+search_state::~search_state()
+{
+  pthread_mutex_destroy(&seen_lock);
+}
+
+
+
+static uint32_t axis_size(const search_state * st, int a)
+{
+  switch (a)
+  {
+    case 0:  return st->Nspd_v.size();
+    case 1:  return st->Ndwl_v.size();
+    case 2:  return st->Ndbl_v.size();
+    case 3:  return st->Ndcm_v.size();
+    case 4:  return st->Ndsam_lev_1_v.size();
+    default: return st->Ndsam_lev_2_v.size();
+  }
+}
+
+
+
+static double axis_value(const search_state * st, int a, uint32_t i)
+{
+  switch (a)
+  {
+    case 0:  return st->Nspd_v[i];
+    case 1:  return st->Ndwl_v[i];
+    case 2:  return st->Ndbl_v[i];
+    case 3:  return st->Ndcm_v[i];
+    case 4:  return st->Ndsam_lev_1_v[i];
+    default: return st->Ndsam_lev_2_v[i];
+  }
+}
+
+
+
+// index of the axis value closest to v on a log scale (the axes are sorted)
+static uint32_t nearest_index(const search_state * st, int a, double v)
+{
+  uint32_t n = axis_size(st, a), i = 0;
+  while (i + 1 < n && axis_value(st, a, i + 1) <= v) i++;
+  if (i + 1 < n && log(axis_value(st, a, i + 1) / v) < log(v / axis_value(st, a, i))) i++;
+  return i;
+}
+
+
+
+// Moves are multiplicative, so a step covers the same ratio on the
+// power-of-two axes and on the dense extended ones: the index closest to
+// value * 2^octaves, but at least one index away from i.
+static uint32_t scaled_index(const search_state * st, int a, uint32_t i, double octaves)
+{
+  uint32_t j = nearest_index(st, a, axis_value(st, a, i) * pow(2.0, octaves));
+  if (j == i)
+  {
+    if (octaves > 0 && i + 1 < axis_size(st, a)) j = i + 1;
+    if (octaves < 0 && i > 0) j = i - 1;
+  }
+  return j;
+}
+
+
+
+static partition_t partition_at(const search_state * st, const uint32_t * idx)
+{
+  partition_t p;
+  p.Nspd        = st->Nspd_v[idx[0]];
+  p.Ndwl        = st->Ndwl_v[idx[1]];
+  p.Ndbl        = st->Ndbl_v[idx[2]];
+  p.Ndcm        = st->Ndcm_v[idx[3]];
+  p.Ndsam_lev_1 = st->Ndsam_lev_1_v[idx[4]];
+  p.Ndsam_lev_2 = st->Ndsam_lev_2_v[idx[5]];
+  return p;
+}
+
+
+
+// no axis has more than 512 points
+static uint64_t grid_key(const uint32_t * idx)
+{
+  uint64_t key = 0;
+  for (int a = 0; a < n_axes; a++) key |= (uint64_t) idx[a] << (9 * a);
+  return key;
+}
+
+
+
+// With g_ip->search_extended, Ndwl, Ndbl and Nspd need not divide the
+// array: DynamicParameter truncates the subarray rows and columns, and the
+// partition would model less capacity than the cache has. Only partitions
+// whose subarrays hold every bit of the bank exactly are on the grid.
+static bool is_grid_partition(const calc_time_mt_wrapper_struct * calc_obj, const partition_t & p)
+{
+  DynamicParameter dyn_p(calc_obj->is_tag, calc_obj->pure_ram, p.Nspd, p.Ndwl, p.Ndbl, p.Ndcm,
+                         p.Ndsam_lev_1, p.Ndsam_lev_2, calc_obj->is_main_mem);
+  if (!dyn_p.is_valid) return false;
+
+  double capacity = g_ip->cache_sz / NUMBER_STACKED_DIE_LAYERS;
+  double bits = calc_obj->is_tag ? capacity / g_ip->block_sz * dyn_p.tagbits : capacity * 8;
+  return (double) dyn_p.num_r_subarray * dyn_p.num_c_subarray * p.Ndwl * p.Ndbl * g_ip->nbanks == bits;
+}
+
+
+
+// org_cost() of the exhaustive selection on a single array, against the
+// minima of the points evaluated so far, as a log so that the anneal
+// temperature is a relative cost. A tag array is ranked by the weights even
+// under ED, as filter_tag_arr() does. The <deviations> of the selection
+// apply to the whole cache, so a point outside them is not dropped but
+// penalized by how far outside it is; with all weights 0, where the
+// selection takes any organization within them, the chains head for their
+// middle. The final pick is still made by find_optimal_uca() over every
+// partition the chains evaluated.
+static double search_cost(const search_metrics & m, const min_values_t & mv, bool is_tag)
+{
+  if (isinf(m.access_time)) return INFINITY;
+
+  double r[5], w[5], dev[5];
+  r[0] = m.access_time / mv.min_delay; w[0] = g_ip->delay_wt;         dev[0] = g_ip->delay_dev;
+  r[1] = m.cycle_time / mv.min_cyc;    w[1] = g_ip->cycle_time_wt;    dev[1] = g_ip->cycle_time_dev;
+  r[2] = m.read_energy / mv.min_dyn;   w[2] = g_ip->dynamic_power_wt; dev[2] = g_ip->dynamic_power_dev;
+  r[3] = (mv.min_leakage > 0) ? m.leakage / mv.min_leakage : 1;
+                                       w[3] = g_ip->leakage_power_wt; dev[3] = g_ip->leakage_power_dev;
+  r[4] = m.area / mv.min_area;         w[4] = g_ip->area_wt;          dev[4] = g_ip->area_dev;
+
+  if (g_ip->ed == 1 && !is_tag) return log(r[0] * r[2]);
+  if (g_ip->ed == 2 && !is_tag) return log(r[0] * r[0] * r[2]);
+
+  double cost = 0, w_sum = 0, excess = 0, used = 0;
+  for (int i = 0; i < 5; i++)
+  {
+    cost   += w[i] * r[i];
+    w_sum  += w[i];
+    excess += MAX(0.0, (r[i] - 1) * 100 - dev[i]) / 100;
+    used   += (dev[i] > 0) ? (r[i] - 1) * 100 / dev[i] : 0;
+  }
+  if (w_sum == 0) return log(1 + used);
+  return log(cost / w_sum + excess);
+}
+
+
+
+// objective of a grid point; each point is evaluated (and entered into the
+// candidate lists) by the first chain that reaches it. The metrics are
+// kept rather than the cost, as the minima it is relative to still move.
+static double objective(
+    search_state * st,
+    calc_time_mt_wrapper_struct * calc_obj,
+    const uint32_t * idx,
+    mem_array & tag_res_arr,
+    mem_array & data_res_arr)
+{
+  uint64_t key = grid_key(idx);
+  bool record = false;
+  search_metrics m;
+  min_values_t mv;
+
+  pthread_mutex_lock(&st->seen_lock);
+  map<uint64_t, search_metrics>::iterator it = st->seen.find(key);
+  if (it != st->seen.end() && !isnan(it->second.access_time))
+  {
+    m  = it->second;
+    mv = st->min;
+    pthread_mutex_unlock(&st->seen_lock);
+    return search_cost(m, mv, calc_obj->is_tag);
+  }
+  if (it == st->seen.end())
+  {
+    st->seen[key].access_time = NAN;
+    record = true;
+  }
+  pthread_mutex_unlock(&st->seen_lock);
+
+  // a point another chain is still evaluating is evaluated again, unrecorded
+  partition_t p = partition_at(st, idx);
+  const mem_array * a = NULL;
+  m.access_time = INFINITY;
+  if (is_grid_partition(calc_obj, p) &&
+      evaluate_partition(calc_obj, p, tag_res_arr, data_res_arr, record))
+  {
+    a = calc_obj->is_tag ? &tag_res_arr : &data_res_arr;
+    m.access_time = a->access_time;
+    m.cycle_time  = a->cycle_time;
+    m.read_energy = a->power.readOp.dynamic;
+    m.leakage     = a->power.readOp.leakage;
+    m.area        = a->area;
+  }
+
+  pthread_mutex_lock(&st->seen_lock);
+  if (a != NULL) st->min.update_min_values(a);
+  if (record) st->seen[key] = m;
+  mv = st->min;
+  pthread_mutex_unlock(&st->seen_lock);
+  return search_cost(m, mv, calc_obj->is_tag);
+}
+
+
+
+static bool out_of_budget(const search_state * st, uint64_t steps)
+{
+  if (st->chain_steps > 0 && steps >= st->chain_steps) return true;
+  return (st->deadline > 0 && wall_time() >= st->deadline);
+}
+
+
+
+// random grid point that DynamicParameter accepts, log-uniform on every axis
+static bool random_start(
+    const search_state * st,
+    const calc_time_mt_wrapper_struct * calc_obj,
+    uint64_t & s,
+    uint32_t * idx)
+{
+  for (int tries = 0; tries < 1000; tries++)
+  {
+    for (int a = 0; a < n_axes; a++)
+    {
+      double lo = axis_value(st, a, 0), hi = axis_value(st, a, axis_size(st, a) - 1);
+      idx[a] = nearest_index(st, a, lo * pow(hi / lo, uniform01(s)));
+    }
+    if (is_grid_partition(calc_obj, partition_at(st, idx))) return true;
+  }
+  return false;
+}
+
+
+
+static void anneal_chain(
+    search_state * st,
+    calc_time_mt_wrapper_struct * calc_obj,
+    uint64_t & s,
+    mem_array & tag_res_arr,
+    mem_array & data_res_arr)
+{
+  const double T_start = 0.5, T_end = 0.005;  // in units of the log cost
+  uint32_t cur[n_axes], next[n_axes];
+  vector<int> movable;
+
+  for (int a = 0; a < n_axes; a++)
+  {
+    if (axis_size(st, a) > 1) movable.push_back(a);
+  }
+  if (!random_start(st, calc_obj, s, cur)) return;
+
+  double cur_cost = objective(st, calc_obj, cur, tag_res_arr, data_res_arr);
+  uint64_t steps = 1;
+
+  while (!movable.empty() && !out_of_budget(st, steps))
+  {
+    // up to one octave along one axis, sometimes a jump of up to three; a
+    // third of the moves take a second axis along, either way
+    for (int a = 0; a < n_axes; a++) next[a] = cur[a];
+    uint32_t ia = uniform_index(s, movable.size());
+    int a = movable[ia];
+    double octaves = uniform01(s) * ((uniform01(s) < 0.8) ? 1 : 3);
+    if (uniform01(s) < 0.5) octaves = -octaves;
+    next[a] = scaled_index(st, a, cur[a], octaves);
+    if (next[a] == cur[a]) continue;
+    if (movable.size() > 1 && uniform01(s) < 1.0 / 3)
+    {
+      uint32_t ib = uniform_index(s, movable.size() - 1);
+      int b = movable[ib + (ib >= ia)];
+      next[b] = scaled_index(st, b, cur[b], (uniform01(s) < 0.5) ? -octaves : octaves);
+    }
+
+    double cost = objective(st, calc_obj, next, tag_res_arr, data_res_arr);
+    cur_cost = objective(st, calc_obj, cur, tag_res_arr, data_res_arr);  // the minima may have moved
+    steps++;
+
+    double progress = (st->chain_steps > 0) ? (double) steps / st->chain_steps :
+                      (wall_time() - st->t_start) / (st->deadline - st->t_start);
+    double T = T_start * pow(T_end / T_start, MIN(progress, 1.0));
+    if (cost <= cur_cost || isinf(cur_cost) ||
+        (!isinf(cost) && uniform01(s) < exp(-(cost - cur_cost) / T)))
+    {
+      for (int i = 0; i < n_axes; i++) cur[i] = next[i];
+      cur_cost = cost;
+    }
+  }
+}
+
+
+
+static void descent_chain(
+    search_state * st,
+    calc_time_mt_wrapper_struct * calc_obj,
+    uint64_t & s,
+    mem_array & tag_res_arr,
+    mem_array & data_res_arr)
+{
+  // compass search: steps of one octave, then halved while the extended
+  // axes still have points in between
+  const int n_levels = g_ip->search_extended ? 3 : 1;
+  uint32_t cur[n_axes];
+  uint64_t steps = 0;
+
+  while (!out_of_budget(st, steps))
+  {
+    if (!random_start(st, calc_obj, s, cur)) return;
+    double cur_cost = objective(st, calc_obj, cur, tag_res_arr, data_res_arr);
+    steps++;
+
+    for (int level = 0; level < n_levels; level++)
+    {
+      double octaves = 1.0 / (1 << level);
+      bool improved = true;
+      while (improved)
+      {
+        improved = false;
+        // a step along one axis, or along two at once (bit 0 of mv is the
+        // direction on a, bit 1 the one on b), which crosses invalid
+        // partitions that one axis alone can not
+        for (int a = 0; a < n_axes; a++)
+        {
+          for (int b = a; b < n_axes; b++)
+          {
+            for (int mv = (b == a) ? 0 : 2; mv < ((b == a) ? 2 : 6); mv++)
+            {
+              uint32_t next[n_axes];
+              for (int k = 0; k < n_axes; k++) next[k] = cur[k];
+              next[a] = scaled_index(st, a, cur[a], ((mv & 1) ? 1 : -1) * octaves);
+              if (b != a) next[b] = scaled_index(st, b, cur[b], ((mv & 2) ? 1 : -1) * octaves);
+              if (next[a] == cur[a] || next[b] == cur[b]) continue;
+              if (out_of_budget(st, steps)) return;
+
+              cur_cost = objective(st, calc_obj, cur, tag_res_arr, data_res_arr);  // the minima may have moved
+              double cost = objective(st, calc_obj, next, tag_res_arr, data_res_arr);
+              steps++;
+              if (cost < cur_cost)
+              {
+                for (int k = 0; k < n_axes; k++) cur[k] = next[k];
+                cur_cost = cost;
+                improved = true;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+
+
+void * search_mt_wrapper(void * void_obj)
+{
+  calc_time_mt_wrapper_struct * calc_obj = (calc_time_mt_wrapper_struct *) void_obj;
+  search_state * st = calc_obj->search;
+
+  calc_obj->data_arr.clear();
+  calc_obj->tag_arr.clear();
+  calc_obj->n_evaluated = 0;
+  for (int r = 0; r < Eval_abort_types; r++) calc_obj->n_aborted[r] = 0;
+
+  mem_array tag_res_arr, data_res_arr;
+
+  for (;;)
+  {
+    uint32_t c = __sync_fetch_and_add(&st->next_chain, 1);
+    if (c >= st->n_chains) break;
+
+    uint64_t s = ((uint64_t) g_ip->search_seed << 32) ^ ((uint64_t) c << 1) ^ (calc_obj->is_tag ? 1 : 0);
+    if (g_ip->search_engine == Search_anneal)
+    {
+      anneal_chain(st, calc_obj, s, tag_res_arr, data_res_arr);
+    }
+    else
+    {
+      descent_chain(st, calc_obj, s, tag_res_arr, data_res_arr);
+    }
+  }
+
+  for (int s = 0; s < 2; s++)
+  {
+    if (calc_obj->dump[s] != NULL) calc_obj->dump[s]->finish();
+  }
+  pthread_exit(NULL);
+}
+
+
+
+static void print_search_row(const char * name, uint64_t evals, double secs, const uca_org_t & org)
+{
+  const mem_array * d = org.data_array2;
+  cout << "  " << setw(11) << left << name << right
+       << setw(12) << evals
+       << setw(10) << fixed << setprecision(2) << secs
+       << setw(13) << setprecision(4) << org.access_time*1e9
+       << setw(12) << org.cycle_time*1e9
+       << setw(11) << org.power.readOp.dynamic*1e9
+       << setw(14) << org.power.readOp.leakage*1e3
+       << setw(12) << org.area*1e-6
+       << "  " << d->Ndwl << ":" << d->Ndbl << ":" << d->Nspd << ":" << d->deg_bl_muxing
+       << ":" << d->Ndsam_lev_1 << ":" << d->Ndsam_lev_2 << endl;
+  cout.unsetf(ios::fixed);
+  cout << setprecision(6);
+}
+
+
+
+void search_comparison()
+{
+  if (g_ip->search_engine == Search_exhaustive || g_ip->fully_assoc || g_ip->nuca == 1)
+  {
+    cout << "\nSearch comparison: needs a heuristic <search><engine> and a set-associative UCA, skipped\n";
+    return;
+  }
+
+  int  pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  int  engine   = g_ip->search_engine;
+  bool extended = g_ip->search_extended;
+  const char * names[2] = {(engine == Search_anneal) ? "anneal" : "descent", "exhaustive"};
+  uca_org_t org[2];
+  uint64_t  evals[2];
+  double    secs[2];
+
+  // both on the power-of-two grid, which the exhaustive sweep covers
+  g_ip->search_extended = false;
+  for (int i = 0; i < 2; i++)
+  {
+    g_ip->search_engine = (i == 0) ? engine : Search_exhaustive;
+    uint64_t n0 = solve_partitions_evaluated;
+    double   t0 = wall_time();
+    solve(&org[i]);
+    secs[i]  = wall_time() - t0;
+    evals[i] = solve_partitions_evaluated - n0;
+  }
+  g_ip->search_engine   = engine;
+  g_ip->search_extended = extended;
+
+  cout << "\nSearch comparison on the power-of-two grid:\n";
+  cout << "  engine      evaluations  time (s)  access (ns)  cycle (ns)  read (nJ)  leakage (mW)  area (mm2)"
+          "  Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2\n";
+  for (int i = 0; i < 2; i++)
+  {
+    print_search_row(names[i], evals[i], secs[i], org[i]);
+  }
+
+  bool same = true;
+  for (int i = 0; i < 2 && same; i++)
+  {
+    const mem_array * a = (i == 0) ? org[0].data_array2 : org[0].tag_array2;
+    const mem_array * b = (i == 0) ? org[1].data_array2 : org[1].tag_array2;
+    if (a == NULL || b == NULL) continue;
+    same = a->Ndwl == b->Ndwl && a->Ndbl == b->Ndbl && a->Nspd == b->Nspd &&
+           a->deg_bl_muxing == b->deg_bl_muxing && a->Ndsam_lev_1 == b->Ndsam_lev_1 &&
+           a->Ndsam_lev_2 == b->Ndsam_lev_2 && a->wt == b->wt;
+  }
+  cout << "  " << names[0] << (same ? " picks the same tag and data organization as"
+                                    : " picks a different organization than") << " the exhaustive sweep" << endl;
+
+  for (int i = 0; i < 2; i++)
+  {
+    delete org[i].data_array2;
+    if (!pure_ram) delete org[i].tag_array2;
+  }
+}
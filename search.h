@@ -0,0 +1,108 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __SEARCH_H__
+#define __SEARCH_H__
+
+#include <map>
+#include <vector>
+#include <pthread.h>
+#include "Ucache.h"
+
+using namespace std;
+
+
+enum Search_engine
+{
+  Search_exhaustive,  // every grid point (enumerate_partitions)
+  Search_anneal,      // simulated annealing chains
+  Search_descent      // coordinate descent with random restarts
+};
+
+
+// the metrics org_cost() weighs, of one evaluated grid point
+struct search_metrics
+{
+  double access_time;  // NaN while the point is evaluated, INFINITY if it is not valid
+  double cycle_time;
+  double read_energy;
+  double leakage;
+  double area;
+};
+
+
+/*
+ * Shared state of one heuristic partition search (one tag or data array
+ * pass of solve()). The grid is the power-of-two one of
+ * enumerate_partitions(); with g_ip->search_extended, Ndwl and Ndbl also
+ * take every even value and Nspd gets quarter-octave steps, where they
+ * divide the array exactly. Each chain has its own random stream and step
+ * budget, so without a time limit the visited set does not depend on the
+ * thread count.
+ */
+class search_state
+{
+  public:
+    search_state(double Nspd_min);
+    ~search_state();
+
+    vector<double>       Nspd_v;
+    vector<unsigned int> Ndwl_v, Ndbl_v, Ndcm_v, Ndsam_lev_1_v, Ndsam_lev_2_v;
+
+    uint32_t n_chains;
+    volatile uint32_t next_chain;  // next unclaimed chain
+    uint64_t chain_steps;          // objective queries per chain, 0 = until the deadline
+    double   t_start;
+    double   deadline;             // wall clock (s), 0 = none
+
+    pthread_mutex_t seen_lock;
+    map<uint64_t, search_metrics> seen;  // grid point -> metrics
+    min_values_t min;                    // minima of the valid points evaluated so far
+};
+
+// pthread worker of solve() in place of calc_time_mt_wrapper()
+void *search_mt_wrapper(void * void_obj);
+
+// Runs the configured engine and the exhaustive sweep on the power-of-two
+// grid and prints the organizations each one picks (<search><compare>).
+void search_comparison();
+
+#endif
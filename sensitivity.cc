@@ -0,0 +1,193 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <math.h>
+
+#include "sensitivity.h"
+#include "tempsweep.h"
+#include "parameter.h"
+#include "wire.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+enum Sens_metric
+{
+  Sm_access, Sm_cycle, Sm_read, Sm_write, Sm_leakage, Sm_area,
+  Sens_metrics
+};
+
+static const char * const device_value_names[Device_values] =
+{
+  "vdd", "v_th", "I_on_n", "I_on_p", "I_off_n", "I_off_p", "c_ox", "c_fringe", "c_junc", "Lphy"
+};
+
+static const char * const target_names[] =
+{
+  "cell", "peri", "wire_inside_mat", "wire_outside_mat"
+};
+
+struct sens_row
+{
+  tech_perturbation p;
+  double e[Sens_metrics];  // elasticities
+};
+
+
+static const char * param_name(const tech_perturbation & p)
+{
+  return (p.target <= Tt_peri) ? device_value_names[p.param] : (p.param == 0 ? "R" : "C");
+}
+
+
+// metrics of the chosen organization under the current tech_perturb
+static void org_metrics(const uca_org_t * fin_res, double m[Sens_metrics])
+{
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  mem_array tag_arr, data_arr;
+  uca_org_t org;
+  evaluate_org(fin_res, &tag_arr, &data_arr);
+  org.tag_array2  = pure_ram ? NULL : &tag_arr;
+  org.data_array2 = &data_arr;
+  org.find_delay();
+  org.find_energy();
+  org.find_area();
+  org.find_cyc();
+
+  m[Sm_access]  = org.access_time;
+  m[Sm_cycle]   = org.cycle_time;
+  m[Sm_read]    = org.power.readOp.dynamic;
+  m[Sm_write]   = org.power.writeOp.dynamic;
+  m[Sm_leakage] = org.power.readOp.leakage;
+  m[Sm_area]    = org.area;
+}
+
+
+void sensitivity_analysis(uca_org_t * fin_res)
+{
+  if (g_ip->fully_assoc || g_ip->nuca == 1 || fin_res->data_array2 == NULL)
+  {
+    cout << "\nSensitivity analysis: only supported for set-associative UCA organizations, skipped\n";
+    return;
+  }
+
+  double h = g_ip->sens_step;
+  vector<sens_row> rows;
+  for (int t = Tt_cell; t <= Tt_wire_outside_mat; t++)
+  {
+    int n = (t <= Tt_peri) ? Device_values : 2;
+    for (int v = 0; v < n; v++)
+    {
+      sens_row r;
+      r.p.target = t;
+      r.p.param  = v;
+      rows.push_back(r);
+    }
+  }
+
+  double nominal[Sens_metrics], lo[Sens_metrics], hi[Sens_metrics];
+  org_metrics(fin_res, nominal);
+
+  // each perturbation needs its own g_tp, so they are evaluated one after
+  // the other; one costs a single partition evaluation per array
+  for (uint32_t i = 0; i < rows.size(); i++)
+  {
+    sens_row & r = rows[i];
+    tech_perturb = &r.p;
+    r.p.factor = 1 - h;
+    org_metrics(fin_res, lo);
+    r.p.factor = 1 + h;
+    org_metrics(fin_res, hi);
+    tech_perturb = NULL;
+
+    for (int k = 0; k < Sens_metrics; k++)
+    {
+      r.e[k] = (nominal[k] != 0) ? (hi[k] - lo[k]) / (2 * h * nominal[k]) : 0;
+    }
+  }
+
+  init_tech_params(g_ip->F_sz_um, false);
+  Wire winit;
+
+  cout << "\nSensitivity of the selected organization (d ln(metric) / d ln(value), central differences at "
+       << h * 100 << "%):\n";
+  cout << "  value                        access     cycle      read     write   leakage      area\n";
+  for (uint32_t i = 0; i < rows.size(); i++)
+  {
+    const sens_row & r = rows[i];
+    string name = string(target_names[r.p.target]) + " " + param_name(r.p);
+    cout << "  " << setw(24) << left << name << right << fixed << setprecision(4);
+    for (int k = 0; k < Sens_metrics; k++)
+    {
+      cout << setw(10) << r.e[k];
+    }
+    cout << endl;
+  }
+  cout.unsetf(ios::floatfield);
+  cout << setprecision(6);
+
+  if (g_ip->sens_out_file[0] != '\0')
+  {
+    ofstream fout(g_ip->sens_out_file);
+    if (!fout)
+    {
+      throw cacti_error(string("cannot write ") + g_ip->sens_out_file);
+    }
+    fout << "target,value,access_time,cycle_time,read_energy,write_energy,leakage,area\n";
+    fout << setprecision(9);
+    for (uint32_t i = 0; i < rows.size(); i++)
+    {
+      const sens_row & r = rows[i];
+      fout << target_names[r.p.target] << "," << param_name(r.p);
+      for (int k = 0; k < Sens_metrics; k++)
+      {
+        fout << "," << r.e[k];
+      }
+      fout << "\n";
+    }
+    cout << "Sensitivities written to " << g_ip->sens_out_file << endl;
+  }
+}
@@ -0,0 +1,159 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __SRAM_CELL_H__
+#define __SRAM_CELL_H__
+
+#include "basic_circuit.h"
+#include "parameter.h"
+
+
+/*
+ * Cell-type policies for the SRAM read/write paths. Decoder, Subarray and
+ * Mat instantiate their cell-dependent routines once per policy and pick
+ * the instance from g_ip->sram_cell_design at the call, so the body of
+ * each routine has no cell-type tests left. A new cell is a new policy
+ * plus one case in SRAM_CELL_DISPATCH below.
+ *
+ *   rd_wordline    separate read wordline: the row decoder is followed by
+ *                  a DEMUX and its own RWL driver
+ *   rwl_inv_demux  the RWL branch of the DEMUX is an inverter, not a NOR2
+ *   rwl_on_write   the RWL driver also switches on a write
+ *   skewed_inv_sa  single-ended read bitline sensed by a skewed inverter
+ *                  instead of the latch sense amplifier
+ */
+
+struct Cell6T
+{
+  static const SRAMcell_type type = std_6T;
+  static const bool rd_wordline   = false;
+  static const bool rwl_inv_demux = false;
+  static const bool rwl_on_write  = false;
+  static const bool skewed_inv_sa = false;
+
+  // read path: pull-down and access transistor of the cell
+  static double R_pull_down() { return tr_R_on(g_tp.sram.cell_nmos_w, NCH, 1, false, true); }
+  static double R_acc()       { return tr_R_on(g_tp.sram.cell_a_w, NCH, 1, false, true); }
+
+  static void port_leakage(double & acc, double & /*rd*/)
+  {
+    acc = g_ip->sram_cell_design.getPleakAccTx(g_tp.sram_cell.Vdd, g_tp.sram_cell.H_fin);
+  }
+
+  static void wordline_bitline_C(double c_w_metal, int num_cols, double cell_w,
+                                 double & C_rwl, double & C_wl, double & C_b_row_drain_C)
+  {
+    C_rwl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols; // Alireza
+    C_wl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
+    C_b_row_drain_C = drain_C_(g_tp.sram.cell_a_w, NCH, 1, 0, cell_w, false, true) / 2.0;  // due to shared contact
+  }
+};
+
+
+struct Cell8T
+{
+  static const SRAMcell_type type = std_8T;
+  static const bool rd_wordline   = true;
+  static const bool rwl_inv_demux = false;
+  static const bool rwl_on_write  = false;
+  static const bool skewed_inv_sa = true;
+
+  // read path: isolator (M7) and read access transistor (M8)
+  static double R_pull_down() { return tr_R_on(g_tp.sram.cell_rd_iso_w, NCH, 1, false, true); }
+  static double R_acc()       { return tr_R_on(g_tp.sram.cell_rd_a_w, NCH, 1, false, true); }
+
+  static void port_leakage(double & acc, double & rd)
+  {
+    acc = g_ip->sram_cell_design.getPleakAccTx(g_tp.sram_cell.Vdd, g_tp.sram_cell.H_fin);
+    rd  = acc * NAND2_LEAK_STACK_FACTOR;
+  }
+
+  // the read bitline (RBL) sees the read access transistor
+  static void wordline_bitline_C(double c_w_metal, int num_cols, double cell_w,
+                                 double & C_rwl, double & C_wl, double & C_b_row_drain_C)
+  {
+    C_rwl = (gate_C_pass(g_tp.sram.cell_rd_a_w, 0, false, true) + c_w_metal) * num_cols; // Alireza
+    C_wl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
+    C_b_row_drain_C = drain_C_(g_tp.sram.cell_rd_a_w, NCH, 1, 0, cell_w, false, true) / 2.0;  // due to shared contact
+  }
+};
+
+
+struct Cell10T
+{
+  static const SRAMcell_type type = std_10T;
+  static const bool rd_wordline   = true;
+  static const bool rwl_inv_demux = true;
+  static const bool rwl_on_write  = true;
+  static const bool skewed_inv_sa = false;
+
+  // read path: isolator and read access transistor (Francesco)
+  static double R_pull_down() { return tr_R_on(g_tp.sram.cell_iso_w, NCH, 1, false, true); }
+  static double R_acc()       { return tr_R_on(g_tp.sram.cell_readacc_w, NCH, 1, false, true); }
+
+  static void port_leakage(double & acc, double & rd)
+  {
+    double Ileak_a2 = cmos_Ileak(g_tp.sram.cell_readacc_w, 0,  false, true);
+    double Ileak_a1 = cmos_Ileak(g_tp.sram.cell_acc_w, 0,  false, true);
+    acc = g_tp.sram_cell.Vdd * (Ileak_a2 + Ileak_a1);
+    rd  = g_tp.sram_cell.Vdd * (Ileak_a2 * LEAK_STACK_FACTOR);
+  }
+
+  static void wordline_bitline_C(double c_w_metal, int num_cols, double cell_w,
+                                 double & C_rwl, double & C_wl, double & C_b_row_drain_C)
+  {
+    C_rwl = (gate_C_pass(g_tp.sram.cell_readacc_w, (g_tp.sram.b_w-2*g_tp.sram.cell_readacc_w)/2.0, false, true)*2 + c_w_metal) * num_cols; // Alireza
+    C_wl = (gate_C_pass(g_tp.sram.cell_acc_w, (g_tp.sram.b_w-2*g_tp.sram.cell_acc_w-2*g_tp.sram.cell_readacc_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
+    C_b_row_drain_C = drain_C_(g_tp.sram.cell_readacc_w, NCH, 1, 0, cell_w, false, true) / 2.0;  // due to shared contact
+  }
+};
+
+
+// calls obj->fn<Policy>(args) for the configured SRAM cell
+#define SRAM_CELL_DISPATCH(obj, fn, args) \
+  switch (g_ip->sram_cell_design.getType()) \
+  { \
+    case std_8T:  return (obj)->template fn<Cell8T> args; \
+    case std_10T: return (obj)->template fn<Cell10T> args; \
+    default:      return (obj)->template fn<Cell6T> args; \
+  }
+
+#endif
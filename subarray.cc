@@ -44,6 +44,7 @@
 #include <math.h>
 
 #include "subarray.h"
+#include "sram_cell.h"
 
 
 Subarray::Subarray(const DynamicParameter & dp_, bool is_fa_):
@@ -135,8 +136,7 @@ Subarray::Subarray(const DynamicParameter & dp_, bool is_fa_):
     }
     else
     {
-      cout << "unsupported combination of RWP, ERP, and EWP" << endl;
-      exit(1);
+      throw cacti_error("unsupported combination of RWP, ERP, and EWP", 1);
     }
 
     area.h = (CAM2x2_h_1p + 2*overhead_h) * ((num_rows + 1)/2);
@@ -191,38 +191,24 @@ void Subarray::compute_C()
   }
   else
   {
-    //C_rwl = (gate_C_pass(g_tp.sram.cell_rd_a_w, 0, false, true) + c_w_metal) * num_cols; // Alireza
-    //C_wl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
-    //C_b_row_drain_C = drain_C_(g_tp.sram.cell_a_w, NCH, 1, 0, cell.w, false, true) / 2.0;  // due to shared contact
-    //C_bl = num_rows * (C_b_row_drain_C + C_b_metal);
-
-    //Francesco start
-    if(g_ip->sram_cell_design.getType() == std_6T){
-      C_rwl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols; // Alireza
-      C_wl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
-      C_b_row_drain_C = drain_C_(g_tp.sram.cell_a_w, NCH, 1, 0, cell.w, false, true) / 2.0;  // due to shared contact
-      C_bl = num_rows * (C_b_row_drain_C + C_b_metal);
-      //C_wbl = C_bl; //Francesco: the bitline capacitance for the reading and writing is the same in the 6T and 10T SRAM cell
-    } else if (g_ip->sram_cell_design.getType() == std_10T) {
-      C_rwl = (gate_C_pass(g_tp.sram.cell_readacc_w, (g_tp.sram.b_w-2*g_tp.sram.cell_readacc_w)/2.0, false, true)*2 + c_w_metal) * num_cols; // Alireza
-      C_wl = (gate_C_pass(g_tp.sram.cell_acc_w, (g_tp.sram.b_w-2*g_tp.sram.cell_acc_w-2*g_tp.sram.cell_readacc_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
-      C_b_row_drain_C = drain_C_(g_tp.sram.cell_readacc_w, NCH, 1, 0, cell.w, false, true) / 2.0;  // due to shared contact
-      C_bl = num_rows * (C_b_row_drain_C + C_b_metal);
-    } else { //this part is related to 8T SRAM cell
-      C_rwl = (gate_C_pass(g_tp.sram.cell_rd_a_w, 0, false, true) + c_w_metal) * num_cols; // Alireza
-      C_wl = (gate_C_pass(g_tp.sram.cell_a_w, (g_tp.sram.b_w-2*g_tp.sram.cell_a_w)/2.0, false, true)*2 + c_w_metal) * num_cols;
-      //C_b_row_drain_C = drain_C_(g_tp.sram.cell_a_w, NCH, 1, 0, cell.w, false, true) / 2.0;  // due to shared contact
-      //Francesco: The cell to be considered is that one attached to the reading bitline (RBL)
-      C_b_row_drain_C = drain_C_(g_tp.sram.cell_rd_a_w, NCH, 1, 0, cell.w, false, true) / 2.0;  // due to shared contact
-      C_bl = num_rows * (C_b_row_drain_C + C_b_metal);
-      //Francesco: the bitline capacitance for the writing is different from the reading one because, in the 8T SRAM cell,
-      //there are two different bitlines: one for the writing (WBL) and one for the reading (RBL).
-      //Hence, the transistor which is connected to the bitline is different
-      //C_b_row_drain_C = drain_C_(g_tp.sram.cell_a_w, NCH, 1, 0, cell.w, false, true) / 2.0;
-      //C_wbl = num_rows * (C_b_row_drain_C + C_b_metal);
-    }
-    //Francesco end
-
+    compute_sram_C(c_w_metal, C_b_metal);
   }
 }
 
+
+
+template <class Cell>
+void Subarray::compute_sram_C(double c_w_metal, double C_b_metal)
+{
+  double C_b_row_drain_C;
+  Cell::wordline_bitline_C(c_w_metal, num_cols, cell.w, C_rwl, C_wl, C_b_row_drain_C);
+  C_bl = num_rows * (C_b_row_drain_C + C_b_metal);
+}
+
+
+
+void Subarray::compute_sram_C(double c_w_metal, double C_b_metal)
+{
+  SRAM_CELL_DISPATCH(this, compute_sram_C, (c_w_metal, C_b_metal));
+}
+
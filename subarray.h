@@ -69,6 +69,8 @@ class Subarray : public Component
   private:
 
     void compute_C();  // compute bitline and wordline capacitance
+    void compute_sram_C(double c_w_metal, double C_b_metal);
+    template <class Cell> void compute_sram_C(double c_w_metal, double C_b_metal);  // see sram_cell.h
 };
 
 
@@ -0,0 +1,521 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <fstream>
+#include <map>
+#include <iostream>
+#include <sstream>
+#include <stdio.h>
+
+#include "sweep.h"
+#include "journal.h"
+#include "Ucache.h"
+#include "xmlParser.h"
+
+using namespace std;
+
+
+
+static bool read_file(const string & file, string & contents)
+{
+  ifstream in(file.c_str(), ios::binary);
+  if (!in)
+  {
+    return false;
+  }
+  ostringstream ss;
+  ss << in.rdbuf();
+  contents = ss.str();
+  return true;
+}
+
+
+
+// files named by the cfg of a point: the device files of both arrays, and
+// its <sram_cell> unless the line gives cell=
+static void referenced_files(const sweep_point & sp, vector<string> & files)
+{
+  XMLResults res;
+  XMLNode cfg = XMLNode::parseFile(sp.cfg_file.c_str(), "cache_config", &res);
+  if (res.error != eXMLErrorNone)
+  {
+    return;  // the point fails in parse_cfg()
+  }
+
+  const char * arrays[]  = {"data_array", "tag_array"};
+  const char * devices[] = {"cell", "peripheral"};
+  for (int a = 0; a < 2; a++)
+  {
+    for (int d = 0; d < 2; d++)
+    {
+      XMLNode n = cfg.getChildNode("devices").getChildNode(arrays[a]).getChildNode(devices[d]);
+      if (!n.isEmpty() && n.nText() > 0) files.push_back(n.getText(0));
+    }
+  }
+  XMLNode cell = cfg.getChildNode("sram_cell");
+  if (sp.sram_cell_file == "" && !cell.isEmpty() && cell.nText() > 0)
+  {
+    files.push_back(cell.getText(0));
+  }
+}
+
+
+
+// editing the cfg, cell or device files of a line makes it a new point
+static uint64_t sweep_key(const sweep_point & sp)
+{
+  string contents;
+  uint64_t h = fnv1a64(sp.label.data(), sp.label.size());
+
+  vector<string> files(1, sp.cfg_file);
+  if (sp.sram_cell_file != "")
+  {
+    files.push_back(sp.sram_cell_file);
+  }
+  referenced_files(sp, files);
+  for (uint32_t i = 0; i < files.size(); i++)
+  {
+    contents.clear();
+    read_file(files[i], contents);
+    h = fnv1a64(contents.data(), contents.size(), h);
+  }
+  return h;
+}
+
+
+
+static void sweep_list_error(const string & list_file, uint32_t line, const string & msg)
+{
+  cout << "ERROR: " << list_file << ":" << line << ": " << msg << endl;
+  exit(1);
+}
+
+
+
+bool parse_sweep_point(istream & tokens, sweep_point & sp, const string & list_file, uint32_t line_no)
+{
+  string tok;
+  bench_point & bp = sp.bp;
+  bool size_set = false, assoc_set = false, banks_set = false;
+
+  bp.cache_sz    = 0;
+  bp.assoc       = 0;
+  bp.nbanks      = 0;
+  bp.nuca        = false;
+  bp.is_cache    = -1;
+  bp.access_mode = -1;
+  bp.force_cache_config = false;
+
+  while (tokens >> tok)
+  {
+    sp.label += (sp.label == "" ? "" : " ") + tok;
+    if (sp.cfg_file == "")
+    {
+      sp.cfg_file = tok;
+      continue;
+    }
+
+    string::size_type eq = tok.find('=');
+    if (eq == string::npos || eq + 1 == tok.size())
+    {
+      sweep_list_error(list_file, line_no, "expected key=value, got " + tok);
+    }
+    string key = tok.substr(0, eq);
+    string val = tok.substr(eq + 1);
+    long   v   = atol(val.c_str());
+
+    if      (key == "cell")  sp.sram_cell_file = val;
+    else if (key == "size")  { bp.cache_sz = v; size_set  = true; }
+    else if (key == "assoc") { bp.assoc    = v; assoc_set = true; }
+    else if (key == "banks") { bp.nbanks   = v; banks_set = true; }
+    else if (key == "nuca")  bp.nuca        = (v != 0);
+    else if (key == "cache") bp.is_cache    = (v != 0);
+    else if (key == "mode")  bp.access_mode = v;
+    else if (key == "force") bp.force_cache_config = (v != 0);
+    else sweep_list_error(list_file, line_no, "unknown key " + key);
+  }
+
+  if (sp.cfg_file == "")
+  {
+    return false;
+  }
+  if ((size_set || assoc_set || banks_set) && !(size_set && assoc_set && banks_set))
+  {
+    sweep_list_error(list_file, line_no, "size, assoc and banks go together");
+  }
+  return true;
+}
+
+
+
+void finish_sweep_point(sweep_point & sp)
+{
+  sp.bp.cfg_file       = sp.cfg_file.c_str();
+  sp.bp.sram_cell_file = (sp.sram_cell_file == "") ? NULL : sp.sram_cell_file.c_str();
+  sp.key               = sweep_key(sp);
+}
+
+
+
+void load_sweep_list(const string & list_file, vector<sweep_point> & points)
+{
+  ifstream in(list_file.c_str());
+  string line;
+  uint32_t line_no = 0;
+
+  if (!in)
+  {
+    cout << "ERROR: cannot open sweep list " << list_file << endl;
+    exit(1);
+  }
+
+  while (getline(in, line))
+  {
+    line_no++;
+    line = line.substr(0, line.find('#'));
+
+    istringstream tokens(line);
+    sweep_point sp;
+    if (parse_sweep_point(tokens, sp, list_file, line_no))
+    {
+      points.push_back(sp);
+    }
+  }
+
+  // the strings are final now
+  for (uint32_t i = 0; i < points.size(); i++)
+  {
+    finish_sweep_point(points[i]);
+  }
+}
+
+
+
+uint32_t sweep_shard(const sweep_point & sp, uint32_t nshards)
+{
+  return sp.key % nshards;
+}
+
+
+
+const vector<string> & sweep_field_names()
+{
+  static vector<string> names;
+  if (names.empty())
+  {
+    const char * org[] = {"Ndwl", "Ndbl", "Nspd", "Ndcm", "Ndsam1", "Ndsam2", "wt"};
+    names.push_back("access_ns");
+    names.push_back("cycle_ns");
+    names.push_back("area_mm2");
+    names.push_back("read_nJ");
+    names.push_back("write_nJ");
+    names.push_back("leakage_mW");
+    for (uint32_t i = 0; i < 7; i++) names.push_back(string("data_") + org[i]);
+    for (uint32_t i = 0; i < 7; i++) names.push_back(string("tag_") + org[i]);
+  }
+  return names;
+}
+
+
+
+static void add_org(vector<double> & values, const mem_array * m)
+{
+  values.push_back(m ? m->Ndwl : 0);
+  values.push_back(m ? m->Ndbl : 0);
+  values.push_back(m ? m->Nspd : 0);
+  values.push_back(m ? m->deg_bl_muxing : 0);
+  values.push_back(m ? m->Ndsam_lev_1 : 0);
+  values.push_back(m ? m->Ndsam_lev_2 : 0);
+  values.push_back(m ? m->wt : 0);
+}
+
+
+
+void sweep_fields(const uca_org_t & r, vector<double> & values)
+{
+  values.clear();
+  values.push_back(r.access_time*1e9);
+  values.push_back(r.cycle_time*1e9);
+  values.push_back(r.area*1e-6);
+  values.push_back(r.power.readOp.dynamic*1e9);
+  values.push_back(r.power.writeOp.dynamic*1e9);
+  values.push_back(r.power.readOp.leakage*1e3);
+  add_org(values, r.data_array2);
+  add_org(values, r.tag_array2);
+}
+
+
+
+// the points that have results, in list order; a point that failed has
+// empty fields and its message in the error column
+static void write_sweep_csv(const string & out_file, const vector<sweep_point> & points,
+                            const map<uint64_t, vector<double> > & results,
+                            const map<uint64_t, string> & errors)
+{
+  ofstream csv(out_file.c_str());
+  if (!csv)
+  {
+    cout << "ERROR: cannot open " << out_file << " for writing" << endl;
+    exit(1);
+  }
+
+  const vector<string> & names = sweep_field_names();
+  csv << "index,point";
+  for (uint32_t i = 0; i < names.size(); i++) csv << "," << names[i];
+  csv << ",error" << endl;
+  csv.precision(10);
+  for (uint32_t p = 0; p < points.size(); p++)
+  {
+    map<uint64_t, vector<double> >::const_iterator it = results.find(points[p].key);
+    if (it == results.end())
+    {
+      continue;
+    }
+    map<uint64_t, string>::const_iterator err = errors.find(points[p].key);
+    csv << p << ",\"" << points[p].label << "\"";
+    if (err != errors.end() && err->second != "")
+    {
+      // the message may hold anything but a double quote
+      string msg = err->second;
+      for (uint32_t i = 0; i < msg.size(); i++) if (msg[i] == '"') msg[i] = '\'';
+      for (uint32_t i = 0; i < names.size(); i++) csv << ",";
+      csv << ",\"" << msg << "\"" << endl;
+      continue;
+    }
+    for (uint32_t i = 0; i < it->second.size(); i++) csv << "," << it->second[i];
+    csv << "," << endl;
+  }
+}
+
+
+
+void run_sweep(const string & list_file, const string & journal_file, const string & out_file,
+               uint32_t shard, uint32_t nshards)
+{
+  vector<sweep_point> points;
+  sweep_journal journal;
+  map<uint64_t, vector<double> > results;
+  map<uint64_t, string> errors;
+  uint32_t npoints = 0, nfinished = 0, nfailed = 0;
+
+  load_sweep_list(list_file, points);
+  if (!journal.open(journal_file))
+  {
+    cout << "ERROR: cannot open sweep journal " << journal_file << endl;
+    exit(1);
+  }
+  if (journal.bytes_dropped != 0)
+  {
+    cout << "Sweep journal: dropped a torn tail of " << journal.bytes_dropped << " bytes" << endl;
+  }
+  for (uint32_t p = 0; p < points.size(); p++)
+  {
+    if (sweep_shard(points[p], nshards) != shard) continue;
+    npoints++;
+    if (journal.point_done(points[p].key)) nfinished++;
+  }
+  cout << "Sweep: " << npoints << " points";
+  if (nshards > 1) cout << " in shard " << shard << "/" << nshards << " (of " << points.size() << ")";
+  cout << ", " << nfinished << " already finished, " << nthreads << " threads" << endl;
+
+  for (uint32_t p = 0; p < points.size(); p++)
+  {
+    const sweep_point & sp = points[p];
+    if (sweep_shard(sp, nshards) != shard || journal.point_done(sp.key))
+    {
+      continue;
+    }
+
+    // a point that fails is recorded with its error, the sweep goes on
+    uca_org_t fin_res;
+    int saved_fd = silence_stdout();
+    try
+    {
+      load_bench_point(sp.bp);
+      journal.begin_point(sp.key);
+      solve_journal = &journal;
+      solve_bench_point(sp.bp, &fin_res);
+    }
+    catch (const cacti_error & e)
+    {
+      restore_stdout(saved_fd);
+      solve_journal = NULL;
+      delete g_ip;
+      g_ip = NULL;
+
+      journal.record_point(sp.key, sp.label, p, vector<double>(), e.msg);
+      printf("%4u %-64s FAILED: %s\n", p, sp.label.c_str(), e.msg.c_str());
+      fflush(stdout);
+      continue;
+    }
+    restore_stdout(saved_fd);
+    solve_journal = NULL;
+
+    vector<double> values;
+    sweep_fields(fin_res, values);
+    journal.record_point(sp.key, sp.label, p, values);
+
+    printf("%4u %-64s %8.4f ns %10.4f nJ", p, sp.label.c_str(), values[0], values[3]);
+    if (journal.passes_restored != 0)
+    {
+      printf("  (resumed, %u pass(es) from the journal)", journal.passes_restored);
+    }
+    printf("\n");
+    fflush(stdout);
+
+    delete fin_res.data_array2;
+    delete fin_res.tag_array2;
+    delete g_ip;
+  }
+
+  // leave only the point records behind for sweep_merge()
+  journal.compact();
+
+  for (uint32_t p = 0; p < points.size(); p++)
+  {
+    if (sweep_shard(points[p], nshards) == shard)
+    {
+      journal.point_done(points[p].key, NULL, NULL, &results[points[p].key], &errors[points[p].key]);
+      if (errors[points[p].key] != "") nfailed++;
+    }
+  }
+  write_sweep_csv(out_file, points, results, errors);
+  cout << "Sweep results written to " << out_file;
+  if (nfailed != 0) cout << " (" << nfailed << " of " << npoints << " points failed)";
+  cout << endl;
+}
+
+
+
+int merge_sweep(const string & list_file, const vector<string> & journal_files, const string & out_file)
+{
+  vector<sweep_point> points;
+  map<uint64_t, uint32_t> index_of;
+  map<uint64_t, vector<double> > results;
+  map<uint64_t, string> errors;
+  uint32_t nerrors = 0;
+
+  load_sweep_list(list_file, points);
+  for (uint32_t p = 0; p < points.size(); p++)
+  {
+    index_of[points[p].key] = p;
+  }
+
+  for (uint32_t j = 0; j < journal_files.size(); j++)
+  {
+    // one journal open at a time, there may be hundreds
+    sweep_journal journal;
+    vector<uint64_t> keys;
+
+    if (!journal.open(journal_files[j], true))
+    {
+      cout << "ERROR: " << journal_files[j] << ": cannot open, or not a sweep journal" << endl;
+      nerrors++;
+      continue;
+    }
+    if (journal.bytes_dropped != 0)
+    {
+      cout << "WARNING: " << journal_files[j] << ": ignoring a torn tail of " << journal.bytes_dropped
+           << " bytes (shard still running?)" << endl;
+    }
+
+    journal.point_keys(keys);
+    for (uint32_t k = 0; k < keys.size(); k++)
+    {
+      string label;
+      uint32_t index;
+      vector<double> values;
+      string error;
+      journal.point_done(keys[k], &label, &index, &values, &error);
+
+      map<uint64_t, uint32_t>::const_iterator it = index_of.find(keys[k]);
+      if (it == index_of.end() || points[it->second].label != label)
+      {
+        cout << "ERROR: " << journal_files[j] << ": result for \"" << label
+             << "\" does not match the current list or its input files" << endl;
+        nerrors++;
+        continue;
+      }
+      if (error == "" && values.size() != sweep_field_names().size())
+      {
+        cout << "ERROR: " << journal_files[j] << ": point " << it->second << " has "
+             << values.size() << " fields" << endl;
+        nerrors++;
+        continue;
+      }
+      if (results.count(keys[k]) && (results[keys[k]] != values || errors[keys[k]] != error))
+      {
+        cout << "ERROR: " << journal_files[j] << ": point " << it->second
+             << " differs from its result in an earlier journal" << endl;
+        nerrors++;
+        continue;
+      }
+      results[keys[k]] = values;
+      errors[keys[k]]  = error;
+    }
+  }
+
+  uint32_t nmissing = 0;
+  for (uint32_t p = 0; p < points.size(); p++)
+  {
+    if (results.count(points[p].key) == 0)
+    {
+      if (nmissing++ < 10)
+      {
+        cout << "ERROR: no result for point " << p << " (" << points[p].label << ")" << endl;
+      }
+    }
+  }
+  if (nmissing > 10)
+  {
+    cout << "ERROR: ... " << nmissing - 10 << " more points without a result" << endl;
+  }
+  nerrors += nmissing;
+
+  cout << "Merged " << results.size() << " of " << points.size() << " points from "
+       << journal_files.size() << " journal(s), " << nerrors << " error(s)" << endl;
+  if (nerrors == 0)
+  {
+    write_sweep_csv(out_file, points, results, errors);
+    cout << "Sweep results written to " << out_file << endl;
+  }
+  return nerrors;
+}
@@ -0,0 +1,105 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __SWEEP_H__
+#define __SWEEP_H__
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "bench.h"
+
+using namespace std;
+
+
+// one line of a sweep list
+struct sweep_point
+{
+  string      label;           // the line, whitespace normalized
+  string      cfg_file;
+  string      sram_cell_file;  // empty keeps the cell of cfg_file
+  bench_point bp;              // points into cfg_file and sram_cell_file
+  uint64_t    key;             // label and input file contents, see sweep_key()
+};
+
+/*
+ * Reads a sweep list: one point per line, '#' starts a comment.
+ *
+ *   <cfg_file> [cell=<sram cell file>] [size=<bytes> assoc=<n> banks=<n>]
+ *              [nuca=0|1] [cache=0|1] [mode=<access mode>] [force=0|1]
+ *
+ * Unset keys keep the value of cfg_file, as in a bench_point.
+ */
+void load_sweep_list(const string & list_file, vector<sweep_point> & points);
+
+// Parses the rest of one list line into sp (exits on a malformed line);
+// false if it holds no point. Once sp has its final address,
+// finish_sweep_point() points sp.bp at its strings and sets sp.key.
+bool parse_sweep_point(istream & tokens, sweep_point & sp, const string & list_file, uint32_t line_no);
+void finish_sweep_point(sweep_point & sp);
+
+// CSV column names and values of the result of one point
+const vector<string> & sweep_field_names();
+void sweep_fields(const uca_org_t & r, vector<double> & values);
+
+// shard of a point: its key modulo nshards, so every process agrees on it
+uint32_t sweep_shard(const sweep_point & sp, uint32_t nshards);
+
+/*
+ * Solves every point of list_file in the given shard that is not yet
+ * finished in journal_file (see journal.h), checkpointing each array pass
+ * and each finished point, then writes the results of the shard, in list
+ * order, to out_file. The shards of one list share no state, so they can
+ * run as separate processes on any machines that see the same files.
+ */
+void run_sweep(const string & list_file, const string & journal_file, const string & out_file,
+               uint32_t shard = 0, uint32_t nshards = 1);
+
+/*
+ * Collects the point results of the shard journals and checks them against
+ * list_file: every result must belong to a point of the list as it is now
+ * (same line and input files), a point found in several journals must have
+ * identical results, and no point may be missing. Writes out_file only if
+ * all checks pass; returns the number of errors.
+ */
+int merge_sweep(const string & list_file, const vector<string> & journal_files, const string & out_file);
+
+#endif
@@ -40,9 +40,13 @@
  *------------------------------------------------------------*/
 
 #include <iostream> // Alireza
+#include <sstream>
+#include <map>
+#include <stdio.h>
 #include "basic_circuit.h"
 #include "parameter.h"
 #include "xmlParser.h"	// Majid
+#include "Ucache.h"
 using namespace std; // Alireza
 
 
@@ -67,6 +71,145 @@ double wire_capacitance(double wire_width, double wire_thickness, double wire_sp
 }
 
 
+#define VDD_SCALING_ALPHA 1.3  // alpha-power law exponent used by g_ip->vdd_override
+
+// Moves characterized on-currents from vdd_char to g_ip->vdd_override
+// (alpha-power law); off-currents are kept at their characterized values.
+static void scale_to_vdd_override(double v_th, double & vdd_char, double & I_on_n, double & I_on_p)
+{
+  double vdd = g_ip->vdd_override;
+  if (vdd - v_th < 0.05) {
+    ostringstream msg;
+    msg << "Vdd of " << vdd << " V is below or within 50 mV of the threshold voltage (" << v_th << " V)";
+    throw cacti_error(msg.str());
+  }
+  double s = pow((vdd - v_th) / (vdd_char - v_th), VDD_SCALING_ALPHA);
+  I_on_n  *= s;
+  I_on_p  *= s;
+  vdd_char = vdd;
+}
+
+
+// Values of one device_definition file under the current temperature and
+// threshold regime (cell files: sense amplifier; peripheral files: Vdsat,
+// mobility and gm ratio). They do not depend on the technology node, so
+// each file is parsed once per process instead of on every
+// init_tech_params() call.
+struct device_def
+{
+  double Lphy, Xj, t_ox;
+  double t_si, h_fin, p_fin;  // FinFETs only; p_fin < 0 if the file has none
+  double v_th, vdd, Vdsat;
+  double c_ox, c_junc_sidewall, c_junc_sidewall_gate, c_junc, c_fringe;
+  double sense_delay, sense_energy;
+  double mobility_eff, gmp_to_gmn_multiplier;
+  double I_on_n, I_on_p, I_off_n, I_off_p;
+};
+
+static double device_value(XMLNode node)
+{
+  double v;
+  sscanf(node.getText(0), "%lf", &v);
+  return v;
+}
+
+// the near_threshold or super_threshold child of node
+static XMLNode regime_node(XMLNode node)
+{
+  return node.getChildNode(g_ip->is_near_threshold ? "near_threshold" : "super_threshold");
+}
+
+static double current_value(XMLNode currents, const char * on_off, const char * mos)
+{
+  char temperature[10];
+  sprintf(temperature, "%d", g_ip->temp);
+  XMLNode regime = regime_node(currents.getChildNode(on_off).getChildNode(mos));
+  return device_value(regime.getChildNodeWithAttribute("temp", "val", temperature));
+}
+
+static const device_def & device_definition(const char * file, bool peri)
+{
+  static map<string, device_def> cache;
+
+  ostringstream key;
+  key << file << "|" << peri << "|" << g_ip->temp << "|" << g_ip->is_near_threshold << "|" << g_ip->is_finfet;
+  map<string, device_def>::iterator it = cache.find(key.str());
+  if (it != cache.end())
+  {
+    return it->second;
+  }
+
+  device_def & d = cache[key.str()];
+  XMLNode root_node = XMLNode::openFileHelper(file, "device_definition");
+  XMLNode geometry_node = root_node.getChildNode("geometries");
+  d.Lphy = device_value(geometry_node.getChildNode("Lphy"));
+  d.Xj   = device_value(geometry_node.getChildNode("Xj"));
+  d.t_ox = device_value(geometry_node.getChildNode("t_ox"));
+  d.t_si = d.h_fin = d.p_fin = -1;
+  if (g_ip->is_finfet)
+  {
+    XMLNode finfet_node = geometry_node.getChildNode("FinFET");
+    d.t_si  = device_value(finfet_node.getChildNode("t_si"));
+    d.h_fin = device_value(finfet_node.getChildNode("h_fin"));
+    if (!finfet_node.getChildNode("p_fin").isEmpty())
+    {
+      d.p_fin = device_value(finfet_node.getChildNode("p_fin"));
+    }
+  }
+
+  XMLNode voltages_node = root_node.getChildNode("voltages");
+  d.v_th  = device_value(voltages_node.getChildNode("v_th"));
+  d.vdd   = device_value(regime_node(voltages_node.getChildNode("vdd")));
+  d.Vdsat = peri ? device_value(regime_node(voltages_node.getChildNode("Vdsat"))) : 0;
+
+  XMLNode cap_node = root_node.getChildNode("capacitances");
+  d.c_ox                 = device_value(cap_node.getChildNode("c_ox"));
+  d.c_junc_sidewall      = device_value(cap_node.getChildNode("c_junc_sidewall"));
+  d.c_junc_sidewall_gate = device_value(cap_node.getChildNode("c_junc_sidewall_gate"));
+  d.c_junc               = device_value(cap_node.getChildNode("c_junc"));
+  d.c_fringe             = device_value(cap_node.getChildNode("c_fringe"));
+
+  d.sense_delay = d.sense_energy = 0;
+  d.mobility_eff = d.gmp_to_gmn_multiplier = 0;
+  if (peri)
+  {
+    d.mobility_eff          = device_value(root_node.getChildNode("mobility_eff"));
+    d.gmp_to_gmn_multiplier = device_value(root_node.getChildNode("gmp_to_gmn_multiplier"));
+  }
+  else
+  {
+    XMLNode senseAmp_node = root_node.getChildNode("sense_amplifier");
+    d.sense_delay  = device_value(regime_node(senseAmp_node.getChildNode("delay")));
+    d.sense_energy = device_value(regime_node(senseAmp_node.getChildNode("energy")));
+  }
+
+  XMLNode currents_node = root_node.getChildNode("currents");
+  d.I_on_n  = current_value(currents_node, "ON_current",  "NMOS");
+  d.I_on_p  = current_value(currents_node, "ON_current",  "PMOS");
+  d.I_off_n = current_value(currents_node, "OFF_current", "NMOS");
+  d.I_off_p = current_value(currents_node, "OFF_current", "PMOS");
+  return d;
+}
+
+
+const tech_perturbation * tech_perturb = NULL;
+
+// d, or a copy in buf with the value scaled by tech_perturb when it
+// targets these devices
+static const device_def & perturbed(const device_def & d, int target, device_def & buf)
+{
+  if (tech_perturb == NULL || tech_perturb->target != target)
+  {
+    return d;
+  }
+  buf = d;
+  double * v[Device_values] = { &buf.vdd, &buf.v_th, &buf.I_on_n, &buf.I_on_p, &buf.I_off_n,
+                                &buf.I_off_p, &buf.c_ox, &buf.c_fringe, &buf.c_junc, &buf.Lphy };
+  *v[tech_perturb->param] *= tech_perturb->factor;
+  return buf;
+}
+
+
 void init_tech_params(double technology, bool is_tag)
 {
 	int    iter, tech, tech_lo, tech_hi;
@@ -133,8 +276,7 @@ void init_tech_params(double technology, bool is_tag)
 	} else if ( technology < 16 && technology > 14 ) { // 15nm
 		tech_lo = 16; tech_hi = 14;
 	} else {
-		cout << "ERROR: Invalid technology node!" << endl;
-		exit(0);
+		throw cacti_error("Invalid technology node!");
 	}
 	/****** Alireza2 - END ******/
 
@@ -149,7 +291,7 @@ void init_tech_params(double technology, bool is_tag)
 	double Lphy, Xj, delta_L, Lelec, t_ox;
 	double p_fin, h_fin, t_si;
 	double v_th, Vdsat;
-	double c_junc, c_junc_sidewall, c_junc_sidewall_gate;
+	double c_junc, c_junc_sidewall;
 	double c_ox, c_g_ideal, c_fringe;
 	double I_on_n, I_on_p, I_off_n, I_off_p;
 	double Rnchannelon, Rpchannelon;
@@ -213,109 +355,29 @@ void init_tech_params(double technology, bool is_tag)
 	 
 		//-------------------- cell parameters begin --------------------------
 		//---------- Majid - BEGIN ----------
-		char temp_var[1000];
-		XMLNode root_node, geometry_node, voltages_node, cap_node, senseAmp_node;
-		XMLNode NMOS_ONcurrents_node, PMOS_ONcurrents_node, NMOS_OFFcurrents_node, PMOS_OFFcurrents_node;
-		
-		if ( is_tag ) {
-			root_node = XMLNode::openFileHelper(g_ip->tag_array_cell_tech_file,"device_definition");
-		} else {
-			root_node = XMLNode::openFileHelper(g_ip->data_array_cell_tech_file,"device_definition");
-		}
-		
-		geometry_node = root_node.getChildNode("geometries");
-		strcpy(temp_var,geometry_node.getChildNode("Lphy").getText(0));
-		sscanf(temp_var, "%lf", &(Lphy));
-		strcpy(temp_var,geometry_node.getChildNode("Xj").getText(0));
-		sscanf(temp_var, "%lf", &(Xj));
-		strcpy(temp_var,geometry_node.getChildNode("t_ox").getText(0));
-		sscanf(temp_var, "%lf", &(t_ox));
+		device_def cell_buf;
+		const device_def & cell = perturbed(device_definition(is_tag ? g_ip->tag_array_cell_tech_file : g_ip->data_array_cell_tech_file, false),
+		                                    Tt_cell, cell_buf);
+		Lphy     = cell.Lphy;
+		Xj       = cell.Xj;
+		t_ox     = cell.t_ox;
 		if ( g_ip->is_finfet ) {
-			strcpy(temp_var,geometry_node.getChildNode("FinFET").getChildNode("t_si").getText(0));
-			sscanf(temp_var, "%lf", &(t_si));
-			strcpy(temp_var,geometry_node.getChildNode("FinFET").getChildNode("h_fin").getText(0));
-			sscanf(temp_var, "%lf", &(h_fin));
-			if ( !geometry_node.getChildNode("FinFET").getChildNode("p_fin").isEmpty() ) {
-				strcpy(temp_var,geometry_node.getChildNode("FinFET").getChildNode("p_fin").getText(0));
-				sscanf(temp_var, "%lf", &(p_fin));
-			} else {
-				p_fin = (2 * lambda_um) + t_si;
-			}
-		}
-		
-		voltages_node = root_node.getChildNode("voltages");
-		strcpy(temp_var,voltages_node.getChildNode("v_th").getText(0));
-		sscanf(temp_var, "%lf", &(v_th));
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,voltages_node.getChildNode("vdd").getChildNode("near_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(vdd_cell));
-		} else {
-			strcpy(temp_var,voltages_node.getChildNode("vdd").getChildNode("super_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(vdd_cell));
-		}
-		
-		cap_node = root_node.getChildNode("capacitances");
-		strcpy(temp_var,cap_node.getChildNode("c_ox").getText(0));
-		sscanf(temp_var, "%lf", &(c_ox));
-		strcpy(temp_var,cap_node.getChildNode("c_junc_sidewall").getText(0));
-		sscanf(temp_var, "%lf", &(c_junc_sidewall));
-		strcpy(temp_var,cap_node.getChildNode("c_junc_sidewall_gate").getText(0));
-		sscanf(temp_var, "%lf", &(c_junc_sidewall_gate));
-		strcpy(temp_var,cap_node.getChildNode("c_junc").getText(0));
-		sscanf(temp_var, "%lf", &(c_junc));
-		strcpy(temp_var,cap_node.getChildNode("c_fringe").getText(0));
-		sscanf(temp_var, "%lf", &(c_fringe));
-		
-		senseAmp_node = root_node.getChildNode("sense_amplifier");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,senseAmp_node.getChildNode("delay").getChildNode("near_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(SENSE_AMP_D));
-			strcpy(temp_var,senseAmp_node.getChildNode("energy").getChildNode("near_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(SENSE_AMP_P));
-		} else {
-			strcpy(temp_var,senseAmp_node.getChildNode("delay").getChildNode("super_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(SENSE_AMP_D));
-			strcpy(temp_var,senseAmp_node.getChildNode("energy").getChildNode("super_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(SENSE_AMP_P));
-		}
-
-		char temperature[10];
-		sprintf(temperature,"%d",g_ip->temp);
-		NMOS_ONcurrents_node = root_node.getChildNode("currents").getChildNode("ON_current").getChildNode("NMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,NMOS_ONcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_n));
-		} else {
-			strcpy(temp_var,NMOS_ONcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_n));
-		}
-
-		PMOS_ONcurrents_node = root_node.getChildNode("currents").getChildNode("ON_current").getChildNode("PMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,PMOS_ONcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_p));
-		} else {
-			strcpy(temp_var,PMOS_ONcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_p));
-		}
-
-		NMOS_OFFcurrents_node = root_node.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,NMOS_OFFcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_n));
-		} else {
-			strcpy(temp_var,NMOS_OFFcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_n));
-		}
-
-		PMOS_OFFcurrents_node = root_node.getChildNode("currents").getChildNode("OFF_current").getChildNode("PMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,PMOS_OFFcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_p));
-		} else {
-			strcpy(temp_var,PMOS_OFFcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_p));
+			t_si  = cell.t_si;
+			h_fin = cell.h_fin;
+			p_fin = (cell.p_fin < 0) ? (2 * lambda_um) + t_si : cell.p_fin;
 		}
+		v_th     = cell.v_th;
+		vdd_cell = cell.vdd;
+		c_ox     = cell.c_ox;
+		c_junc_sidewall      = cell.c_junc_sidewall;
+		c_junc   = cell.c_junc;
+		c_fringe = cell.c_fringe;
+		SENSE_AMP_D = cell.sense_delay;
+		SENSE_AMP_P = cell.sense_energy;
+		I_on_n   = cell.I_on_n;
+		I_on_p   = cell.I_on_p;
+		I_off_n  = cell.I_off_n;
+		I_off_p  = cell.I_off_p;
 		//---------- Majid - END ------------
 
 		/***** Alireza - BEGIN *****/
@@ -367,8 +429,7 @@ void init_tech_params(double technology, bool is_tag)
 				curr_asp_ratio_cell_sram = 0.4;
             //Francesco end
             }else {
-				cout << "ERROR: Invalid SRAM cell type in technology.cc!\n";
-				exit(0);
+				throw cacti_error("Invalid SRAM cell type in technology.cc!");
 			}
 		}
 
@@ -378,9 +439,9 @@ void init_tech_params(double technology, bool is_tag)
 		c_g_ideal = Lphy * c_ox;
 		Lelec = Lphy - delta_L;
 		if ( Lelec <=0 ) {
-			cout << "ERROR: Lelec (ram_cell) is not a positive value! Please check the Lphy or the Xj value.\n";
-			exit(0);
+			throw cacti_error("Lelec (ram_cell) is not a positive value! Please check the Lphy or the Xj value.");
 		}
+		if (g_ip->vdd_override > 0) scale_to_vdd_override(v_th, vdd_cell, I_on_n, I_on_p);
 		n_to_p_eff_curr_drv_ratio = I_on_n / I_on_p;
 		Rnchannelon = vdd_cell / I_on_n;
 		Rpchannelon = vdd_cell / I_on_p;
@@ -405,100 +466,30 @@ void init_tech_params(double technology, bool is_tag)
 
 		//-------------------- peripheral parameters begin --------------------
 		//---------- Majid - BEGIN ----------
-		if ( is_tag ) {
-			root_node = XMLNode::openFileHelper(g_ip->tag_array_peri_tech_file,"device_definition");
-		} else {
-			root_node = XMLNode::openFileHelper(g_ip->data_array_peri_tech_file,"device_definition");
-		}
-
-		geometry_node = root_node.getChildNode("geometries");
-		strcpy(temp_var,geometry_node.getChildNode("Lphy").getText(0));
-		sscanf(temp_var, "%lf", &(Lphy));
-		strcpy(temp_var,geometry_node.getChildNode("Xj").getText(0));
-		sscanf(temp_var, "%lf", &(Xj));
-		strcpy(temp_var,geometry_node.getChildNode("t_ox").getText(0));
-		sscanf(temp_var, "%lf", &(t_ox));
+		device_def peri_buf;
+		const device_def & peri = perturbed(device_definition(is_tag ? g_ip->tag_array_peri_tech_file : g_ip->data_array_peri_tech_file, true),
+		                                    Tt_peri, peri_buf);
+		Lphy     = peri.Lphy;
+		Xj       = peri.Xj;
+		t_ox     = peri.t_ox;
 		if ( g_ip->is_finfet ) {
-			strcpy(temp_var,geometry_node.getChildNode("FinFET").getChildNode("t_si").getText(0));
-			sscanf(temp_var, "%lf", &(t_si));
-			strcpy(temp_var,geometry_node.getChildNode("FinFET").getChildNode("h_fin").getText(0));
-			sscanf(temp_var, "%lf", &(h_fin));
-			if ( !geometry_node.getChildNode("FinFET").getChildNode("p_fin").isEmpty() ) {
-				strcpy(temp_var,geometry_node.getChildNode("FinFET").getChildNode("p_fin").getText(0));
-				sscanf(temp_var, "%lf", &(p_fin));
-			} else {
-				p_fin = (2 * lambda_um) + t_si;
-			}
-		}
-
-		voltages_node = root_node.getChildNode("voltages");
-		strcpy(temp_var,voltages_node.getChildNode("v_th").getText(0));
-		sscanf(temp_var, "%lf", &(v_th));
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,voltages_node.getChildNode("vdd").getChildNode("near_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(vdd_peri));
-			strcpy(temp_var,voltages_node.getChildNode("Vdsat").getChildNode("near_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(Vdsat));
-		} else {
-			strcpy(temp_var,voltages_node.getChildNode("vdd").getChildNode("super_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(vdd_peri));
-			strcpy(temp_var,voltages_node.getChildNode("Vdsat").getChildNode("super_threshold").getText(0));
-			sscanf(temp_var, "%lf", &(Vdsat));
-		}
-
-		cap_node = root_node.getChildNode("capacitances");
-		strcpy(temp_var,cap_node.getChildNode("c_ox").getText(0));
-		sscanf(temp_var, "%lf", &(c_ox));
-		strcpy(temp_var,cap_node.getChildNode("c_junc_sidewall").getText(0));
-		sscanf(temp_var, "%lf", &(c_junc_sidewall));
-		strcpy(temp_var,cap_node.getChildNode("c_junc_sidewall_gate").getText(0));
-		sscanf(temp_var, "%lf", &(c_junc_sidewall_gate));
-		strcpy(temp_var,cap_node.getChildNode("c_junc").getText(0));
-		sscanf(temp_var, "%lf", &(c_junc));
-		strcpy(temp_var,cap_node.getChildNode("c_fringe").getText(0));
-		sscanf(temp_var, "%lf", &(c_fringe));
-
-		strcpy(temp_var,root_node.getChildNode("mobility_eff").getText(0));
-		sscanf(temp_var, "%lf", &(mobility_eff));
-
-		strcpy(temp_var,root_node.getChildNode("gmp_to_gmn_multiplier").getText(0));
-		sscanf(temp_var, "%lf", &(gmp_to_gmn_multiplier));
-
-		NMOS_ONcurrents_node = root_node.getChildNode("currents").getChildNode("ON_current").getChildNode("NMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,NMOS_ONcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_n));
-		} else {
-			strcpy(temp_var,NMOS_ONcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_n));
-		}
-
-		PMOS_ONcurrents_node = root_node.getChildNode("currents").getChildNode("ON_current").getChildNode("PMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,PMOS_ONcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_p));
-		} else {
-			strcpy(temp_var,PMOS_ONcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_on_p));
-		}
-
-		NMOS_OFFcurrents_node = root_node.getChildNode("currents").getChildNode("OFF_current").getChildNode("NMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,NMOS_OFFcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_n));
-		} else {
-			strcpy(temp_var,NMOS_OFFcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_n));
-		}
-
-		PMOS_OFFcurrents_node = root_node.getChildNode("currents").getChildNode("OFF_current").getChildNode("PMOS");
-		if ( g_ip->is_near_threshold ) {
-			strcpy(temp_var,PMOS_OFFcurrents_node.getChildNode("near_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_p));
-		} else {
-			strcpy(temp_var,PMOS_OFFcurrents_node.getChildNode("super_threshold").getChildNodeWithAttribute("temp","val",temperature).getText(0));
-			sscanf(temp_var, "%lf", &(I_off_p));
+			t_si  = peri.t_si;
+			h_fin = peri.h_fin;
+			p_fin = (peri.p_fin < 0) ? (2 * lambda_um) + t_si : peri.p_fin;
 		}
+		v_th     = peri.v_th;
+		vdd_peri = peri.vdd;
+		Vdsat    = peri.Vdsat;
+		c_ox     = peri.c_ox;
+		c_junc_sidewall      = peri.c_junc_sidewall;
+		c_junc   = peri.c_junc;
+		c_fringe = peri.c_fringe;
+		mobility_eff          = peri.mobility_eff;
+		gmp_to_gmn_multiplier = peri.gmp_to_gmn_multiplier;
+		I_on_n   = peri.I_on_n;
+		I_on_p   = peri.I_on_p;
+		I_off_n  = peri.I_off_n;
+		I_off_p  = peri.I_off_p;
 		//---------- Majid - END ------------
 
 		/***** Alireza - BEGIN *****/
@@ -512,9 +503,9 @@ void init_tech_params(double technology, bool is_tag)
 		c_g_ideal = Lphy * c_ox;
 		Lelec = Lphy - delta_L;
 		if ( Lelec <= 0 ) {
-			cout << "ERROR: Lelec (peri_global) is not a positive value! Please check the Lphy or the Xj value.\n";
-			exit(0);
+			throw cacti_error("Lelec (peri_global) is not a positive value! Please check the Lphy or the Xj value.");
 		}
+		if (g_ip->vdd_override > 0) scale_to_vdd_override(v_th, vdd_peri, I_on_n, I_on_p);
 		n_to_p_eff_curr_drv_ratio = I_on_n / I_on_p;
 		Rnchannelon = vdd_peri / I_on_n;
 		Rpchannelon = vdd_peri / I_on_p;
@@ -616,6 +607,35 @@ void init_tech_params(double technology, bool is_tag)
 	g_tp.w_comp_n      = 12.5 * g_ip->F_sz_um;//this was 10 micron for the 0.8 micron process
 	g_tp.w_comp_p      = 37.5 * g_ip->F_sz_um;//this was 30 micron for the 0.8 micron process
 
+	// fully-associative CAM tag, see Mat::delay_fa_tag()
+	g_tp.fa_cam.w_dec_drive_p     =  450 * g_ip->F_sz_um;//this was 360 micron for the 0.8 micron process
+	g_tp.fa_cam.w_dec_drive_n     =  300 * g_ip->F_sz_um;//this was 240 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_drive_n      = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_drive_p      =  125 * g_ip->F_sz_um;//this was 100 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_drive2_n     =  250 * g_ip->F_sz_um;//this was 200 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_drive2_p     =  500 * g_ip->F_sz_um;//this was 400 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_dec_drive1_n = 6.25 * g_ip->F_sz_um;//this was   5 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_dec_drive1_p = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_dec_drive2_n =   25 * g_ip->F_sz_um;//this was  20 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_dec_drive2_p =   50 * g_ip->F_sz_um;//this was  40 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_dec_drive_n  = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_dec_drive_p  =  125 * g_ip->F_sz_um;//this was 100 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_prech_n      =  7.5 * g_ip->F_sz_um;//this was   6 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_prech_p      = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
+	g_tp.fa_cam.w_dummy_n         = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
+	g_tp.fa_cam.w_dummy_inv_n     =   75 * g_ip->F_sz_um;//this was  60 micron for the 0.8 micron process
+	g_tp.fa_cam.w_dummy_inv_p     =  100 * g_ip->F_sz_um;//this was  80 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_inv_n        = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_inv_p        =   25 * g_ip->F_sz_um;//this was  20 micron for the 0.8 micron process
+	g_tp.fa_cam.w_addr_nand_n     = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process
+	g_tp.fa_cam.w_addr_nand_p     = 62.5 * g_ip->F_sz_um;//this was  50 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_nand_n       =   25 * g_ip->F_sz_um;//this was  20 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_nand_p       = 37.5 * g_ip->F_sz_um;//this was  30 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_nor_n        = 6.25 * g_ip->F_sz_um;//this was   5 micron for the 0.8 micron process
+	g_tp.fa_cam.w_fa_nor_p        = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
+	g_tp.fa_cam.w_dec_nand_n      = 12.5 * g_ip->F_sz_um;//this was  10 micron for the 0.8 micron process
+	g_tp.fa_cam.w_dec_nand_p      = 37.5 * g_ip->F_sz_um;//this was  30 micron for the 0.8 micron process
+
 	g_tp.MIN_GAP_BET_P_AND_N_DIFFS = 5 * g_ip->F_sz_um;
 	g_tp.MIN_GAP_BET_SAME_TYPE_DIFFS = 1.5 * g_ip->F_sz_um;
 	g_tp.HPOWERRAIL = 2 * g_ip->F_sz_um;
@@ -1671,6 +1691,13 @@ void init_tech_params(double technology, bool is_tag)
       g_tp.wire_outside_mat.R_per_um += curr_alpha * wire_r_per_micron[g_ip->ic_proj_type][g_ip->wire_os_mat_type];
       g_tp.wire_outside_mat.C_per_um += curr_alpha * wire_c_per_micron[g_ip->ic_proj_type][g_ip->wire_os_mat_type];
       
+      g_tp.unit_len_wire_del = g_tp.wire_inside_mat.R_per_um * g_tp.wire_inside_mat.C_per_um / 2;
+    }
+    if (tech_perturb != NULL && tech_perturb->target >= Tt_wire_inside_mat)
+    {
+      TechnologyParameter::InterconnectType & w =
+        (tech_perturb->target == Tt_wire_inside_mat) ? g_tp.wire_inside_mat : g_tp.wire_outside_mat;
+      (tech_perturb->param == 0 ? w.R_per_um : w.C_per_um) *= tech_perturb->factor;
       g_tp.unit_len_wire_del = g_tp.wire_inside_mat.R_per_um * g_tp.wire_inside_mat.C_per_um / 2;
     }
 	//-------------------- interconnect (wire) parameters end ----------------------------
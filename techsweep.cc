@@ -0,0 +1,254 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <time.h>
+
+#include "techsweep.h"
+#include "parameter.h"
+#include "wire.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+#define NSWEEP_MAX_MOVES 3  // window moves per node before the full grid is swept
+
+struct nsweep_point
+{
+  double   node;          // nm
+  double   access_time;
+  double   cycle_time;
+  double   read_energy;
+  double   write_energy;
+  double   leakage;
+  double   area;
+  partition_t data;
+  uint32_t windows;       // windowed solves, 0 for a cold start
+  bool     full;          // the full grid was swept
+  uint64_t partitions;    // calculate_time() calls of the node
+  double   time;          // s
+};
+
+
+static double wall_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+static partition_t partition_of(const mem_array * a)
+{
+  partition_t p;
+  p.Nspd        = a->Nspd;
+  p.Ndwl        = a->Ndwl;
+  p.Ndbl        = a->Ndbl;
+  p.Ndcm        = a->deg_bl_muxing;
+  p.Ndsam_lev_1 = a->Ndsam_lev_1;
+  p.Ndsam_lev_2 = a->Ndsam_lev_2;
+  return p;
+}
+
+
+// true if p is radius octaves from the center w in some dimension, so a
+// better partition may lie outside the window
+static bool on_edge(const partition_t & p, const partition_t & w, uint32_t radius)
+{
+  double span = (double)(1u << radius);
+  double v[6] = {p.Nspd, (double)p.Ndwl, (double)p.Ndbl, (double)p.Ndcm, (double)p.Ndsam_lev_1, (double)p.Ndsam_lev_2};
+  double c[6] = {w.Nspd, (double)w.Ndwl, (double)w.Ndbl, (double)w.Ndcm, (double)w.Ndsam_lev_1, (double)w.Ndsam_lev_2};
+  for (int i = 0; i < 6; i++)
+  {
+    if (v[i] == c[i] * span || v[i] * span == c[i]) return true;
+  }
+  return false;
+}
+
+
+static string org_string(const partition_t & p)
+{
+  ostringstream os;
+  os << p.Ndwl << ":" << p.Ndbl << ":" << p.Nspd << ":" << p.Ndcm << ":" << p.Ndsam_lev_1 << ":" << p.Ndsam_lev_2;
+  return os.str();
+}
+
+
+static void free_org(uca_org_t & org, int pure_ram)
+{
+  delete org.data_array2;
+  if (!pure_ram) delete org.tag_array2;
+  org.data_array2 = NULL;
+  org.tag_array2  = NULL;
+}
+
+
+void tech_sweep(uca_org_t * fin_res)
+{
+  if (g_ip->nuca == 1 || fin_res->data_array2 == NULL)
+  {
+    cout << "\nTechnology sweep: only supported for UCA organizations, skipped\n";
+    return;
+  }
+
+  int    pure_ram   = (!g_ip->is_cache || g_ip->is_main_mem);
+  bool   warm       = g_ip->nsweep_warm_start && !g_ip->fully_assoc;
+  double nominal_nm = g_ip->F_sz_nm;
+  double nominal_um = g_ip->F_sz_um;
+  vector<nsweep_point> table(g_ip->nsweep_points);
+
+  partition_window win;
+  win.radius = g_ip->nsweep_radius;
+  win.data   = partition_of(fin_res->data_array2);
+  win.tag    = pure_ram ? win.data : partition_of(fin_res->tag_array2);
+
+  // the nodes are solved one after the other, each on all threads
+  for (uint32_t i = 0; i < g_ip->nsweep_points; i++)
+  {
+    nsweep_point & p = table[i];
+    p.node = (g_ip->nsweep_points == 1) ? g_ip->nsweep_start :
+      g_ip->nsweep_start + i * (g_ip->nsweep_stop - g_ip->nsweep_start) / (g_ip->nsweep_points - 1);
+    g_ip->F_sz_nm = p.node;
+    g_ip->F_sz_um = p.node / 1000;
+
+    double   t0     = wall_time();
+    uint64_t evals0 = solve_partitions_evaluated;
+    init_tech_params(g_ip->F_sz_um, false);
+    Wire winit;
+
+    uca_org_t best;
+    best.data_array2 = NULL;
+    p.windows = 0;
+    p.full    = !warm;
+    while (warm && p.windows < NSWEEP_MAX_MOVES + 1)
+    {
+      p.windows++;
+      solve_window = &win;
+      solve(&best);
+      solve_window = NULL;
+
+      partition_t d = partition_of(best.data_array2);
+      partition_t t = pure_ram ? d : partition_of(best.tag_array2);
+      bool edge = on_edge(d, win.data, win.radius) || (!pure_ram && on_edge(t, win.tag, win.radius));
+      win.data = d;
+      win.tag  = t;
+      if (!edge) break;
+
+      free_org(best, pure_ram);
+      p.full = (p.windows == NSWEEP_MAX_MOVES + 1);
+    }
+    if (p.full)
+    {
+      solve(&best);
+      win.data = partition_of(best.data_array2);
+      win.tag  = pure_ram ? win.data : partition_of(best.tag_array2);
+    }
+
+    p.access_time  = best.access_time;
+    p.cycle_time   = best.cycle_time;
+    p.read_energy  = best.power.readOp.dynamic;
+    p.write_energy = best.power.writeOp.dynamic;
+    p.leakage      = best.power.readOp.leakage;
+    p.area         = best.area;
+    p.data         = win.data;
+    p.partitions   = solve_partitions_evaluated - evals0;
+    p.time         = wall_time() - t0;
+    free_org(best, pure_ram);
+  }
+
+  g_ip->F_sz_nm = nominal_nm;
+  g_ip->F_sz_um = nominal_um;
+  init_tech_params(g_ip->F_sz_um, false);
+  Wire winit;
+
+  uint64_t total_parts = 0;
+  double   total_time  = 0;
+  cout << "\nTechnology sweep (" << (warm ? "warm-started" : "full") << " solve per node):\n";
+  cout << "  node (nm)  access (ns)  cycle (ns)   read (nJ)  write (nJ)  leakage (mW)  area (mm2)"
+       << "  data Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2  windows  partitions     time (s)\n";
+  for (uint32_t i = 0; i < table.size(); i++)
+  {
+    const nsweep_point & p = table[i];
+    cout << setw(11) << p.node
+         << setw(13) << p.access_time*1e9
+         << setw(12) << p.cycle_time*1e9
+         << setw(12) << p.read_energy*1e9
+         << setw(12) << p.write_energy*1e9
+         << setw(14) << p.leakage*1e3
+         << setw(12) << p.area*1e-6 << "  "
+         << setw(38) << left << org_string(p.data) << right;
+    if (p.full) cout << setw(9) << "full";
+    else        cout << setw(9) << p.windows;
+    cout
+         << setw(12) << p.partitions
+         << setw(13) << p.time << endl;
+    total_parts += p.partitions;
+    total_time  += p.time;
+  }
+  cout << "  " << total_parts << " partitions evaluated in " << total_time << " s" << endl;
+
+  if (g_ip->nsweep_out_file[0] != '\0')
+  {
+    ofstream fout(g_ip->nsweep_out_file);
+    if (!fout)
+    {
+      throw cacti_error(string("cannot write ") + g_ip->nsweep_out_file);
+    }
+    fout << "node_nm,access_time_ns,cycle_time_ns,read_energy_nJ,write_energy_nJ,leakage_mW,area_mm2,"
+         << "data_Ndwl,data_Ndbl,data_Nspd,data_Ndcm,data_Ndsam1,data_Ndsam2,windows,full,partitions\n";
+    fout << setprecision(9);
+    for (uint32_t i = 0; i < table.size(); i++)
+    {
+      const nsweep_point & p = table[i];
+      fout << p.node << "," << p.access_time*1e9 << "," << p.cycle_time*1e9 << ","
+           << p.read_energy*1e9 << "," << p.write_energy*1e9 << "," << p.leakage*1e3 << ","
+           << p.area*1e-6 << "," << p.data.Ndwl << "," << p.data.Ndbl << "," << p.data.Nspd << ","
+           << p.data.Ndcm << "," << p.data.Ndsam_lev_1 << "," << p.data.Ndsam_lev_2 << ","
+           << p.windows << "," << p.full << "," << p.partitions << "\n";
+    }
+    cout << "Technology sweep written to " << g_ip->nsweep_out_file << endl;
+  }
+}
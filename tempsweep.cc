@@ -0,0 +1,145 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+#include "tempsweep.h"
+#include "parameter.h"
+#include "wire.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+void evaluate_org(const uca_org_t * org, mem_array * tag_arr, mem_array * data_arr)
+{
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  const mem_array * t = org->tag_array2;
+  const mem_array * d = org->data_array2;
+
+  // solve() initializes the wire tables with the data array devices
+  init_tech_params(g_ip->F_sz_um, false);
+  Wire winit;
+
+  if (!pure_ram)
+  {
+    init_tech_params(g_ip->F_sz_um, true);
+    calculate_time(true, pure_ram, t->Nspd, t->Ndwl, t->Ndbl, t->deg_bl_muxing,
+                   t->Ndsam_lev_1, t->Ndsam_lev_2, tag_arr, 0, NULL, NULL, false, NULL);
+    init_tech_params(g_ip->F_sz_um, false);
+  }
+  calculate_time(false, pure_ram, d->Nspd, d->Ndwl, d->Ndbl, d->deg_bl_muxing,
+                 d->Ndsam_lev_1, d->Ndsam_lev_2, data_arr, 0, NULL, NULL, g_ip->is_main_mem, NULL);
+}
+
+
+static void print_org_row(ostream & os, const uca_org_t & org)
+{
+  os << setw(12) << org.access_time*1e9
+       << setw(12) << org.cycle_time*1e9
+       << setw(12) << org.power.readOp.dynamic*1e9
+       << setw(12) << org.power.writeOp.dynamic*1e9
+       << setw(14) << org.power.readOp.leakage*1e3;
+}
+
+
+void temperature_sweep(uca_org_t * fin_res)
+{
+  if (g_ip->fully_assoc || g_ip->nuca == 1 || fin_res->data_array2 == NULL)
+  {
+    cout << "\nTemperature sweep: only supported for set-associative UCA organizations, skipped\n";
+    return;
+  }
+
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  unsigned int nominal_temp = g_ip->temp;
+
+  cout << "\nTemperature sweep of the selected organization (Ndwl " << fin_res->data_array2->Ndwl
+       << ", Ndbl " << fin_res->data_array2->Ndbl << ", Nspd " << fin_res->data_array2->Nspd
+       << ", Ndcm " << fin_res->data_array2->deg_bl_muxing << ", Ndsam " << fin_res->data_array2->Ndsam_lev_1
+       << "x" << fin_res->data_array2->Ndsam_lev_2 << "):\n";
+  cout << "    T (K)  access (ns)  cycle (ns)   read (nJ)  write (nJ)  leakage (mW)";
+  if (g_ip->tsweep_reoptimize)
+    cout << "  | best: access (ns)  cycle (ns)   read (nJ)  write (nJ)  leakage (mW)  Ndwl:Ndbl:Nspd:Ndcm:Ndsam1:Ndsam2";
+  cout << endl;
+
+  for (unsigned int temp = g_ip->tsweep_start; temp <= g_ip->tsweep_stop; temp += g_ip->tsweep_step)
+  {
+    g_ip->temp = temp;
+    g_ip->parse_sram_cell(g_ip->sram_cell_conf_file);
+
+    mem_array tag_arr, data_arr;
+    uca_org_t org;
+    evaluate_org(fin_res, &tag_arr, &data_arr);
+    org.tag_array2  = pure_ram ? NULL : &tag_arr;
+    org.data_array2 = &data_arr;
+    org.find_delay();
+    org.find_energy();
+    org.find_area();
+    org.find_cyc();
+
+    // the row is printed once complete, solve() below writes to cout
+    ostringstream row;
+    row << setw(9) << temp << " ";
+    print_org_row(row, org);
+
+    if (g_ip->tsweep_reoptimize)
+    {
+      uca_org_t best;
+      solve(&best);
+      row << "  |      ";
+      print_org_row(row, best);
+      row << "  " << best.data_array2->Ndwl << ":" << best.data_array2->Ndbl << ":"
+           << best.data_array2->Nspd << ":" << best.data_array2->deg_bl_muxing << ":"
+           << best.data_array2->Ndsam_lev_1 << ":" << best.data_array2->Ndsam_lev_2;
+      delete best.data_array2;
+      if (!pure_ram) delete best.tag_array2;
+    }
+    cout << row.str() << endl;
+  }
+
+  g_ip->temp = nominal_temp;
+  g_ip->parse_sram_cell(g_ip->sram_cell_conf_file);
+  init_tech_params(g_ip->F_sz_um, false);
+  Wire winit;
+}
@@ -0,0 +1,65 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __TEMPSWEEP_H__
+#define __TEMPSWEEP_H__
+
+#include "cacti_interface.h"
+
+
+/*
+ * Re-evaluates the organization chosen by solve() at every temperature of
+ * g_ip->tsweep_start..tsweep_stop. The partitioning is kept; only the
+ * technology tables (on/off currents) and the SRAM cell leakage are reloaded
+ * and the chosen tag/data arrays are rebuilt once per point, which is a
+ * single calculate_time() call per array instead of a full sweep. With
+ * g_ip->tsweep_reoptimize, solve() is also re-run at every point so the
+ * best organization at that temperature can be compared. Prints one table
+ * row per temperature; g_ip->temp and the technology tables are restored
+ * afterwards.
+ */
+void temperature_sweep(uca_org_t * fin_res);
+
+// rebuilds the tag (caches only) and data arrays of the organization chosen
+// in org with the current g_ip, as solve() would evaluate them
+void evaluate_org(const uca_org_t * org, mem_array * tag_arr, mem_array * data_arr);
+
+#endif
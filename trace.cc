@@ -0,0 +1,266 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "trace.h"
+#include "basic_circuit.h"
+#include "parameter.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+#define TRACE_LANES      4        // independent counter sets per thread
+#define TRACE_MIN_CHUNK  65536    // records, below this a thread is not worth it
+
+struct trace_chunk_struct
+{
+  const trace_record * rec;
+  uint64_t first;          // record range [first, last)
+  uint64_t last;
+  uint32_t block_shift;    // log2 of the block size, if block_div is 0
+  uint64_t block_div;      // block size if it is not a power of two
+  uint64_t bank_mask;      // nbanks - 1, nbanks is a power of two
+
+  vector<uint64_t> count;  // accesses per [bank * 2 + is_write]
+  uint64_t t_min;
+  uint64_t t_max;
+};
+
+
+static double wall_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+// The loop body only shifts, masks and increments; the lanes keep
+// back-to-back accesses to one bank from serializing on a single counter.
+template <bool divide>
+static void count_range(trace_chunk_struct * w, uint64_t * lane, uint32_t nb2)
+{
+  const trace_record * r = w->rec;
+  uint64_t t_min = w->t_min, t_max = w->t_max;
+  uint64_t i = w->first;
+
+  for (; i + TRACE_LANES <= w->last; i += TRACE_LANES)
+  {
+    for (uint32_t l = 0; l < TRACE_LANES; l++)
+    {
+      uint64_t a   = r[i + l].addr;
+      uint64_t s   = r[i + l].stamp;
+      uint64_t t   = s & ~TRACE_WRITE_BIT;
+      uint64_t blk = divide ? a / w->block_div : a >> w->block_shift;
+      t_min = (t < t_min) ? t : t_min;
+      t_max = (t > t_max) ? t : t_max;
+      lane[l * nb2 + (((blk & w->bank_mask) << 1) | (s >> 63))]++;
+    }
+  }
+  for (; i < w->last; i++)
+  {
+    uint64_t s   = r[i].stamp;
+    uint64_t t   = s & ~TRACE_WRITE_BIT;
+    uint64_t blk = divide ? r[i].addr / w->block_div : r[i].addr >> w->block_shift;
+    t_min = (t < t_min) ? t : t_min;
+    t_max = (t > t_max) ? t : t_max;
+    lane[((blk & w->bank_mask) << 1) | (s >> 63)]++;
+  }
+  w->t_min = t_min;
+  w->t_max = t_max;
+}
+
+
+static void * trace_chunk_worker(void * arg)
+{
+  trace_chunk_struct * w = (trace_chunk_struct *) arg;
+  uint32_t nb2 = 2 * (w->bank_mask + 1);
+  vector<uint64_t> lane(TRACE_LANES * nb2, 0);
+
+  if (w->block_div != 0) count_range<true>(w, &lane[0], nb2);
+  else                   count_range<false>(w, &lane[0], nb2);
+
+  w->count.assign(nb2, 0);
+  for (uint32_t l = 0; l < TRACE_LANES; l++)
+  {
+    for (uint32_t b = 0; b < nb2; b++)
+    {
+      w->count[b] += lane[l * nb2 + b];
+    }
+  }
+  return NULL;
+}
+
+
+
+const trace_record * map_trace(const char * file, uint64_t & n, size_t & len)
+{
+  int fd = open(file, O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0)
+  {
+    string msg = string("cannot read trace ") + file + ": " + strerror(errno);
+    if (fd >= 0) close(fd);
+    throw cacti_error(msg);
+  }
+  if (st.st_size == 0 || st.st_size % sizeof(trace_record) != 0)
+  {
+    ostringstream msg;
+    msg << "trace " << file << " is not a whole number of " << sizeof(trace_record) << "-byte records";
+    close(fd);
+    throw cacti_error(msg.str());
+  }
+  void * map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (map == MAP_FAILED)
+  {
+    string msg = string("cannot map trace ") + file + ": " + strerror(errno);
+    close(fd);
+    throw cacti_error(msg);
+  }
+  close(fd);  // the mapping stays valid
+  madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+  n   = st.st_size / sizeof(trace_record);
+  len = st.st_size;
+  return (const trace_record *) map;
+}
+
+
+
+void trace_energy(uca_org_t * fin_res)
+{
+  if (g_ip->nuca == 1)
+  {
+    cout << "\nTrace-driven energy: only supported for UCA organizations, skipped\n";
+    return;
+  }
+
+  uint32_t nbanks = g_ip->nbanks;
+  if (is_pow2(nbanks) == false)
+  {
+    throw cacti_error("trace-driven energy: the bank count must be a power of two", 1);
+  }
+
+  uint64_t n_rec;
+  size_t   map_len;
+  const trace_record * rec = map_trace(g_ip->trace_file, n_rec, map_len);
+
+  uint32_t n_thr  = (uint32_t) MAX(1, MIN((uint64_t) nthreads, n_rec / TRACE_MIN_CHUNK));
+  bool pow2_block = is_pow2(g_ip->line_sz);
+
+  trace_chunk_struct * work = new trace_chunk_struct[n_thr];
+  pthread_t * threads       = new pthread_t[n_thr];
+  double t0 = wall_time();
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    work[t].rec         = rec;
+    work[t].first       = n_rec * t / n_thr;
+    work[t].last        = n_rec * (t + 1) / n_thr;
+    work[t].block_shift = pow2_block ? _log2(g_ip->line_sz) : 0;
+    work[t].block_div   = pow2_block ? 0 : g_ip->line_sz;
+    work[t].bank_mask   = nbanks - 1;
+    work[t].t_min       = ~TRACE_WRITE_BIT;
+    work[t].t_max       = 0;
+    pthread_create(&threads[t], NULL, trace_chunk_worker, (void *) &work[t]);
+  }
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+  double t_scan = wall_time() - t0;
+  munmap((void *) rec, map_len);
+
+  vector<uint64_t> count(2 * nbanks, 0);
+  uint64_t t_min = ~TRACE_WRITE_BIT, t_max = 0;
+  for (uint32_t t = 0; t < n_thr; t++)
+  {
+    for (uint32_t b = 0; b < 2 * nbanks; b++) count[b] += work[t].count[b];
+    t_min = MIN(t_min, work[t].t_min);
+    t_max = MAX(t_max, work[t].t_max);
+  }
+  delete [] threads;
+  delete [] work;
+
+  uint64_t reads = 0, writes = 0;
+  for (uint32_t b = 0; b < nbanks; b++)
+  {
+    reads  += count[2 * b];
+    writes += count[2 * b + 1];
+  }
+
+  // every access holds its bank for one random cycle
+  double elapsed      = (t_max - t_min) * g_ip->trace_time_unit + fin_res->cycle_time;
+  double read_energy  = reads  * fin_res->power.readOp.dynamic;
+  double write_energy = writes * fin_res->power.writeOp.dynamic;
+  // the solver reports the leakage of one bank
+  double leak_energy  = elapsed * fin_res->power.readOp.leakage * nbanks;
+  double total        = read_energy + write_energy + leak_energy;
+
+  cout << "\nTrace-driven energy of " << g_ip->trace_file << " (" << n_rec << " accesses: "
+       << reads << " reads, " << writes << " writes, over " << elapsed * 1e6 << " us):\n";
+  cout << "    Dynamic read energy (uJ): " << read_energy * 1e6 << endl;
+  cout << "    Dynamic write energy (uJ): " << write_energy * 1e6 << endl;
+  cout << "    Leakage energy (uJ): " << leak_energy * 1e6 << endl;
+  cout << "    Total energy (uJ): " << total * 1e6 << "  average power (mW): " << total / elapsed * 1e3 << endl;
+  cout << "    Bank     reads    writes   busy (us)  utilization\n";
+  for (uint32_t b = 0; b < nbanks; b++)
+  {
+    double busy = (count[2 * b] + count[2 * b + 1]) * fin_res->cycle_time;
+    cout << setw(8) << b << setw(10) << count[2 * b] << setw(10) << count[2 * b + 1]
+         << setw(12) << busy * 1e6 << setw(13) << busy / elapsed
+         << ((busy > elapsed) ? "  (over one access per cycle)" : "") << endl;
+  }
+  cout << "    Scanned " << map_len / 1e9 << " GB with " << n_thr << " thread(s) in "
+       << t_scan * 1e3 << " ms (" << map_len / 1e9 / t_scan << " GB/s)" << endl;
+}
@@ -0,0 +1,74 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include <stdint.h>
+#include "cacti_interface.h"
+
+
+// one access of a binary trace file, little endian
+struct trace_record
+{
+  uint64_t addr;   // byte address
+  uint64_t stamp;  // bit 63: write; bits 0-62: time in trace_time_unit ticks
+};
+
+#define TRACE_WRITE_BIT  (1ULL << 63)
+
+// maps a whole trace file read-only, throws cacti_error on an unreadable or torn file;
+// release it with munmap(rec, len)
+const trace_record * map_trace(const char * file, uint64_t & n, size_t & len);
+
+
+/*
+ * Workload energy of the organization chosen by solve(). g_ip->trace_file
+ * is memory-mapped and split into one chunk per solver thread; every access
+ * is decoded to its bank (block-interleaved over g_ip->nbanks) and counted
+ * as a read or a write. Prints the dynamic read/write energy, the leakage
+ * energy of all banks over the traced interval (first to last timestamp
+ * plus one cycle), the busy time of every bank at one random cycle per
+ * access, and the scan throughput.
+ */
+void trace_energy(uca_org_t * fin_res);
+
+#endif
@@ -47,7 +47,7 @@
 
 
 UCA::UCA(const DynamicParameter & dyn_p)
- :dp(dyn_p), bank(dp), nbanks(g_ip->nbanks), refresh_power(0)
+ :dp(dyn_p), bank(dp), nbanks(g_ip->nbanks), refresh_power(0), eval_abort(Eval_complete)
 {
   int num_banks_ver_dir = 1 << ((bank.area.h > bank.area.w) ? _log2(nbanks)/2 : (_log2(nbanks) - _log2(nbanks)/2));
   int num_banks_hor_dir = nbanks/num_banks_ver_dir;
@@ -89,7 +89,10 @@ UCA::UCA(const DynamicParameter & dyn_p)
   // delay calculation
   double inrisetime = 0.0;
   compute_delays(inrisetime);
-  compute_power_energy();
+  if (eval_abort == Eval_complete)
+  {
+    compute_power_energy();
+  }
 }
 
 
@@ -105,7 +108,22 @@ UCA::~UCA()
 
 double UCA::compute_delays(double inrisetime)
 {
+  // the H-tree delays are known from the constructors; what remains of
+  // dp.max_access_time is the budget of the mat path (the fully-associative
+  // paths are not bounded)
+  if (dp.max_access_time > 0 && !g_ip->fully_assoc)
+  {
+    bank.mat.delay_budget = dp.max_access_time -
+      (htree_in_add->delay + bank.htree_in_add->delay +
+       bank.htree_out_data->delay + htree_out_data->delay);
+  }
+
   double outrisetime = bank.compute_delays(inrisetime);
+  if (bank.mat.eval_abort != Eval_complete)
+  {
+    eval_abort = bank.mat.eval_abort;
+    return outrisetime;
+  }
 
   double delay_array_to_mat = htree_in_add->delay + bank.htree_in_add->delay;
   double max_delay_before_row_decoder = delay_array_to_mat + bank.mat.r_predec->delay;
@@ -209,6 +227,12 @@ void UCA::compute_power_energy()
 {
   bank.compute_power_energy();
   power = bank.power;
+  // what is added below is not negative
+  if (dp.max_read_energy > 0 && power.readOp.dynamic > dp.max_read_energy)
+  {
+    eval_abort = Eval_abort_read_energy;
+    return;
+  }
 
   power_routing_to_bank.readOp.dynamic  = htree_in_add->power.readOp.dynamic + htree_out_data->power.readOp.dynamic;
   power_routing_to_bank.writeOp.dynamic = htree_in_add->power.readOp.dynamic + htree_in_data->power.readOp.dynamic;
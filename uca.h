@@ -94,6 +94,8 @@ class UCA : public Component
     double access_time;
     double precharge_delay;
     double multisubbank_interleave_cycle_time;
+
+    int    eval_abort;  // Eval_abort; the results are incomplete unless Eval_complete
 };
 
 #endif
@@ -0,0 +1,156 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "voltsweep.h"
+#include "tempsweep.h"
+#include "parameter.h"
+#include "wire.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+struct vsweep_point
+{
+  double vdd;
+  double access_time;
+  double cycle_time;
+  double read_energy;
+  double write_energy;
+  double leakage;
+  string error;  // why the point was skipped, e.g. Vdd too close to Vth
+};
+
+
+void voltage_sweep(uca_org_t * fin_res)
+{
+  if (g_ip->fully_assoc || g_ip->nuca == 1 || fin_res->data_array2 == NULL)
+  {
+    cout << "\nVoltage sweep: only supported for set-associative UCA organizations, skipped\n";
+    return;
+  }
+
+  int pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  vector<vsweep_point> curve(g_ip->vsweep_points);
+
+  // each point needs its own g_tp, so the points are evaluated one after the
+  // other; a point costs a single partition evaluation per array
+  for (uint32_t i = 0; i < g_ip->vsweep_points; i++)
+  {
+    vsweep_point & p = curve[i];
+    p.vdd = (g_ip->vsweep_points == 1) ? g_ip->vsweep_start :
+      g_ip->vsweep_start + i * (g_ip->vsweep_stop - g_ip->vsweep_start) / (g_ip->vsweep_points - 1);
+    g_ip->vdd_override = p.vdd;
+
+    mem_array tag_arr, data_arr;
+    uca_org_t org;
+    try
+    {
+      evaluate_org(fin_res, &tag_arr, &data_arr);
+    }
+    catch (const cacti_error & e)
+    {
+      p.error = e.msg;
+      continue;
+    }
+    org.tag_array2  = pure_ram ? NULL : &tag_arr;
+    org.data_array2 = &data_arr;
+    org.find_delay();
+    org.find_energy();
+    org.find_cyc();
+
+    p.access_time  = org.access_time;
+    p.cycle_time   = org.cycle_time;
+    p.read_energy  = org.power.readOp.dynamic;
+    p.write_energy = org.power.writeOp.dynamic;
+    p.leakage      = org.power.readOp.leakage;
+  }
+
+  g_ip->vdd_override = 0;
+  init_tech_params(g_ip->F_sz_um, false);
+  Wire winit;
+
+  cout << "\nVoltage sweep of the selected organization (Ndwl " << fin_res->data_array2->Ndwl
+       << ", Ndbl " << fin_res->data_array2->Ndbl << ", Nspd " << fin_res->data_array2->Nspd
+       << ", Ndcm " << fin_res->data_array2->deg_bl_muxing << ", Ndsam " << fin_res->data_array2->Ndsam_lev_1
+       << "x" << fin_res->data_array2->Ndsam_lev_2 << "):\n";
+  cout << "  Vdd (V)  access (ns)  cycle (ns)  f_max (GHz)   read (nJ)  write (nJ)  leakage (mW)\n";
+  for (uint32_t i = 0; i < curve.size(); i++)
+  {
+    if (curve[i].error != "")
+    {
+      cout << setw(9) << curve[i].vdd << "  skipped: " << curve[i].error << endl;
+      continue;
+    }
+    cout << setw(9) << curve[i].vdd
+         << setw(13) << curve[i].access_time*1e9
+         << setw(12) << curve[i].cycle_time*1e9
+         << setw(13) << 1e-9/curve[i].cycle_time
+         << setw(12) << curve[i].read_energy*1e9
+         << setw(12) << curve[i].write_energy*1e9
+         << setw(14) << curve[i].leakage*1e3 << endl;
+  }
+
+  if (g_ip->vsweep_out_file[0] != '\0')
+  {
+    ofstream fout(g_ip->vsweep_out_file);
+    if (!fout)
+    {
+      throw cacti_error(string("cannot write ") + g_ip->vsweep_out_file);
+    }
+    fout << "vdd_V,access_time_ns,cycle_time_ns,f_max_GHz,read_energy_nJ,write_energy_nJ,leakage_mW\n";
+    fout << setprecision(9);
+    for (uint32_t i = 0; i < curve.size(); i++)
+    {
+      if (curve[i].error != "") continue;
+      fout << curve[i].vdd << "," << curve[i].access_time*1e9 << "," << curve[i].cycle_time*1e9 << ","
+           << 1e-9/curve[i].cycle_time << "," << curve[i].read_energy*1e9 << ","
+           << curve[i].write_energy*1e9 << "," << curve[i].leakage*1e3 << "\n";
+    }
+    cout << "Voltage sweep written to " << g_ip->vsweep_out_file << endl;
+  }
+}
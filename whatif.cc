@@ -0,0 +1,468 @@
+/*------------------------------------------------------------
+ *                              CACTI 6.5
+ *         Copyright 2008 Hewlett-Packard Development Corporation
+ *                         All Rights Reserved
+ *
+ * Permission to use, copy, and modify this software and its documentation is
+ * hereby granted only under the following terms and conditions.  Both the
+ * above copyright notice and this permission notice must appear in all copies
+ * of the software, derivative works or modified versions, and any portions
+ * thereof, and both notices must appear in supporting documentation.
+ *
+ * Users of this software agree to the terms and conditions set forth herein, and
+ * hereby grant back to Hewlett-Packard Company and its affiliated companies ("HP")
+ * a non-exclusive, unrestricted, royalty-free right and license under any changes, 
+ * enhancements or extensions  made to the core functions of the software, including 
+ * but not limited to those affording compatibility with other hardware or software
+ * environments, but excluding applications which incorporate this software.
+ * Users further agree to use their best efforts to return to HP any such changes,
+ * enhancements or extensions that they make and inform HP of noteworthy uses of
+ * this software.  Correspondence should be provided to HP at:
+ *
+ *                       Director of Intellectual Property Licensing
+ *                       Office of Strategy and Technology
+ *                       Hewlett-Packard Company
+ *                       1501 Page Mill Road
+ *                       Palo Alto, California  94304
+ *
+ * This software may be distributed (but not offered for sale or transferred
+ * for compensation) to third parties, provided such third parties agree to
+ * abide by the terms and conditions of this notice.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND HP DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE, INCLUDING ALL IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS.   IN NO EVENT SHALL HP 
+ * CORPORATION BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS
+ * ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS
+ * SOFTWARE.
+ *------------------------------------------------------------*/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <list>
+#include <math.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "whatif.h"
+#include "io.h"
+#include "journal.h"
+#include "pareto.h"
+#include "search.h"
+#include "Ucache.h"
+
+using namespace std;
+
+
+#define WHATIF_KEPT_PASSES 8  // candidate sets kept per array pass
+
+
+// the layers of the model, as bits of whatif_input::layers
+enum Whatif_layer
+{
+  Wi_tech        = 1,   // g_tp and the wire tables
+  Wi_tag         = 2,   // tag array pass
+  Wi_data        = 4,   // data array pass
+  Wi_select      = 8,   // Pareto, filters and find_optimal_uca()
+  Wi_search_cost = 16   // objective of a heuristic <search>, an input of both passes then
+};
+
+struct whatif_input
+{
+  const char * name;
+  uint32_t     layers;  // Whatif_layer bits that depend on it
+  double       max;     // largest valid value, 0 = no bound
+};
+
+// in the order of whatif_field()
+static const whatif_input whatif_inputs[] =
+{
+  { "size",            Wi_tag | Wi_data,             0 },
+  { "block",           Wi_tag | Wi_data,             0 },
+  { "assoc",           Wi_tag | Wi_data,             0 },
+  { "banks",           Wi_tag | Wi_data,             0 },
+  { "rw_ports",        Wi_tag | Wi_data,             0 },
+  { "rd_ports",        Wi_tag | Wi_data,             0 },
+  { "wr_ports",        Wi_tag | Wi_data,             0 },
+  { "se_rd_ports",     Wi_tag | Wi_data,             0 },
+  { "mode",            Wi_tag | Wi_data,             Access_modes - 1 },
+  { "ecc",             Wi_tag | Wi_data,             1 },
+  { "out_width",       Wi_data,                      0 },
+  { "tag_width",       Wi_tag,                       0 },
+  { "tech_nm",         Wi_tech,                      0 },
+  { "temp",            Wi_tech,                      0 },
+  { "vdd",             Wi_tech,                      0 },
+  { "wire_projection", Wi_tech,                      1 },
+  { "weight_delay",    Wi_select | Wi_search_cost,   0 },
+  { "weight_dynamic",  Wi_select | Wi_search_cost,   0 },
+  { "weight_leakage",  Wi_select | Wi_search_cost,   0 },
+  { "weight_cycle",    Wi_select | Wi_search_cost,   0 },
+  { "weight_area",     Wi_select | Wi_search_cost,   0 },
+  { "ed",              Wi_select | Wi_search_cost,   2 },
+  { "dev_delay",       Wi_select | Wi_search_cost,   0 },
+  { "dev_dynamic",     Wi_select | Wi_search_cost,   0 },
+  { "dev_leakage",     Wi_select | Wi_search_cost,   0 },
+  { "dev_cycle",       Wi_select | Wi_search_cost,   0 },
+  { "dev_area",        Wi_select | Wi_search_cost,   0 },
+  { "max_access_ns",   Wi_tag | Wi_data | Wi_select, 0 },
+  { "max_cycle_ns",    Wi_tag | Wi_data | Wi_select, 0 },
+  { "max_area_mm2",    Wi_tag | Wi_data | Wi_select, 0 },
+  { "max_read_nJ",     Wi_tag | Wi_data | Wi_select, 0 },
+  { "max_leakage_mW",  Wi_tag | Wi_data | Wi_select, 0 }
+};
+
+static const uint32_t whatif_n_inputs = sizeof(whatif_inputs) / sizeof(whatif_inputs[0]);
+
+// one kept array pass
+struct whatif_pass
+{
+  uint64_t key;          // fingerprint of the inputs of the pass
+  array_candidates * c;
+};
+
+struct whatif_session
+{
+  uint64_t tech_key;
+  list<whatif_pass> tag_passes;   // most recently used first
+  list<whatif_pass> data_passes;
+  uca_org_t res;
+  bool     have_res;
+};
+
+
+
+static double wall_time()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+
+template <class T>
+static void access_field(T & f, double & v, bool set)
+{
+  if (set) f = (T) floor(v + 0.5);
+  else     v = f;
+}
+
+static void access_field(double & f, double scale, double & v, bool set)
+{
+  if (set) f = v * scale;
+  else     v = f / scale;
+}
+
+// Reads (set false) or writes input k of whatif_inputs in g_ip, in the
+// units of its name.
+static void whatif_field(uint32_t k, double & v, bool set)
+{
+  InputParameter * ip = g_ip;
+  hard_constraints & cl = ip->cache_limit;
+
+  switch (k)
+  {
+    case  0: access_field(ip->cache_sz, v, set); break;
+    case  1: access_field(ip->line_sz, v, set); break;
+    case  2: access_field(ip->assoc, v, set); break;
+    case  3: access_field(ip->nbanks, v, set); break;
+    case  4: access_field(ip->num_rw_ports, v, set); break;
+    case  5: access_field(ip->num_rd_ports, v, set); break;
+    case  6: access_field(ip->num_wr_ports, v, set); break;
+    case  7: access_field(ip->num_se_rd_ports, v, set); break;
+    case  8: access_field(ip->access_mode, v, set); break;
+    case  9: access_field(ip->add_ecc_b_, v, set); break;
+    case 10: access_field(ip->out_w, v, set); break;
+    case 11:
+      // 0 lets error_checking() derive the tag width
+      if (set) ip->specific_tag = (v > 0);
+      if (set || ip->specific_tag) access_field(ip->tag_w, v, set);
+      else v = 0;
+      break;
+    case 12:
+      access_field(ip->F_sz_nm, 1, v, set);
+      ip->F_sz_um = ip->F_sz_nm / 1000;
+      break;
+    case 13: access_field(ip->temp, v, set); break;
+    case 14: access_field(ip->vdd_override, 1, v, set); break;
+    case 15: access_field(ip->ic_proj_type, v, set); break;
+    case 16: access_field(ip->delay_wt, v, set); break;
+    case 17: access_field(ip->dynamic_power_wt, v, set); break;
+    case 18: access_field(ip->leakage_power_wt, v, set); break;
+    case 19: access_field(ip->cycle_time_wt, v, set); break;
+    case 20: access_field(ip->area_wt, v, set); break;
+    case 21: access_field(ip->ed, v, set); break;
+    case 22: access_field(ip->delay_dev, v, set); break;
+    case 23: access_field(ip->dynamic_power_dev, v, set); break;
+    case 24: access_field(ip->leakage_power_dev, v, set); break;
+    case 25: access_field(ip->cycle_time_dev, v, set); break;
+    case 26: access_field(ip->area_dev, v, set); break;
+    case 27: access_field(cl.access_time, 1e-9, v, set); break;
+    case 28: access_field(cl.cycle_time, 1e-9, v, set); break;
+    case 29: access_field(cl.area, 1e6, v, set); break;
+    case 30: access_field(cl.read_energy, 1e-9, v, set); break;
+    case 31: access_field(cl.leakage, 1e-3, v, set); break;
+  }
+}
+
+
+
+// Fingerprint of the inputs that feed any of the given layers.
+static uint64_t whatif_key(uint32_t layers)
+{
+  uint64_t h = fnv1a64(&layers, sizeof(layers));
+  for (uint32_t k = 0; k < whatif_n_inputs; k++)
+  {
+    if (whatif_inputs[k].layers & layers)
+    {
+      double v;
+      whatif_field(k, v, false);
+      h = fnv1a64(&v, sizeof(v), h);
+    }
+  }
+  return h;
+}
+
+
+
+// The candidates of the tag or data pass for key, swept under the current
+// g_ip unless kept from an earlier edit.
+static const array_candidates & kept_pass(list<whatif_pass> & kept, bool is_tag,
+                                          uint64_t key, string & layers)
+{
+  for (list<whatif_pass>::iterator it = kept.begin(); it != kept.end(); ++it)
+  {
+    if (it->key == key)
+    {
+      kept.splice(kept.begin(), kept, it);
+      return *kept.front().c;
+    }
+  }
+
+  whatif_pass p;
+  p.key = key;
+  p.c   = new array_candidates();
+  try
+  {
+    sweep_arrays(is_tag, !is_tag, *p.c);
+  }
+  catch (const cacti_error &)
+  {
+    delete p.c;
+    throw;
+  }
+  kept.push_front(p);
+  if (kept.size() > WHATIF_KEPT_PASSES)
+  {
+    delete kept.back().c;
+    kept.pop_back();
+  }
+  layers += is_tag ? " tag" : " data";
+  return *kept.front().c;
+}
+
+
+
+static void free_result(whatif_session & s)
+{
+  if (s.have_res)
+  {
+    delete s.res.data_array2;
+    delete s.res.tag_array2;
+    s.have_res = false;
+  }
+}
+
+
+
+// Brings s.res up to date with g_ip, recomputing the stale layers only.
+static void whatif_evaluate(whatif_session & s)
+{
+  int      pure_ram = (!g_ip->is_cache || g_ip->is_main_mem);
+  uint32_t cost     = (g_ip->search_engine != Search_exhaustive) ? Wi_search_cost : 0;
+  string   layers;
+  double   t0 = wall_time();
+
+  uint64_t tech_key = whatif_key(Wi_tech);
+  if (tech_key != s.tech_key)
+  {
+    init_tech_params(g_ip->F_sz_um, false);
+    Wire winit;
+    s.tech_key = tech_key;
+    layers += " tech";
+  }
+
+  // a fully-associative tag pass also builds the data arrays
+  array_candidates c;
+  if (!pure_ram)
+  {
+    uint32_t tag_layers = Wi_tech | Wi_tag | cost | (g_ip->fully_assoc ? Wi_data : 0);
+    c.copy_from(kept_pass(s.tag_passes, true, whatif_key(tag_layers), layers),
+                true, g_ip->fully_assoc);
+  }
+  if (!g_ip->fully_assoc)
+  {
+    c.copy_from(kept_pass(s.data_passes, false, whatif_key(Wi_tech | Wi_data | cost), layers),
+                false, true);
+  }
+
+  free_result(s);
+  init_tech_params(g_ip->F_sz_um, false);
+  select_org(&s.res, c);
+  s.have_res = true;
+  layers += " select";
+
+  const uca_org_t & r = s.res;
+  cout << fixed << setprecision(4)
+       << "access " << r.access_time*1e9 << " ns  cycle " << r.cycle_time*1e9
+       << " ns  read " << r.power.readOp.dynamic*1e9 << " nJ  write " << r.power.writeOp.dynamic*1e9
+       << " nJ  leakage " << r.power.readOp.leakage*1e3 << " mW  area " << r.area*1e-6 << " mm2  data ";
+  print_org(cout, *r.data_array2, ":");
+  if (r.tag_array2 != NULL)
+  {
+    cout << "  tag ";
+    print_org(cout, *r.tag_array2, ":");
+  }
+  cout << "  [" << layers.substr(1) << "] " << setprecision(1) << (wall_time() - t0) * 1e3 << " ms" << endl;
+  cout.unsetf(ios::floatfield);
+  cout << setprecision(6);
+}
+
+
+
+static void print_inputs()
+{
+  static const char * const layer_names[] = { "tech", "tag", "data", "select", "search" };
+  for (uint32_t k = 0; k < whatif_n_inputs; k++)
+  {
+    double v;
+    whatif_field(k, v, false);
+    cout << "  " << setw(16) << left << whatif_inputs[k].name << right << setw(12) << setprecision(10) << v << "  ";
+    for (uint32_t l = 0; l < 5; l++)
+    {
+      if (whatif_inputs[k].layers & (1u << l)) cout << " " << layer_names[l];
+    }
+    cout << endl;
+  }
+  cout << setprecision(6);
+}
+
+
+
+// Applies the key=value tokens of one edit; false (with g_ip unchanged)
+// when any of them is not valid.
+static bool apply_edit(istream & tokens)
+{
+  InputParameter saved = *g_ip;
+  string tok;
+
+  while (tokens >> tok)
+  {
+    string::size_type eq = tok.find('=');
+    uint32_t k = 0;
+    while (k < whatif_n_inputs && (eq == string::npos || tok.substr(0, eq) != whatif_inputs[k].name)) k++;
+
+    char * end = NULL;
+    double v = (k < whatif_n_inputs) ? strtod(tok.c_str() + eq + 1, &end) : 0;
+    if (k == whatif_n_inputs || end == tok.c_str() + eq + 1 || *end != '\0' ||
+        v < 0 || (whatif_inputs[k].max > 0 && v > whatif_inputs[k].max))
+    {
+      cout << "ERROR: invalid edit " << tok << " (see 'inputs')" << endl;
+      *g_ip = saved;
+      return false;
+    }
+    whatif_field(k, v, true);
+  }
+
+  if (g_ip->error_checking() == false)
+  {
+    cout << "ERROR: invalid input parameters, edit ignored" << endl;
+    *g_ip = saved;
+    return false;
+  }
+  if (g_ip->temp != saved.temp)
+  {
+    g_ip->parse_sram_cell(g_ip->sram_cell_conf_file);
+  }
+  return true;
+}
+
+
+
+void run_whatif(const string & cfg_file)
+{
+  g_ip = new InputParameter();
+  g_ip->parse_cfg(cfg_file);
+  g_ip->print_input_args = false;
+  g_ip->pareto_frontier  = false;
+  if (g_ip->error_checking() == false)
+  {
+    cout << "ERROR: invalid input parameters in " << cfg_file << endl;
+    exit(1);
+  }
+  if (g_ip->nuca == 1)
+  {
+    cout << "ERROR: the what-if session only supports UCA organizations" << endl;
+    exit(1);
+  }
+
+  whatif_session s;
+  s.tech_key = 0;
+  s.have_res = false;
+  whatif_evaluate(s);
+
+  string line;
+  while (getline(cin, line))
+  {
+    istringstream tokens(line);
+    string cmd;
+    if (!(tokens >> cmd) || cmd[0] == '#')
+    {
+      continue;
+    }
+    if (cmd == "quit")
+    {
+      break;
+    }
+    else if (cmd == "show")
+    {
+      output_UCA(&s.res);
+    }
+    else if (cmd == "inputs")
+    {
+      print_inputs();
+    }
+    else
+    {
+      // an edit the model fails on is undone; the inputs before it are
+      // still cached, so only the selection is redone
+      InputParameter saved = *g_ip;
+      istringstream edit(line);
+      try
+      {
+        if (apply_edit(edit)) whatif_evaluate(s);
+      }
+      catch (const cacti_error & e)
+      {
+        cout << "ERROR: " << e.msg << ", edit undone" << endl;
+        *g_ip = saved;
+        whatif_evaluate(s);
+      }
+    }
+  }
+
+  free_result(s);
+  for (int p = 0; p < 2; p++)
+  {
+    list<whatif_pass> & kept = p ? s.data_passes : s.tag_passes;
+    for (list<whatif_pass>::iterator it = kept.begin(); it != kept.end(); ++it)
+    {
+      delete it->c;
+    }
+  }
+  delete g_ip;
+}